@@ -11,6 +11,7 @@
 option(SERVERS          "Build worldserver and authserver"                            1)
 option(SCRIPTS          "Build core with scripts included"                            1)
 option(TOOLS            "Build map/vmap extraction/assembler tools"                   0)
+option(BENCHMARKS       "Build the benchmarks tool (needs SERVERS)"                    0)
 option(USE_SCRIPTPCH    "Use precompiled headers when compiling scripts"              1)
 option(USE_COREPCH      "Use precompiled headers when compiling servers"              1)
 option(USE_SFMT         "Use SFMT as random numbergenerator"                          0)
@@ -38,6 +38,12 @@ else()
   message("* Build map/vmap tools   : No  (default)")
 endif()
 
+if( BENCHMARKS )
+  message("* Build benchmarks tool  : Yes")
+else()
+  message("* Build benchmarks tool  : No  (default)")
+endif()
+
 if( USE_COREPCH )
   message("* Build core w/PCH       : Yes (default)")
 else()
@@ -0,0 +1,2 @@
+DELETE FROM `command` WHERE `name` = 'server maps';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES ('server maps',3,'Syntax: .server maps [#count]\r\n\r\nShow the #count (default 10) maps with the longest last update, with their player count and last and max update time as measured by the map updater.');
@@ -0,0 +1,4 @@
+DELETE FROM `command` WHERE `name` IN ('server database', 'server set synchconnections');
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('server database',3,'Syntax: .server database\r\n\r\nShow, for the world, character and login databases, the active, idle and awaited synchronous connections, how long synchronous operations waited for a connection and the prepared statements run the most on them, then how many asynchronous writes were sent together.'),
+('server set synchconnections',4,'Syntax: .server set synchconnections world|character|login #count\r\n\r\nOpen or close synchronous connections of the given database until it has #count of them. Connections in use are closed as soon as they are released.');
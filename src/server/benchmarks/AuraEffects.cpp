@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+#include "Timer.h"
+#include "AuraEffectArray.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+
+/*
+ * A raid with its buffs, procs and debuffs coming and going, through
+ * Unit::m_modAuras. Every effect applied or removed is followed by the
+ * stat recalculation of its aura type (GetTotalAuraModifier and
+ * GetTotalAuraMultiplier), and every unit recalculates all of its types
+ * once per update. The std::list the aura effect lists used to be against
+ * AuraEffectArray, compacted after each update like _DeleteRemovedAuras
+ * does.
+ */
+namespace
+{
+    // stands in for AuraEffect, the lists only hold the pointers
+    struct Effect
+    {
+        int32 amount;
+        uint32 type;
+    };
+
+    inline AuraEffect* ToAuraEffect(Effect* effect) { return reinterpret_cast<AuraEffect*>(effect); }
+    inline Effect const* ToEffect(AuraEffect* aurEff) { return reinterpret_cast<Effect const*>(aurEff); }
+
+    // stat, resistance, attack power, damage done and the like
+    uint32 const STAT_AURA_TYPES = 12;
+
+    template <class List>
+    struct RaidUnit
+    {
+        List modAuras[STAT_AURA_TYPES];
+        std::vector<uint32> modAurasToCompact;
+    };
+
+    template <class List>
+    int64 RecalcStat(List const& auras)
+    {
+        int32 modifier = 0;
+        float multiplier = 1.0f;
+        for (typename List::const_iterator itr = auras.begin(); itr != auras.end(); ++itr)
+        {
+            modifier += ToEffect(*itr)->amount;
+            multiplier *= (100.0f + ToEffect(*itr)->amount) / 100.0f;
+        }
+        return modifier + int64(multiplier * 1000.0f);
+    }
+
+    void Remove(RaidUnit<std::list<AuraEffect*> >& unit, uint32 type, AuraEffect* aurEff)
+    {
+        unit.modAuras[type].remove(aurEff);
+    }
+
+    void Remove(RaidUnit<AuraEffectArray>& unit, uint32 type, AuraEffect* aurEff)
+    {
+        if (unit.modAuras[type].remove(aurEff))
+            unit.modAurasToCompact.push_back(type);
+    }
+
+    void Compact(RaidUnit<std::list<AuraEffect*> >& /*unit*/) { }
+
+    void Compact(RaidUnit<AuraEffectArray>& unit)
+    {
+        for (std::vector<uint32>::const_iterator itr = unit.modAurasToCompact.begin(); itr != unit.modAurasToCompact.end(); ++itr)
+            unit.modAuras[*itr].Compact();
+        unit.modAurasToCompact.clear();
+    }
+}
+
+class AuraEffectsBenchmark : public Benchmark
+{
+    public:
+        AuraEffectsBenchmark() : Benchmark("aura_effects", "[units] [effects per unit] [changes per update] [updates]",
+            "raid aura apply, remove and stat recalculation, std::list against AuraEffectArray") { }
+
+        bool Run(Arguments const& args)
+        {
+            uint32 units = args.size() > 0 ? atoi(args[0].c_str()) : 25;
+            uint32 effects = args.size() > 1 ? atoi(args[1].c_str()) : 60;
+            uint32 changes = args.size() > 2 ? atoi(args[2].c_str()) : 4;
+            uint32 updates = args.size() > 3 ? atoi(args[3].c_str()) : 20000;
+            if (!units || !effects || !changes || changes > effects || !updates)
+                return Usage();
+
+            std::vector<Effect> raidEffects(units * effects);
+            for (uint32 i = 0; i < raidEffects.size(); ++i)
+            {
+                raidEffects[i].amount = int32(i % 13) - 3;
+                raidEffects[i].type = (i * 7) % STAT_AURA_TYPES;
+            }
+
+            printf("  %u units, %u effects each, %u removed and applied again per update, %u updates\n", units, effects, changes, updates);
+
+            uint32 msTime = getMSTime();
+            int64 listStats = Replay<std::list<AuraEffect*> >(raidEffects, units, effects, changes, updates);
+            Report("std::list", GetMSTimeDiffToNow(msTime), units * updates);
+
+            msTime = getMSTime();
+            int64 arrayStats = Replay<AuraEffectArray>(raidEffects, units, effects, changes, updates);
+            Report("AuraEffectArray", GetMSTimeDiffToNow(msTime), units * updates);
+
+            printf("  stat checksum " SI64FMTD " with std::list, " SI64FMTD " with AuraEffectArray\n", listStats, arrayStats);
+            return listStats == arrayStats;
+        }
+
+    private:
+        template <class List>
+        static int64 Replay(std::vector<Effect>& raidEffects, uint32 units, uint32 effects, uint32 changes, uint32 updates)
+        {
+            // raid buffs go out to every unit in turn
+            std::vector<RaidUnit<List> > raid(units);
+            for (uint32 e = 0; e < effects; ++e)
+            {
+                for (uint32 u = 0; u < units; ++u)
+                {
+                    Effect& effect = raidEffects[u * effects + e];
+                    raid[u].modAuras[effect.type].push_back(ToAuraEffect(&effect));
+                }
+            }
+
+            int64 stats = 0;
+            uint32 seed = 7;
+            for (uint32 update = 0; update < updates; ++update)
+            {
+                for (uint32 u = 0; u < units; ++u)
+                {
+                    RaidUnit<List>& unit = raid[u];
+
+                    // buffs refreshed and procs fading and coming back
+                    for (uint32 c = 0; c < changes; ++c)
+                    {
+                        seed = seed * 1103515245 + 12345;
+                        Effect& effect = raidEffects[u * effects + (seed >> 8) % effects];
+
+                        Remove(unit, effect.type, ToAuraEffect(&effect));
+                        stats += RecalcStat(unit.modAuras[effect.type]);
+
+                        unit.modAuras[effect.type].push_back(ToAuraEffect(&effect));
+                        stats += RecalcStat(unit.modAuras[effect.type]);
+                    }
+
+                    Compact(unit);
+
+                    for (uint32 type = 0; type < STAT_AURA_TYPES; ++type)
+                        stats += RecalcStat(unit.modAuras[type]);
+                }
+            }
+            return stats;
+        }
+};
+
+static AuraEffectsBenchmark auraEffectsBenchmark;
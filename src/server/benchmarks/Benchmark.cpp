@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+
+#include <cstdio>
+
+Benchmark::Benchmark(char const* name, char const* arguments, char const* description) :
+    m_name(name), m_arguments(arguments), m_description(description)
+{
+    GetRegistry().push_back(this);
+}
+
+std::vector<Benchmark*>& Benchmark::GetRegistry()
+{
+    // not a static member, the benchmarks register during static initialization
+    static std::vector<Benchmark*> benchmarks;
+    return benchmarks;
+}
+
+Benchmark* Benchmark::Find(std::string const& name)
+{
+    std::vector<Benchmark*> const& benchmarks = GetRegistry();
+    for (std::vector<Benchmark*>::const_iterator itr = benchmarks.begin(); itr != benchmarks.end(); ++itr)
+        if (name == (*itr)->GetName())
+            return *itr;
+
+    return NULL;
+}
+
+void Benchmark::Report(char const* what, uint32 msTime, uint32 count)
+{
+    printf("  %-40s %6u ms", what, msTime);
+    if (count)
+        printf(" %10.3f us each", msTime * 1000.0 / count);
+    printf("\n");
+}
+
+bool Benchmark::Usage() const
+{
+    printf("Usage: %s %s\n", m_name, m_arguments);
+    return false;
+}
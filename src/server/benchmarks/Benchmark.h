@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_BENCHMARK_H
+#define TRINITY_BENCHMARK_H
+
+#include "Define.h"
+
+#include <string>
+#include <vector>
+
+/*
+ * One named benchmark of the benchmarks tool. A benchmark registers itself
+ * by defining a static instance of its class, and is run by name:
+ *
+ *   benchmarks [-c config_file] <name> [arguments]
+ *
+ * The configuration file is only needed by benchmarks using the databases.
+ */
+class Benchmark
+{
+    public:
+        typedef std::vector<std::string> Arguments;
+
+        Benchmark(char const* name, char const* arguments, char const* description);
+        virtual ~Benchmark() { }
+
+        char const* GetName() const { return m_name; }
+        char const* GetArguments() const { return m_arguments; }
+        char const* GetDescription() const { return m_description; }
+
+        // returns false if the arguments were wrong or the results of the compared code paths differ
+        virtual bool Run(Arguments const& args) = 0;
+
+        static Benchmark* Find(std::string const& name);
+        static std::vector<Benchmark*> const& GetBenchmarks() { return GetRegistry(); }
+
+    protected:
+        // prints the time taken by count repetitions of what
+        static void Report(char const* what, uint32 msTime, uint32 count);
+        // prints the arguments of the benchmark, for Run() to return
+        bool Usage() const;
+
+    private:
+        static std::vector<Benchmark*>& GetRegistry();
+
+        char const* m_name;
+        char const* m_arguments;
+        char const* m_description;
+};
+
+#endif
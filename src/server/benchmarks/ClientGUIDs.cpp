@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+#include "Timer.h"
+#include "ClientGUIDSet.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+
+/*
+ * Visibility updates of the players in a crowded cell: every pass each
+ * player reaches the objects in range, part of which moved in since the
+ * last pass, and drops the ones out of range. Player::ClientGUIDs as a
+ * std::set, copied and erased from like the visibility update used to do,
+ * against the ClientGUIDSet marking pass.
+ */
+class ClientGUIDsBenchmark : public Benchmark
+{
+    public:
+        ClientGUIDsBenchmark() : Benchmark("client_guids", "[objects in range] [players] [passes]",
+            "visibility update of the players in a crowded cell, std::set against ClientGUIDSet") { }
+
+        bool Run(Arguments const& args)
+        {
+            uint32 objects = args.size() > 0 ? atoi(args[0].c_str()) : 1000;
+            uint32 players = args.size() > 1 ? atoi(args[1].c_str()) : 200;
+            uint32 passes = args.size() > 2 ? atoi(args[2].c_str()) : 50;
+            if (!objects || !players || !passes)
+                return Usage();
+
+            // a twentieth of the objects in range changes every pass
+            std::vector<uint64> guids(objects * 2);
+            for (uint32 i = 0; i < guids.size(); ++i)
+                guids[i] = (i % 3 ? UI64LIT(0) : UI64LIT(0xF130000000000000)) | (i * 7 + 1);
+
+            printf("  %u objects in range, %u players, %u passes\n", objects, players, passes);
+
+            uint64 setDropped = 0;
+            uint32 msTime = getMSTime();
+            {
+                std::vector<std::set<uint64> > clientGUIDs(players);
+                for (uint32 p = 0; p < players; ++p)
+                    clientGUIDs[p].insert(guids.begin(), guids.begin() + objects);
+
+                for (uint32 pass = 0; pass < passes; ++pass)
+                {
+                    uint32 first = pass * objects / 20;
+                    for (uint32 p = 0; p < players; ++p)
+                    {
+                        std::set<uint64> vis_guids(clientGUIDs[p]);
+                        for (uint32 i = 0; i < objects; ++i)
+                        {
+                            uint64 guid = guids[(first + i) % guids.size()];
+                            vis_guids.erase(guid);
+                            clientGUIDs[p].insert(guid);
+                        }
+
+                        for (std::set<uint64>::const_iterator itr = vis_guids.begin(); itr != vis_guids.end(); ++itr)
+                            clientGUIDs[p].erase(*itr);
+                        setDropped += vis_guids.size();
+                    }
+                }
+            }
+            Report("std::set, copied and erased from", GetMSTimeDiffToNow(msTime), players * passes);
+
+            uint64 markedDropped = 0;
+            msTime = getMSTime();
+            {
+                ClientGUIDSet* clientGUIDs = new ClientGUIDSet[players];
+                for (uint32 p = 0; p < players; ++p)
+                    for (uint32 i = 0; i < objects; ++i)
+                        clientGUIDs[p].insert(guids[i]);
+
+                std::vector<uint64> outOfRange;
+                for (uint32 pass = 0; pass < passes; ++pass)
+                {
+                    uint32 first = pass * objects / 20;
+                    for (uint32 p = 0; p < players; ++p)
+                    {
+                        clientGUIDs[p].BeginPass();
+                        for (uint32 i = 0; i < objects; ++i)
+                        {
+                            uint64 guid = guids[(first + i) % guids.size()];
+                            if (!clientGUIDs[p].Mark(guid))
+                                clientGUIDs[p].insert(guid);
+                        }
+
+                        outOfRange.clear();
+                        clientGUIDs[p].TakeUnmarked(outOfRange);
+                        markedDropped += outOfRange.size();
+                    }
+                }
+
+                delete[] clientGUIDs;
+            }
+            Report("ClientGUIDSet, marking pass", GetMSTimeDiffToNow(msTime), players * passes);
+
+            printf("  " UI64FMTD " and " UI64FMTD " objects dropped out of range\n", setDropped, markedDropped);
+            return setDropped == markedDropped;
+        }
+};
+
+static ClientGUIDsBenchmark clientGUIDsBenchmark;
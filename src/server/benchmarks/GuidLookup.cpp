@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+#include "Timer.h"
+#include "Threading.h"
+#include "UnorderedMap.h"
+#include "GuidLookupTable.h"
+
+#include <ace/Guard_T.h>
+#include <ace/Thread_Mutex.h>
+#include <cstdio>
+#include <cstdlib>
+
+/*
+ * Map threads finding objects by guid while the world thread adds and
+ * removes them, like HashMapHolder<T>::Find against Insert/Remove. The
+ * object map read under the holder lock, as Find used to do, against the
+ * GuidLookupTable read without any lock. Every object found is checked to
+ * be the one of the guid, and the table is compared with the objects added
+ * once the run is over.
+ */
+namespace
+{
+    struct Object
+    {
+        uint64 guid;
+        bool added;
+    };
+
+    typedef UNORDERED_MAP<uint64, Object*> ObjectMap;
+
+    struct Shared
+    {
+        Shared(bool locked_, std::vector<Object>& objects_, uint32 lookups_)
+            : locked(locked_), objects(objects_), lookups(lookups_), found(0), wrong(0) { }
+
+        bool locked;
+        std::vector<Object>& objects;
+        uint32 lookups;                                 // per reader
+
+        ACE_Thread_Mutex lock;                          // the holder lock
+        ObjectMap objectMap;
+        GuidLookupTable<Object> lookupTable;
+
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> running;
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> found;
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> wrong;
+    };
+
+    class ReaderRunnable : public ACE_Based::Runnable
+    {
+        public:
+            ReaderRunnable(Shared& shared, uint32 seed) : m_shared(shared), m_seed(seed) { }
+
+            void run()
+            {
+                long found = 0;
+                long wrong = 0;
+                uint32 count = m_shared.objects.size();
+                for (uint32 i = 0; i < m_shared.lookups; ++i)
+                {
+                    m_seed = m_seed * 1103515245 + 12345;
+                    Object const& object = m_shared.objects[(m_seed >> 8) % count];
+
+                    Object* result = NULL;
+                    if (m_shared.locked)
+                    {
+                        ACE_GUARD(ACE_Thread_Mutex, guard, m_shared.lock);
+                        ObjectMap::const_iterator itr = m_shared.objectMap.find(object.guid);
+                        result = itr != m_shared.objectMap.end() ? itr->second : NULL;
+                    }
+                    else
+                        result = m_shared.lookupTable.Find(object.guid);
+
+                    if (!result)
+                        continue;
+
+                    ++found;
+                    if (result != &object)
+                        ++wrong;
+                }
+
+                m_shared.found += found;
+                m_shared.wrong += wrong;
+                --m_shared.running;
+            }
+
+        private:
+            Shared& m_shared;
+            uint32 m_seed;
+    };
+}
+
+class GuidLookupBenchmark : public Benchmark
+{
+    public:
+        GuidLookupBenchmark() : Benchmark("guid_lookup", "[reader threads] [objects] [lookups per reader]",
+            "guid lookups of the map threads against object adds and removes, holder lock against GuidLookupTable") { }
+
+        bool Run(Arguments const& args)
+        {
+            uint32 readers = args.size() > 0 ? atoi(args[0].c_str()) : 4;
+            uint32 objects = args.size() > 1 ? atoi(args[1].c_str()) : 20000;
+            uint32 lookups = args.size() > 2 ? atoi(args[2].c_str()) : 2000000;
+            if (!readers || !objects || !lookups)
+                return Usage();
+
+            printf("  %u reader threads, %u objects, %u lookups each\n", readers, objects, lookups);
+
+            return RunPass(false, readers, objects, lookups) && RunPass(true, readers, objects, lookups);
+        }
+
+    private:
+        bool RunPass(bool locked, uint32 readers, uint32 count, uint32 lookups)
+        {
+            // players and creatures, half of them in the world at any time
+            std::vector<Object> objects(count);
+            for (uint32 i = 0; i < count; ++i)
+            {
+                objects[i].guid = (i % 2 ? UI64LIT(0xF130000000000000) : UI64LIT(0)) | (uint64(i % 7) << 24) | (i + 1);
+                objects[i].added = false;
+            }
+
+            Shared shared(locked, objects, lookups);
+            for (uint32 i = 0; i < count; i += 2)
+                Change(shared, objects[i]);
+
+            shared.running = readers;
+            std::vector<ACE_Based::Thread*> threads;
+            uint32 msTime = getMSTime();
+            for (uint32 i = 0; i < readers; ++i)
+                threads.push_back(new ACE_Based::Thread(new ReaderRunnable(shared, i * 7919 + 1)));
+
+            // the world thread keeps adding and removing objects until the readers are done
+            uint32 changes = 0;
+            uint32 seed = 7;
+            while (shared.running.value())
+            {
+                seed = seed * 1103515245 + 12345;
+                Change(shared, objects[(seed >> 8) % count]);
+                ++changes;
+            }
+            uint32 diff = GetMSTimeDiffToNow(msTime);
+
+            for (uint32 i = 0; i < threads.size(); ++i)
+            {
+                threads[i]->wait();
+                delete threads[i];
+            }
+
+            Report(locked ? "object map under the holder lock" : "GuidLookupTable, no lock", diff, readers * lookups);
+            printf("    %u objects added or removed meanwhile, %ld found, %ld wrong\n", changes, shared.found.value(), shared.wrong.value());
+
+            if (locked)
+                return !shared.wrong.value();
+
+            shared.lookupTable.ReleaseRetired();
+            for (uint32 i = 0; i < count; ++i)
+            {
+                Object* result = shared.lookupTable.Find(objects[i].guid);
+                if (result != (objects[i].added ? &objects[i] : NULL))
+                {
+                    printf("  guid " UI64FMTD " does not match the objects added\n", objects[i].guid);
+                    return false;
+                }
+            }
+            return !shared.wrong.value();
+        }
+
+        static void Change(Shared& shared, Object& object)
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, shared.lock);
+            if (object.added)
+            {
+                shared.objectMap.erase(object.guid);
+                shared.lookupTable.Remove(object.guid);
+            }
+            else
+            {
+                shared.objectMap[object.guid] = &object;
+                shared.lookupTable.Insert(object.guid, &object);
+            }
+            object.added = !object.added;
+        }
+};
+
+static GuidLookupBenchmark guidLookupBenchmark;
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Common.h"
+#include "Database/DatabaseEnv.h"
+#include "Configuration/Config.h"
+#include "Benchmark.h"
+
+WorldDatabaseWorkerPool WorldDatabase;                      ///< Accessor to the world database
+CharacterDatabaseWorkerPool CharacterDatabase;              ///< Accessor to the character database
+LoginDatabaseWorkerPool LoginDatabase;                      ///< Accessor to the realm/login database
+
+uint32 realmID;                                             ///< Id of the realm
+
+/// Print out the usage string and the known benchmarks.
+void usage(const char *prog)
+{
+    printf("Usage: \n %s [-c config_file] <benchmark> [arguments]\n\n", prog);
+
+    std::vector<Benchmark*> const& benchmarks = Benchmark::GetBenchmarks();
+    for (std::vector<Benchmark*>::const_iterator itr = benchmarks.begin(); itr != benchmarks.end(); ++itr)
+        printf("    %s %s\n        %s\n", (*itr)->GetName(), (*itr)->GetArguments(), (*itr)->GetDescription());
+}
+
+/// Run one benchmark
+extern int main(int argc, char **argv)
+{
+    int c = 1;
+    if (c + 1 < argc && strcmp(argv[c], "-c") == 0)
+    {
+        if (!sConfig->SetSource(argv[c + 1]))
+        {
+            printf("Invalid or missing configuration file : %s\n", argv[c + 1]);
+            return 1;
+        }
+        c += 2;
+    }
+
+    if (c >= argc)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    Benchmark* benchmark = Benchmark::Find(argv[c]);
+    if (!benchmark)
+    {
+        printf("Unknown benchmark %s\n\n", argv[c]);
+        usage(argv[0]);
+        return 1;
+    }
+
+    Benchmark::Arguments args(argv + c + 1, argv + argc);
+
+    printf("%s:\n", benchmark->GetName());
+    return benchmark->Run(args) ? 0 : 1;
+}
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+#include "Timer.h"
+#include "SmartScriptMgr.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <list>
+
+/*
+ * A trash pack fighting a party, replayed through the hooks SmartAI calls
+ * on the scripts of the pack. Each hook used to walk the whole event list
+ * of the script and allocate a std::list for the targets of every event
+ * it ran. Now it walks only its own events through an index built like
+ * SmartScript::BuildEventTypeIndex, and takes the target list from a pool
+ * like SmartScript::AllocTargetList. The events run do nothing but collect
+ * their targets, so what is left is the dispatch and target list cost.
+ */
+namespace
+{
+    // the events of a usual trash script, repeated to the requested length
+    SMART_EVENT const ScriptEvents[] =
+    {
+        SMART_EVENT_UPDATE_IC, SMART_EVENT_UPDATE_IC, SMART_EVENT_AGGRO, SMART_EVENT_LINK,
+        SMART_EVENT_HEALT_PCT, SMART_EVENT_SPELLHIT, SMART_EVENT_DEATH, SMART_EVENT_LINK,
+        SMART_EVENT_RESET, SMART_EVENT_EVADE, SMART_EVENT_UPDATE_OOC, SMART_EVENT_UPDATE_IC,
+    };
+
+    // what a creature of the pack gets from SmartAI in one update of the fight
+    struct Hook
+    {
+        SMART_EVENT type;
+        uint32 perPlayer;                               // calls per party member
+        uint32 calls;                                   // calls on top of those
+    };
+
+    Hook const FightHooks[] =
+    {
+        { SMART_EVENT_DAMAGED,        1, 0 },
+        { SMART_EVENT_IC_LOS,         1, 0 },
+        { SMART_EVENT_DAMAGED_TARGET, 0, 1 },
+        { SMART_EVENT_SPELLHIT,       1, 0 },
+        { SMART_EVENT_RECEIVE_HEAL,   0, 1 },
+    };
+
+    typedef std::list<WorldObject*> OldObjectList;
+
+    struct Script
+    {
+        SmartAIEventList events;
+        uint16 eventTypeOffsets[SMART_EVENT_END + 1];
+        std::vector<uint16> eventsByType;
+        std::vector<ObjectList*> freeTargetLists;
+
+        void BuildEventTypeIndex()
+        {
+            uint16 count[SMART_EVENT_END];
+            memset(count, 0, sizeof(count));
+            for (SmartAIEventList::const_iterator i = events.begin(); i != events.end(); ++i)
+                ++count[i->GetEventType()];
+
+            eventTypeOffsets[0] = 0;
+            for (uint32 type = 0; type < SMART_EVENT_END; ++type)
+                eventTypeOffsets[type + 1] = eventTypeOffsets[type] + count[type];
+
+            eventsByType.resize(eventTypeOffsets[SMART_EVENT_END]);
+            memcpy(count, eventTypeOffsets, sizeof(count));
+            for (uint16 i = 0; i < events.size(); ++i)
+                eventsByType[count[events[i].GetEventType()]++] = i;
+        }
+
+        ObjectList* AllocTargetList()
+        {
+            if (freeTargetLists.empty())
+                return new ObjectList();
+
+            ObjectList* targets = freeTargetLists.back();
+            freeTargetLists.pop_back();
+            targets->clear();
+            return targets;
+        }
+
+        void FreeTargetList(ObjectList* targets)
+        {
+            freeTargetLists.push_back(targets);
+        }
+    };
+}
+
+class SmartScriptEventsBenchmark : public Benchmark
+{
+    public:
+        SmartScriptEventsBenchmark() : Benchmark("smart_scripts", "[creatures] [events per script] [party size] [updates]",
+            "trash pack fight replayed through SmartScript hooks, event list walk and new std::list against type index and target list pool") { }
+
+        bool Run(Arguments const& args)
+        {
+            uint32 creatures = args.size() > 0 ? atoi(args[0].c_str()) : 5;
+            uint32 eventCount = args.size() > 1 ? atoi(args[1].c_str()) : 12;
+            uint32 partySize = args.size() > 2 ? atoi(args[2].c_str()) : 5;
+            uint32 updates = args.size() > 3 ? atoi(args[3].c_str()) : 200000;
+            if (!creatures || !eventCount || !partySize || !updates)
+                return Usage();
+
+            std::vector<Script> scripts(creatures);
+            for (uint32 c = 0; c < creatures; ++c)
+            {
+                for (uint32 i = 0; i < eventCount; ++i)
+                {
+                    SmartScriptHolder holder;
+                    holder.event_id = i;
+                    holder.event.type = ScriptEvents[(c + i) % (sizeof(ScriptEvents) / sizeof(ScriptEvents[0]))];
+                    // spell hit replies hit the whole party, everything else a single target
+                    holder.target.type = holder.event.type == SMART_EVENT_SPELLHIT ? SMART_TARGET_THREAT_LIST : SMART_TARGET_VICTIM;
+                    scripts[c].events.push_back(holder);
+                }
+                scripts[c].BuildEventTypeIndex();
+            }
+
+            std::vector<WorldObject*> party(partySize, static_cast<WorldObject*>(NULL));
+
+            printf("  %u creatures, %u events per script, party of %u, %u updates\n", creatures, eventCount, partySize, updates);
+
+            uint64 walkTargets = 0;
+            uint32 hookCalls = 0;
+            uint32 msTime = getMSTime();
+            for (uint32 update = 0; update < updates; ++update)
+            {
+                for (uint32 c = 0; c < creatures; ++c)
+                {
+                    for (uint32 h = 0; h < sizeof(FightHooks) / sizeof(FightHooks[0]); ++h)
+                    {
+                        uint32 calls = FightHooks[h].perPlayer * partySize + FightHooks[h].calls;
+                        for (uint32 call = 0; call < calls; ++call)
+                        {
+                            for (SmartAIEventList::const_iterator i = scripts[c].events.begin(); i != scripts[c].events.end(); ++i)
+                            {
+                                if (i->GetEventType() == SMART_EVENT_LINK)
+                                    continue;
+
+                                if (i->GetEventType() != uint32(FightHooks[h].type))
+                                    continue;
+
+                                OldObjectList* targets = new OldObjectList();
+                                GetTargets(*i, party, *targets);
+                                walkTargets += targets->size();
+                                delete targets;
+                            }
+                            ++hookCalls;
+                        }
+                    }
+                }
+            }
+            Report("event list walk, new std::list", GetMSTimeDiffToNow(msTime), hookCalls);
+
+            uint64 indexTargets = 0;
+            msTime = getMSTime();
+            for (uint32 update = 0; update < updates; ++update)
+            {
+                for (uint32 c = 0; c < creatures; ++c)
+                {
+                    Script& script = scripts[c];
+                    for (uint32 h = 0; h < sizeof(FightHooks) / sizeof(FightHooks[0]); ++h)
+                    {
+                        uint32 calls = FightHooks[h].perPlayer * partySize + FightHooks[h].calls;
+                        SMART_EVENT type = FightHooks[h].type;
+                        for (uint32 call = 0; call < calls; ++call)
+                        {
+                            for (uint16 i = script.eventTypeOffsets[type]; i < script.eventTypeOffsets[type + 1]; ++i)
+                            {
+                                ObjectList* targets = script.AllocTargetList();
+                                GetTargets(script.events[script.eventsByType[i]], party, *targets);
+                                indexTargets += targets->size();
+                                script.FreeTargetList(targets);
+                            }
+                        }
+                    }
+                }
+            }
+            Report("type index, pooled target lists", GetMSTimeDiffToNow(msTime), hookCalls);
+
+            for (uint32 c = 0; c < creatures; ++c)
+                for (std::vector<ObjectList*>::const_iterator itr = scripts[c].freeTargetLists.begin(); itr != scripts[c].freeTargetLists.end(); ++itr)
+                    delete *itr;
+
+            printf("  " UI64FMTD " targets collected by the walk, " UI64FMTD " by the index\n", walkTargets, indexTargets);
+            return walkTargets == indexTargets;
+        }
+
+    private:
+        template <class List>
+        static void GetTargets(SmartScriptHolder const& e, std::vector<WorldObject*> const& party, List& targets)
+        {
+            if (e.GetTargetType() == SMART_TARGET_THREAT_LIST)
+                targets.insert(targets.end(), party.begin(), party.end());
+            else
+                targets.push_back(party.front());
+        }
+};
+
+static SmartScriptEventsBenchmark smartScriptEventsBenchmark;
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+#include "Timer.h"
+#include "VMapManager2.h"
+#include "VMapDefinitions.h"
+#include "GridDefines.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+/*
+ * Line of sight of area spells on a real vmap tile: every target of a
+ * cast checked with its own query, the way CheckEffectTarget() does it,
+ * against all targets of the cast in one batched query, the way
+ * Spell::RemoveTargetsNotInLOS() does it. The casters stand on the
+ * models of the tile, where the check has something to trace against.
+ */
+class VMapLineOfSightBenchmark : public Benchmark
+{
+    public:
+        VMapLineOfSightBenchmark() : Benchmark("vmap_los", "<vmaps directory> <map id> <grid x> <grid y> [casts]",
+            "area spell line of sight, per target queries against one batched query per cast") { }
+
+        bool Run(Arguments const& args)
+        {
+            if (args.size() < 4)
+                return Usage();
+
+            std::string path = args[0];
+            uint32 mapId = atoi(args[1].c_str());
+            uint32 gx = atoi(args[2].c_str());
+            uint32 gy = atoi(args[3].c_str());
+            uint32 casts = args.size() > 4 ? atoi(args[4].c_str()) : 10000;
+
+            VMAP::VMapManager2 vmgr;
+            vmgr.setEnableLineOfSightCalc(true);
+            vmgr.setEnableHeightCalc(true);
+
+            std::vector<uint32> mapIds(1, mapId);
+            vmgr.initializeMaps(path.c_str(), mapIds);
+            if (vmgr.loadMap(path.c_str(), mapId, gx, gy) != VMAP::VMAP_LOAD_RESULT_OK)
+            {
+                printf("Could not load the vmap tile %u_%u of map %u from %s\n", gx, gy, mapId, path.c_str());
+                return false;
+            }
+
+            // grid gx spans these world coordinates, see Map::EnsureGridCreated()
+            float minX = (CENTER_GRID_ID - 1 - float(gx)) * SIZE_OF_GRIDS;
+            float minY = (CENTER_GRID_ID - 1 - float(gy)) * SIZE_OF_GRIDS;
+
+            // 6 coordinates per target, as Spell::RemoveTargetsNotInLOS() passes them
+            std::vector<float> coords;
+            std::vector<uint32> castTargets;
+            srand(1);
+            for (uint32 tries = 0; castTargets.size() < casts && tries < casts * 50; ++tries)
+            {
+                float cx = minX + Random() * SIZE_OF_GRIDS;
+                float cy = minY + Random() * SIZE_OF_GRIDS;
+                float cz = vmgr.getHeight(mapId, cx, cy, 2000.0f, 4000.0f);
+                if (cz <= VMAP_INVALID_HEIGHT)
+                    continue;
+
+                uint32 targets = 10 + rand() % 16;
+                for (uint32 i = 0; i < targets; ++i)
+                {
+                    float tx = cx + (Random() * 2.0f - 1.0f) * 30.0f;
+                    float ty = cy + (Random() * 2.0f - 1.0f) * 30.0f;
+                    float tz = vmgr.getHeight(mapId, tx, ty, cz + 10.0f, 40.0f);
+                    if (tz <= VMAP_INVALID_HEIGHT)
+                        tz = cz;
+
+                    coords.push_back(tx);
+                    coords.push_back(ty);
+                    coords.push_back(tz + 2.0f);
+                    coords.push_back(cx);
+                    coords.push_back(cy);
+                    coords.push_back(cz + 2.0f);
+                }
+
+                castTargets.push_back(targets);
+            }
+
+            uint32 rays = coords.size() / 6;
+            if (!rays)
+            {
+                printf("The vmap tile %u_%u of map %u has no models to stand on\n", gx, gy, mapId);
+                return false;
+            }
+
+            printf("  %u casts, %u targets\n", uint32(castTargets.size()), rays);
+
+            std::vector<char> single(rays);
+            uint32 blocked = 0;
+            uint32 msTime = getMSTime();
+            for (uint32 i = 0; i < rays; ++i)
+            {
+                float const* ray = &coords[i * 6];
+                single[i] = vmgr.isInLineOfSight(mapId, ray[0], ray[1], ray[2], ray[3], ray[4], ray[5]);
+                if (!single[i])
+                    ++blocked;
+            }
+            Report("one query per target", GetMSTimeDiffToNow(msTime), rays);
+
+            bool* batched = new bool[rays];
+            msTime = getMSTime();
+            for (uint32 i = 0, first = 0; i < castTargets.size(); first += castTargets[i++])
+                vmgr.isInLineOfSight(mapId, &coords[first * 6], castTargets[i], batched + first);
+            Report("one batched query per cast", GetMSTimeDiffToNow(msTime), rays);
+
+            uint32 mismatches = 0;
+            for (uint32 i = 0; i < rays; ++i)
+                if (bool(single[i]) != batched[i])
+                    ++mismatches;
+            delete[] batched;
+
+            printf("  %u targets out of line of sight, %u mismatches\n", blocked, mismatches);
+
+            vmgr.unloadMap(mapId, gx, gy);
+            return !mismatches;
+        }
+
+    private:
+        static float Random() { return rand() / float(RAND_MAX); }
+};
+
+static VMapLineOfSightBenchmark vmapLineOfSightBenchmark;
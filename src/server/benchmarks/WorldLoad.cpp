@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+#include "Timer.h"
+#include "Config.h"
+#include "DatabaseEnv.h"
+#include "MySQLThreading.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+/*
+ * Startup loaders of the world database: the statement of every loader
+ * converted to a prepared statement, run once as its text over the text
+ * protocol, the way the loaders used to query, and once as the prepared
+ * statement. Reads the rows the way the loaders walk them.
+ */
+class WorldLoadBenchmark : public Benchmark
+{
+    public:
+        WorldLoadBenchmark() : Benchmark("world_load", "[passes]",
+            "startup loaders of the world database, text protocol against prepared statements, needs -c with WorldDatabaseInfo") { }
+
+        bool Run(Arguments const& args)
+        {
+            uint32 passes = args.empty() ? 3 : atoi(args[0].c_str());
+            if (!passes)
+                return Usage();
+
+            std::string dbstring = sConfig->GetStringDefault("WorldDatabaseInfo", "");
+            if (dbstring.empty())
+            {
+                printf("World database not specified in configuration file\n");
+                return Usage();
+            }
+
+            MySQL::Library_Init();
+
+            MySQLConnectionInfo connInfo(dbstring);
+            LoaderConnection conn(connInfo);
+            if (!conn.Open())
+            {
+                printf("Cannot connect to world database %s\n", dbstring.c_str());
+                MySQL::Library_End();
+                return false;
+            }
+
+            uint32 textTotal = 0;
+            uint32 preparedTotal = 0;
+            for (Loader const* loader = Loaders; loader->table; ++loader)
+            {
+                uint64 rows = 0;
+                uint64 textSum = 0;
+                uint64 preparedSum = 0;
+
+                uint32 msTime = getMSTime();
+                for (uint32 i = 0; i < passes; ++i)
+                    if (ResultSet* result = conn.Query(conn.GetQueryText(loader->statement)))
+                    {
+                        rows = result->GetRowCount();
+                        while (result->NextRow())
+                            textSum += result->Fetch()[0].GetUInt32();
+                        delete result;
+                    }
+                uint32 textTime = GetMSTimeDiffToNow(msTime);
+
+                msTime = getMSTime();
+                for (uint32 i = 0; i < passes; ++i)
+                {
+                    PreparedStatement stmt(loader->statement);
+                    if (PreparedResultSet* result = conn.Query(&stmt))
+                    {
+                        if (result->GetRowCount())
+                            do
+                                preparedSum += result->Fetch()[0].GetUInt32();
+                            while (result->NextRow());
+                        delete result;
+                    }
+                }
+                uint32 preparedTime = GetMSTimeDiffToNow(msTime);
+
+                printf("  %s, " UI64FMTD " rows\n", loader->table, rows);
+                Report("text protocol", textTime, passes);
+                Report("prepared statement", preparedTime, passes);
+
+                if (textSum != preparedSum)
+                    printf("  the keys read differ\n");
+
+                textTotal += textTime;
+                preparedTotal += preparedTime;
+            }
+
+            printf("  all loaders\n");
+            Report("text protocol", textTotal, passes);
+            Report("prepared statement", preparedTotal, passes);
+
+            conn.Close();
+            MySQL::Library_End();
+            return true;
+        }
+
+    private:
+        // a synchronous world connection that gives the text of its statements
+        class LoaderConnection : public WorldDatabaseConnection
+        {
+            public:
+                LoaderConnection(MySQLConnectionInfo& connInfo) : WorldDatabaseConnection(connInfo) { }
+
+                char const* GetQueryText(uint32 index) { return m_queries[index].first; }
+        };
+
+        struct Loader
+        {
+            uint32 statement;
+            char const* table;
+        };
+
+        static Loader const Loaders[];
+};
+
+WorldLoadBenchmark::Loader const WorldLoadBenchmark::Loaders[] =
+{
+    { WORLD_LOAD_CREATURES,                    "creature"                    },
+    { WORLD_LOAD_GAMEOBJECTS,                  "gameobject"                  },
+    { WORLD_LOAD_QUEST_TEMPLATES,              "quest_template"              },
+    { WORLD_LOAD_CREATURE_TEMPLATES,           "creature_template"           },
+    { WORLD_LOAD_CREATURE_TEMPLATE_ADDONS,     "creature_template_addon"     },
+    { WORLD_LOAD_CREATURE_ADDONS,              "creature_addon"              },
+    { WORLD_LOAD_ITEM_TEMPLATES,               "item_template"               },
+    { WORLD_LOAD_GAMEOBJECT_TEMPLATES,         "gameobject_template"         },
+    { WORLD_LOAD_VENDORS,                      "npc_vendor"                  },
+    { WORLD_LOAD_CREATURE_LOOT_TEMPLATES,      "creature_loot_template"      },
+    { WORLD_LOAD_DISENCHANT_LOOT_TEMPLATES,    "disenchant_loot_template"    },
+    { WORLD_LOAD_FISHING_LOOT_TEMPLATES,       "fishing_loot_template"       },
+    { WORLD_LOAD_GAMEOBJECT_LOOT_TEMPLATES,    "gameobject_loot_template"    },
+    { WORLD_LOAD_ITEM_LOOT_TEMPLATES,          "item_loot_template"          },
+    { WORLD_LOAD_MAIL_LOOT_TEMPLATES,          "mail_loot_template"          },
+    { WORLD_LOAD_MILLING_LOOT_TEMPLATES,       "milling_loot_template"       },
+    { WORLD_LOAD_PICKPOCKETING_LOOT_TEMPLATES, "pickpocketing_loot_template" },
+    { WORLD_LOAD_PROSPECTING_LOOT_TEMPLATES,   "prospecting_loot_template"   },
+    { WORLD_LOAD_REFERENCE_LOOT_TEMPLATES,     "reference_loot_template"     },
+    { WORLD_LOAD_SKINNING_LOOT_TEMPLATES,      "skinning_loot_template"      },
+    { WORLD_LOAD_SPELL_LOOT_TEMPLATES,         "spell_loot_template"         },
+    { 0,                                       NULL                          }
+};
+
+static WorldLoadBenchmark worldLoadBenchmark;
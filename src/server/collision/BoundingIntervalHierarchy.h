@@ -37,6 +37,14 @@
 
 #define MAX_STACK_SIZE 64
 
+// rays traced together by BIH::intersectRayPacket()
+#define RAY_PACKET_SIZE 4
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #define BIH_PACKET_SSE
+    #include <xmmintrin.h>
+#endif
+
 #ifdef _MSC_VER
     #define isnan(x) _isnan(x)
 #endif
@@ -67,6 +75,50 @@ static inline float intBitsToFloat(uint32 i)
     return temp.fval;
 }
 
+// one float per ray of a packet, with the few operations the packet traversal needs
+namespace RayPacket
+{
+#ifdef BIH_PACKET_SSE
+    typedef __m128 Lanes;
+
+    static inline Lanes set(float f) { return _mm_set1_ps(f); }
+    static inline Lanes load(const float* f) { return _mm_loadu_ps(f); }
+    static inline Lanes sub(Lanes a, Lanes b) { return _mm_sub_ps(a, b); }
+    static inline Lanes mul(Lanes a, Lanes b) { return _mm_mul_ps(a, b); }
+    // NaN in a (plane through the origin of an axis parallel ray) yields b: the interval stays as wide as it was
+    static inline Lanes min(Lanes a, Lanes b) { return _mm_min_ps(a, b); }
+    static inline Lanes max(Lanes a, Lanes b) { return _mm_max_ps(a, b); }
+    // bit i set where a[i] <= b[i]
+    static inline int lessEqual(Lanes a, Lanes b) { return _mm_movemask_ps(_mm_cmple_ps(a, b)); }
+
+    typedef __m128 Mask;
+
+    // lane i selected where bit i is set
+    static inline Mask mask(int bits)
+    {
+        union { uint32 u[4]; __m128 v; } m;
+        for (int i = 0; i < 4; ++i)
+            m.u[i] = (bits & (1 << i)) ? 0xFFFFFFFF : 0;
+        return m.v;
+    }
+    // a in the selected lanes, b elsewhere
+    static inline Lanes select(Mask m, Lanes a, Lanes b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+#else
+    struct Lanes { float f[4]; };
+    typedef int Mask;
+
+    static inline Lanes set(float f) { Lanes r; for (int i = 0; i < 4; ++i) r.f[i] = f; return r; }
+    static inline Lanes load(const float* f) { Lanes r; for (int i = 0; i < 4; ++i) r.f[i] = f[i]; return r; }
+    static inline Lanes sub(Lanes a, Lanes b) { for (int i = 0; i < 4; ++i) a.f[i] -= b.f[i]; return a; }
+    static inline Lanes mul(Lanes a, Lanes b) { for (int i = 0; i < 4; ++i) a.f[i] *= b.f[i]; return a; }
+    static inline Lanes min(Lanes a, Lanes b) { for (int i = 0; i < 4; ++i) a.f[i] = a.f[i] < b.f[i] ? a.f[i] : b.f[i]; return a; }
+    static inline Lanes max(Lanes a, Lanes b) { for (int i = 0; i < 4; ++i) a.f[i] = a.f[i] > b.f[i] ? a.f[i] : b.f[i]; return a; }
+    static inline int lessEqual(Lanes a, Lanes b) { int m = 0; for (int i = 0; i < 4; ++i) if (a.f[i] <= b.f[i]) m |= 1 << i; return m; }
+    static inline Mask mask(int bits) { return bits; }
+    static inline Lanes select(Mask m, Lanes a, Lanes b) { for (int i = 0; i < 4; ++i) if (!(m & (1 << i))) a.f[i] = b.f[i]; return a; }
+#endif
+}
+
 struct AABound
 {
     Vector3 lo, hi;
@@ -256,6 +308,191 @@ class BIH
             }
         }
 
+        /**
+        Traces up to RAY_PACKET_SIZE rays through the tree at once, the node tests are done
+        for all rays of the packet together. Tracing of a ray stops at its first hit:
+        hits[i] tells whether rays[i] hit anything closer than maxDist[i].
+        */
+        template<typename RayCallback>
+        void intersectRayPacket(const Ray* rays, float* maxDist, bool* hits, uint32 count, RayCallback& intersectCallback) const
+        {
+            using namespace RayPacket;
+
+            float org[3][RAY_PACKET_SIZE];
+            float invDir[3][RAY_PACKET_SIZE];
+            float intervalMin[RAY_PACKET_SIZE];
+            float intervalMax[RAY_PACKET_SIZE];
+            int negative[3] = { 0, 0, 0 };                  // rays going towards the low end of the axis
+            int active = 0;
+
+            for (uint32 r = 0; r < RAY_PACKET_SIZE; ++r)
+            {
+                // unused lanes get a copy of the first ray and stay inactive
+                const Ray& ray = rays[r < count ? r : 0];
+                if (r < count)
+                    hits[r] = false;
+
+                intervalMin[r] = -1.f;
+                intervalMax[r] = -1.f;
+                bool inside = r < count;
+                for (int i = 0; i < 3; ++i)
+                {
+                    float dir = ray.direction()[i];
+                    org[i][r] = ray.origin()[i];
+                    invDir[i][r] = 1.f / dir;
+                    if (floatToRawIntBits(dir) >> 31)
+                        negative[i] |= 1 << r;
+
+                    // same clipping against the tree bounds as intersectRay()
+                    if (inside && G3D::fuzzyNe(dir, 0.0f))
+                    {
+                        float t1 = (bounds.low()[i]  - org[i][r]) * invDir[i][r];
+                        float t2 = (bounds.high()[i] - org[i][r]) * invDir[i][r];
+                        if (t1 > t2)
+                            std::swap(t1, t2);
+                        if (t1 > intervalMin[r])
+                            intervalMin[r] = t1;
+                        if (t2 < intervalMax[r] || intervalMax[r] < 0.f)
+                            intervalMax[r] = t2;
+                        if (intervalMax[r] <= 0 || intervalMin[r] >= maxDist[r])
+                            inside = false;
+                    }
+                }
+
+                if (inside && intervalMin[r] <= intervalMax[r])
+                {
+                    intervalMin[r] = std::max(intervalMin[r], 0.f);
+                    intervalMax[r] = std::min(intervalMax[r], maxDist[r]);
+                    active |= 1 << r;
+                }
+            }
+
+            if (!active)
+                return;
+
+            Lanes orgL[3] = { load(org[0]), load(org[1]), load(org[2]) };
+            Lanes invDirL[3] = { load(invDir[0]), load(invDir[1]), load(invDir[2]) };
+            Mask negativeL[3] = { mask(negative[0]), mask(negative[1]), mask(negative[2]) };
+            Lanes tMin = load(intervalMin);
+            Lanes tMax = load(intervalMax);
+
+            PacketStackNode stack[MAX_STACK_SIZE];
+            int stackPos = 0;
+            int node = 0;
+
+            while (true) {
+                while (true)
+                {
+                    uint32 tn = tree[node];
+                    uint32 axis = (tn & (3 << 30)) >> 30;
+                    bool BVH2 = tn & (1 << 29);
+                    int offset = tn & ~(7 << 29);
+                    if (!BVH2)
+                    {
+                        if (axis < 3)
+                        {
+                            // "normal" interior node, left child ends at the first plane, right one starts at the second
+                            Lanes tl = mul(sub(set(intBitsToFloat(tree[node + 1])), orgL[axis]), invDirL[axis]);
+                            Lanes tr = mul(sub(set(intBitsToFloat(tree[node + 2])), orgL[axis]), invDirL[axis]);
+                            Mask neg = negativeL[axis];
+
+                            Lanes leftMin = select(neg, max(tl, tMin), tMin);
+                            Lanes leftMax = select(neg, tMax, min(tl, tMax));
+                            Lanes rightMin = select(neg, tMin, max(tr, tMin));
+                            Lanes rightMax = select(neg, min(tr, tMax), tMax);
+
+                            int left = active & lessEqual(leftMin, leftMax);
+                            int right = active & lessEqual(rightMin, rightMax);
+
+                            // rays pass between clip zones
+                            if (!left && !right)
+                                break;
+                            if (!right)
+                            {
+                                node = offset;
+                                active = left;
+                                tMin = leftMin;
+                                tMax = leftMax;
+                                continue;
+                            }
+                            if (!left)
+                            {
+                                node = offset + 3;
+                                active = right;
+                                tMin = rightMin;
+                                tMax = rightMax;
+                                continue;
+                            }
+
+                            // both children, the near one of the first ray first
+                            bool leftFirst = !(negative[axis] & active & -active);
+                            stack[stackPos].node = leftFirst ? offset + 3 : offset;
+                            stack[stackPos].active = leftFirst ? right : left;
+                            stack[stackPos].tnear = leftFirst ? rightMin : leftMin;
+                            stack[stackPos].tfar = leftFirst ? rightMax : leftMax;
+                            stackPos++;
+
+                            node = leftFirst ? offset : offset + 3;
+                            active = leftFirst ? left : right;
+                            tMin = leftFirst ? leftMin : rightMin;
+                            tMax = leftFirst ? leftMax : rightMax;
+                            continue;
+                        }
+                        else
+                        {
+                            // leaf - test some objects against the rays still looking for a hit
+                            int n = tree[node + 1];
+                            while (n > 0 && active) {
+                                for (uint32 r = 0; r < count; ++r)
+                                {
+                                    if ((active & (1 << r)) && intersectCallback(rays[r], objects[offset], maxDist[r], true))
+                                    {
+                                        hits[r] = true;
+                                        active &= ~(1 << r);
+                                        for (int i = 0; i < stackPos; ++i)
+                                            stack[i].active &= ~(1 << r);
+                                    }
+                                }
+                                --n;
+                                ++offset;
+                            }
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        if (axis>2)
+                            return; // should not happen
+                        Lanes tlo = mul(sub(set(intBitsToFloat(tree[node + 1])), orgL[axis]), invDirL[axis]);
+                        Lanes thi = mul(sub(set(intBitsToFloat(tree[node + 2])), orgL[axis]), invDirL[axis]);
+                        Mask neg = negativeL[axis];
+                        node = offset;
+                        tMin = max(select(neg, thi, tlo), tMin);
+                        tMax = min(select(neg, tlo, thi), tMax);
+                        active &= lessEqual(tMin, tMax);
+                        if (!active)
+                            break;
+                        continue;
+                    }
+                } // traversal loop
+                do
+                {
+                    // stack is empty?
+                    if (stackPos == 0)
+                        return;
+                    // move back up the stack
+                    stackPos--;
+                    active = stack[stackPos].active;
+                    if (!active)
+                        continue;
+                    node = stack[stackPos].node;
+                    tMin = stack[stackPos].tnear;
+                    tMax = stack[stackPos].tfar;
+                    break;
+                } while (true);
+            }
+        }
+
         template<typename IsectCallback>
         void intersectPoint(const Vector3 &p, IsectCallback& intersectCallback) const
         {
@@ -355,6 +592,13 @@ class BIH
             float tnear;
             float tfar;
         };
+        struct PacketStackNode
+        {
+            RayPacket::Lanes tnear;
+            RayPacket::Lanes tfar;
+            uint32 node;
+            int active;
+        };
 
         class BuildStats
         {
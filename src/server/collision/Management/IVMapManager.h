@@ -20,6 +20,7 @@
 #define _IVMAPMANAGER_H
 
 #include <string>
+#include <vector>
 #include "Define.h"
 
 //===========================================================
@@ -53,6 +54,12 @@ namespace VMAP
 
             virtual ~IVMapManager(void) {}
 
+            /**
+            Register the maps that can be loaded. Must be called once, before any map is loaded
+            or queried: the map lookups are not synchronized, they rely on the set of maps to never change.
+            */
+            virtual void initializeMaps(const char* pBasePath, const std::vector<uint32>& pMapIds) = 0;
+
             virtual int loadMap(const char* pBasePath, unsigned int pMapId, int x, int y) = 0;
 
             virtual bool existsMap(const char* pBasePath, unsigned int pMapId, int x, int y) = 0;
@@ -61,6 +68,10 @@ namespace VMAP
             virtual void unloadMap(unsigned int pMapId) = 0;
 
             virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2) = 0;
+            /**
+            line of sight for pCount pairs of positions at once, pCoords holds x1, y1, z1, x2, y2, z2 of each pair
+            */
+            virtual void isInLineOfSight(unsigned int pMapId, const float* pCoords, uint32 pCount, bool* pResults) = 0;
             virtual float getHeight(unsigned int pMapId, float x, float y, float z, float maxSearchDist) = 0;
             /**
             test if we hit an object. return true if we hit one. rx, ry, rz will hold the hit position or the dest position, if no intersection was found
@@ -84,6 +84,13 @@ namespace VMAP
         return fname.str();
     }
 
+    void VMapManager2::initializeMaps(const char* basePath, const std::vector<uint32>& mapIds)
+    {
+        for (std::vector<uint32>::const_iterator itr = mapIds.begin(); itr != mapIds.end(); ++itr)
+            if (iInstanceMapTrees.find(*itr) == iInstanceMapTrees.end())
+                iInstanceMapTrees[*itr] = new StaticMapTree(*itr, basePath);
+    }
+
     int VMapManager2::loadMap(const char* basePath, unsigned int mapId, int x, int y)
     {
         int result = VMAP_LOAD_RESULT_IGNORED;
@@ -99,16 +106,13 @@ namespace VMAP
     }
 
     // load one tile (internal use only)
-    bool VMapManager2::_loadMap(unsigned int mapId, const std::string& basePath, uint32 tileX, uint32 tileY)
+    bool VMapManager2::_loadMap(unsigned int mapId, const std::string& /*basePath*/, uint32 tileX, uint32 tileY)
     {
         InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(mapId);
         if (instanceTree == iInstanceMapTrees.end())
         {
-            std::string mapFileName = getMapFileName(mapId);
-            StaticMapTree* newTree = new StaticMapTree(mapId, basePath);
-            if (!newTree->InitMap(mapFileName, this))
-                return false;
-            instanceTree = iInstanceMapTrees.insert(InstanceTreeMap::value_type(mapId, newTree)).first;
+            sLog->outError("VMapManager2: trying to load map %u that was not registered", mapId);
+            return false;
         }
 
         return instanceTree->second->LoadMapTile(tileX, tileY, this);
@@ -118,28 +122,14 @@ namespace VMAP
     {
         InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(mapId);
         if (instanceTree != iInstanceMapTrees.end())
-        {
             instanceTree->second->UnloadMap(this);
-            if (instanceTree->second->numLoadedTiles() == 0)
-            {
-                delete instanceTree->second;
-                iInstanceMapTrees.erase(mapId);
-            }
-        }
     }
 
     void VMapManager2::unloadMap(unsigned int mapId, int x, int y)
     {
         InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(mapId);
         if (instanceTree != iInstanceMapTrees.end())
-        {
             instanceTree->second->UnloadMapTile(x, y, this);
-            if (instanceTree->second->numLoadedTiles() == 0)
-            {
-                delete instanceTree->second;
-                iInstanceMapTrees.erase(mapId);
-            }
-        }
     }
 
     bool VMapManager2::isInLineOfSight(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2)
@@ -161,6 +151,33 @@ namespace VMAP
         return true;
     }
 
+    void VMapManager2::isInLineOfSight(unsigned int mapId, const float* coords, uint32 count, bool* results)
+    {
+        if (!count)
+            return;
+
+        if (isLineOfSightCalcEnabled() && !sDisableMgr->IsDisabledFor(DISABLE_TYPE_VMAP, mapId, NULL, VMAP_DISABLE_LOS))
+        {
+            InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(mapId);
+            if (instanceTree != iInstanceMapTrees.end())
+            {
+                std::vector<Vector3> pos1(count);
+                std::vector<Vector3> pos2(count);
+                for (uint32 i = 0; i < count; ++i, coords += 6)
+                {
+                    pos1[i] = convertPositionToInternalRep(coords[0], coords[1], coords[2]);
+                    pos2[i] = convertPositionToInternalRep(coords[3], coords[4], coords[5]);
+                }
+
+                instanceTree->second->isInLineOfSight(&pos1[0], &pos2[0], results, count);
+                return;
+            }
+        }
+
+        for (uint32 i = 0; i < count; ++i)
+            results[i] = true;
+    }
+
     /**
     get the hit position and return true if we hit something
     otherwise the result pos will be the dest pos
@@ -239,18 +256,8 @@ namespace VMAP
             InstanceTreeMap::const_iterator instanceTree = iInstanceMapTrees.find(mapId);
             if (instanceTree != iInstanceMapTrees.end())
             {
-                LocationInfo info;
                 Vector3 pos = convertPositionToInternalRep(x, y, z);
-                if (instanceTree->second->GetLocationInfo(pos, info))
-                {
-                    floor = info.ground_Z;
-                    ASSERT(floor < std::numeric_limits<float>::max());
-                    type = info.hitModel->GetLiquidType();
-                    if (reqLiquidType && !(type & reqLiquidType))
-                        return false;
-                    if (info.hitInstance->GetLiquidLevel(pos, info, level))
-                        return true;
-                }
+                return instanceTree->second->GetLiquidLevel(pos, reqLiquidType, level, floor, type);
             }
         }
 
@@ -259,37 +266,65 @@ namespace VMAP
 
     WorldModel* VMapManager2::acquireModelInstance(const std::string& basepath, const std::string& filename)
     {
-        ModelFileMap::iterator model = iLoadedModelFiles.find(filename);
-        if (model == iLoadedModelFiles.end())
         {
-            WorldModel* worldmodel = new WorldModel();
-            if (!worldmodel->readFile(basepath + filename + ".vmo"))
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, iLoadedModelFilesLock, NULL);
+
+            ModelFileMap::iterator model = iLoadedModelFiles.find(filename);
+            if (model != iLoadedModelFiles.end())
             {
-                sLog->outError("VMapManager2: could not load '%s%s.vmo'", basepath.c_str(), filename.c_str());
-                delete worldmodel;
-                return NULL;
+                model->second.incRefCount();
+                return model->second.getModel();
             }
-            sLog->outDebug(LOG_FILTER_MAPS, "VMapManager2: loading file '%s%s'", basepath.c_str(), filename.c_str());
+        }
+
+        // read the file unlocked, other maps may load their tiles meanwhile
+        WorldModel* worldmodel = new WorldModel();
+        if (!worldmodel->readFile(basepath + filename + ".vmo"))
+        {
+            sLog->outError("VMapManager2: could not load '%s%s.vmo'", basepath.c_str(), filename.c_str());
+            delete worldmodel;
+            return NULL;
+        }
+        sLog->outDebug(LOG_FILTER_MAPS, "VMapManager2: loading file '%s%s'", basepath.c_str(), filename.c_str());
+
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, iLoadedModelFilesLock, NULL);
+
+        ModelFileMap::iterator model = iLoadedModelFiles.find(filename);
+        if (model == iLoadedModelFiles.end())
+        {
             model = iLoadedModelFiles.insert(std::pair<std::string, ManagedModel>(filename, ManagedModel())).first;
             model->second.setModel(worldmodel);
         }
+        else
+            delete worldmodel;                              // loaded by another map in the meantime
+
         model->second.incRefCount();
         return model->second.getModel();
     }
 
     void VMapManager2::releaseModelInstance(const std::string &filename)
     {
-        ModelFileMap::iterator model = iLoadedModelFiles.find(filename);
-        if (model == iLoadedModelFiles.end())
+        WorldModel* unloadedModel = NULL;
         {
-            sLog->outError("VMapManager2: trying to unload non-loaded file '%s'", filename.c_str());
-            return;
+            ACE_GUARD(ACE_Thread_Mutex, guard, iLoadedModelFilesLock);
+
+            ModelFileMap::iterator model = iLoadedModelFiles.find(filename);
+            if (model == iLoadedModelFiles.end())
+            {
+                sLog->outError("VMapManager2: trying to unload non-loaded file '%s'", filename.c_str());
+                return;
+            }
+            if (model->second.decRefCount() == 0)
+            {
+                unloadedModel = model->second.getModel();
+                iLoadedModelFiles.erase(model);
+            }
         }
-        if (model->second.decRefCount() == 0)
+
+        if (unloadedModel)
         {
             sLog->outDebug(LOG_FILTER_MAPS, "VMapManager2: unloading file '%s'", filename.c_str());
-            delete model->second.getModel();
-            iLoadedModelFiles.erase(model);
+            delete unloadedModel;
         }
     }
 
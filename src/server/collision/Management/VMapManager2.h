@@ -23,6 +23,8 @@
 #include "Dynamic/UnorderedMap.h"
 #include "Define.h"
 
+#include <ace/Thread_Mutex.h>
+
 //===========================================================
 
 #define MAP_FILENAME_EXTENSION2 ".vmtree"
@@ -70,6 +72,9 @@ namespace VMAP
         protected:
             // Tree to check collision
             ModelFileMap iLoadedModelFiles;
+            ACE_Thread_Mutex iLoadedModelFilesLock;
+            // one tree per map, filled by initializeMaps() and never changed afterwards,
+            // so that the map threads can look them up without locking
             InstanceTreeMap iInstanceMapTrees;
 
             bool _loadMap(uint32 mapId, const std::string& basePath, uint32 tileX, uint32 tileY);
@@ -84,12 +89,15 @@ namespace VMAP
             VMapManager2();
             ~VMapManager2(void);
 
+            void initializeMaps(const char* pBasePath, const std::vector<uint32>& pMapIds);
+
             int loadMap(const char* pBasePath, unsigned int mapId, int x, int y);
 
             void unloadMap(unsigned int mapId, int x, int y);
             void unloadMap(unsigned int mapId);
 
             bool isInLineOfSight(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2) ;
+            void isInLineOfSight(unsigned int mapId, const float* coords, uint32 count, bool* results);
             /**
             fill the hit pos and return true, if an object was hit
             */
@@ -18,6 +18,7 @@
 
 #include "MapTree.h"
 #include "ModelInstance.h"
+#include "WorldModel.h"
 #include "VMapManager2.h"
 #include "VMapDefinitions.h"
 #include "Log.h"
@@ -26,6 +27,7 @@
 #include <sstream>
 #include <iomanip>
 #include <limits>
+#include <vector>
 
 #ifndef NO_CORE_FUNCS
     #include "Errors.h"
@@ -103,6 +105,10 @@ namespace VMAP
 
     bool StaticMapTree::getAreaInfo(Vector3 &pos, uint32 &flags, int32 &adtId, int32 &rootId, int32 &groupId) const
     {
+        ACE_READ_GUARD_RETURN(ACE_RW_Thread_Mutex, guard, iLock, false);
+        if (!iTreeValues)
+            return false;
+
         AreaInfoCallback intersectionCallBack(iTreeValues);
         iTree.intersectPoint(pos, intersectionCallBack);
         if (intersectionCallBack.aInfo.result)
@@ -117,6 +123,7 @@ namespace VMAP
         return false;
     }
 
+    // iLock must be held while info is used, it points into the tree
     bool StaticMapTree::GetLocationInfo(const Vector3 &pos, LocationInfo &info) const
     {
         LocationInfoCallback intersectionCallBack(iTreeValues, info);
@@ -124,8 +131,28 @@ namespace VMAP
         return intersectionCallBack.result;
     }
 
+    bool StaticMapTree::GetLiquidLevel(const Vector3 &pos, uint8 reqLiquidType, float &level, float &floor, uint32 &type) const
+    {
+        ACE_READ_GUARD_RETURN(ACE_RW_Thread_Mutex, guard, iLock, false);
+        if (!iTreeValues)
+            return false;
+
+        LocationInfo info;
+        if (GetLocationInfo(pos, info))
+        {
+            floor = info.ground_Z;
+            ASSERT(floor < std::numeric_limits<float>::max());
+            type = info.hitModel->GetLiquidType();
+            if (reqLiquidType && !(type & reqLiquidType))
+                return false;
+            if (info.hitInstance->GetLiquidLevel(pos, info, level))
+                return true;
+        }
+        return false;
+    }
+
     StaticMapTree::StaticMapTree(uint32 mapID, const std::string &basePath):
-        iMapID(mapID), iTreeValues(0), iBasePath(basePath)
+        iMapID(mapID), iIsTiled(false), iTreeValues(0), iNTreeValues(0), iBasePath(basePath)
     {
         if (iBasePath.length() > 0 && (iBasePath[iBasePath.length()-1] != '/' || iBasePath[iBasePath.length()-1] != '\\'))
         {
@@ -140,6 +167,17 @@ namespace VMAP
         delete[] iTreeValues;
     }
 
+    //=========================================================
+    // forget the map data, iLock must be held exclusively
+
+    void StaticMapTree::reset()
+    {
+        delete[] iTreeValues;
+        iTreeValues = 0;
+        iNTreeValues = 0;
+        iTree = BIH();
+    }
+
     //=========================================================
     /**
     If intersection is found within pMaxDist, sets pMaxDist to intersection distance and returns true.
@@ -148,6 +186,10 @@ namespace VMAP
 
     bool StaticMapTree::getIntersectionTime(const G3D::Ray& pRay, float &pMaxDist, bool pStopAtFirstHit) const
     {
+        ACE_READ_GUARD_RETURN(ACE_RW_Thread_Mutex, guard, iLock, false);
+        if (!iTreeValues)
+            return false;
+
         float distance = pMaxDist;
         MapRayCallback intersectionCallBack(iTreeValues);
         iTree.intersectRay(pRay, intersectionCallBack, distance, pStopAtFirstHit);
@@ -172,6 +214,51 @@ namespace VMAP
 
         return true;
     }
+    //=========================================================
+    /**
+    Line of sight for count pairs of positions, traced in packets of RAY_PACKET_SIZE rays
+    */
+
+    void StaticMapTree::isInLineOfSight(const Vector3* pos1, const Vector3* pos2, bool* results, uint32 count) const
+    {
+        for (uint32 i = 0; i < count; ++i)
+            results[i] = true;
+
+        ACE_READ_GUARD(ACE_RW_Thread_Mutex, guard, iLock);
+        if (!iTreeValues)
+            return;
+
+        MapRayCallback intersectionCallBack(iTreeValues);
+        G3D::Ray rays[RAY_PACKET_SIZE];
+        float maxDist[RAY_PACKET_SIZE];
+        bool hits[RAY_PACKET_SIZE];
+        uint32 indexes[RAY_PACKET_SIZE];
+        uint32 packed = 0;
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            float dist = (pos2[i] - pos1[i]).magnitude();
+            // valid map coords should *never ever* produce float overflow, but this would produce NaNs too
+            ASSERT(dist < std::numeric_limits<float>::max());
+            // prevent NaN values which can cause BIH intersection to enter infinite loop
+            if (dist >= 1e-10f)
+            {
+                rays[packed] = G3D::Ray::fromOriginAndDirection(pos1[i], (pos2[i] - pos1[i])/dist);
+                maxDist[packed] = dist;
+                indexes[packed] = i;
+                ++packed;
+            }
+
+            if (packed == RAY_PACKET_SIZE || (packed && i + 1 == count))
+            {
+                iTree.intersectRayPacket(rays, maxDist, hits, packed, intersectionCallBack);
+                for (uint32 r = 0; r < packed; ++r)
+                    results[indexes[r]] = !hits[r];
+                packed = 0;
+            }
+        }
+    }
+
     //=========================================================
     /**
     When moving from pos1 to pos2 check if we hit an object. Return true and the position if we hit one
@@ -275,6 +362,7 @@ namespace VMAP
 
     //=========================================================
 
+    // iLoadLock and iLock must be held
     bool StaticMapTree::InitMap(const std::string &fname, VMapManager2 *vm)
     {
         sLog->outDebug(LOG_FILTER_MAPS, "StaticMapTree::InitMap() : initializing StaticMapTree '%s'", fname.c_str());
@@ -333,20 +421,40 @@ namespace VMAP
 
     void StaticMapTree::UnloadMap(VMapManager2 *vm)
     {
+        ACE_GUARD(ACE_Thread_Mutex, loadGuard, iLoadLock);
+
+        std::vector<std::string> releasedModels;
         for (loadedSpawnMap::iterator i = iLoadedSpawns.begin(); i != iLoadedSpawns.end(); ++i)
-        {
-            iTreeValues[i->first].setUnloaded();
-            for (uint32 refCount = 0; refCount < i->second; ++refCount)
-                vm->releaseModelInstance(iTreeValues[i->first].name);
-        }
+            releasedModels.insert(releasedModels.end(), i->second, iTreeValues[i->first].name);
         iLoadedSpawns.clear();
         iLoadedTiles.clear();
+
+        {
+            ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, iLock);
+            reset();
+        }
+
+        // no query can reach the models anymore
+        for (std::vector<std::string>::const_iterator itr = releasedModels.begin(); itr != releasedModels.end(); ++itr)
+            vm->releaseModelInstance(*itr);
     }
 
     //=========================================================
 
     bool StaticMapTree::LoadMapTile(uint32 tileX, uint32 tileY, VMapManager2 *vm)
     {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, loadGuard, iLoadLock, false);
+
+        if (!iTreeValues)
+        {
+            ACE_WRITE_GUARD_RETURN(ACE_RW_Thread_Mutex, guard, iLock, false);
+            if (!InitMap(VMapManager2::getMapFileName(iMapID), vm))
+            {
+                reset();
+                return false;
+            }
+        }
+
         if (!iIsTiled)
         {
             // currently, core creates grids for all maps, whether it has terrain tiles or not
@@ -354,13 +462,13 @@ namespace VMAP
             iLoadedTiles[packTileID(tileX, tileY)] = false;
             return true;
         }
-        if (!iTreeValues)
-        {
-            sLog->outError("StaticMapTree::LoadMapTile() : tree has not been initialized [%u, %u]", tileX, tileY);
-            return false;
-        }
         bool result = true;
 
+        // the tile is read and its models are loaded while the queries go on,
+        // the new tree values are published at the end
+        typedef std::vector<std::pair<uint32, ModelInstance> > LoadedInstances;
+        LoadedInstances loadedInstances;
+
         std::string tilefile = iBasePath + getTileFileName(iMapID, tileX, tileY);
         FILE* tf = fopen(tilefile.c_str(), "rb");
         if (tf)
@@ -398,7 +506,7 @@ namespace VMAP
                                 continue;
                             }
 #endif
-                            iTreeValues[referencedVal] = ModelInstance(spawn, model);
+                            loadedInstances.push_back(LoadedInstances::value_type(referencedVal, ModelInstance(spawn, model)));
                             iLoadedSpawns[referencedVal] = 1;
                         }
                         else
@@ -421,6 +529,13 @@ namespace VMAP
         }
         else
             iLoadedTiles[packTileID(tileX, tileY)] = false;
+
+        if (!loadedInstances.empty())
+        {
+            ACE_WRITE_GUARD_RETURN(ACE_RW_Thread_Mutex, guard, iLock, false);
+            for (LoadedInstances::const_iterator itr = loadedInstances.begin(); itr != loadedInstances.end(); ++itr)
+                iTreeValues[itr->first] = itr->second;
+        }
         return result;
     }
 
@@ -428,6 +543,8 @@ namespace VMAP
 
     void StaticMapTree::UnloadMapTile(uint32 tileX, uint32 tileY, VMapManager2 *vm)
     {
+        ACE_GUARD(ACE_Thread_Mutex, loadGuard, iLoadLock);
+
         uint32 tileID = packTileID(tileX, tileY);
         loadedTileMap::iterator tile = iLoadedTiles.find(tileID);
         if (tile == iLoadedTiles.end())
@@ -435,6 +552,11 @@ namespace VMAP
             sLog->outError("StaticMapTree::UnloadMapTile() : trying to unload non-loaded tile - Map:%u X:%u Y:%u", iMapID, tileX, tileY);
             return;
         }
+
+        // models are released once the queries can not reach them anymore
+        std::vector<std::string> releasedModels;
+        std::vector<uint32> unloadedNodes;
+
         if (tile->second) // file associated with tile
         {
             std::string tilefile = iBasePath + getTileFileName(iMapID, tileX, tileY);
@@ -456,7 +578,7 @@ namespace VMAP
                     if (result)
                     {
                         // release model instance
-                        vm->releaseModelInstance(spawn.name);
+                        releasedModels.push_back(spawn.name);
 
                         // update tree
                         uint32 referencedNode;
@@ -469,7 +591,7 @@ namespace VMAP
                             sLog->outError("StaticMapTree::UnloadMapTile() : trying to unload non-referenced model '%s' (ID:%u)", spawn.name.c_str(), spawn.ID);
                             else if (--iLoadedSpawns[referencedNode] == 0)
                             {
-                                iTreeValues[referencedNode].setUnloaded();
+                                unloadedNodes.push_back(referencedNode);
                                 iLoadedSpawns.erase(referencedNode);
                             }
                         }
@@ -479,6 +601,26 @@ namespace VMAP
             }
         }
         iLoadedTiles.erase(tile);
+
+        // the last tile takes the whole map with it
+        if (iLoadedTiles.empty())
+        {
+            for (loadedSpawnMap::iterator i = iLoadedSpawns.begin(); i != iLoadedSpawns.end(); ++i)
+                releasedModels.insert(releasedModels.end(), i->second, iTreeValues[i->first].name);
+            iLoadedSpawns.clear();
+        }
+
+        {
+            ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, iLock);
+            if (iLoadedTiles.empty())
+                reset();
+            else
+                for (std::vector<uint32>::const_iterator itr = unloadedNodes.begin(); itr != unloadedNodes.end(); ++itr)
+                    iTreeValues[*itr].setUnloaded();
+        }
+
+        for (std::vector<std::string>::const_iterator itr = releasedModels.begin(); itr != releasedModels.end(); ++itr)
+            vm->releaseModelInstance(*itr);
     }
 
 }
@@ -23,6 +23,9 @@
 #include "Dynamic/UnorderedMap.h"
 #include "BoundingIntervalHierarchy.h"
 
+#include <ace/RW_Thread_Mutex.h>
+#include <ace/Thread_Mutex.h>
+
 namespace VMAP
 {
     class ModelInstance;
@@ -56,8 +59,16 @@ namespace VMAP
             loadedSpawnMap iLoadedSpawns;
             std::string iBasePath;
 
+            // queries share iLock, loads hold it exclusively only to publish what they read;
+            // iLoadLock serializes loading and unloading of this map against each other
+            mutable ACE_RW_Thread_Mutex iLock;
+            ACE_Thread_Mutex iLoadLock;
+
         private:
             bool getIntersectionTime(const G3D::Ray& pRay, float &pMaxDist, bool pStopAtFirstHit) const;
+            bool GetLocationInfo(const Vector3 &pos, LocationInfo &info) const;
+            bool InitMap(const std::string &fname, VMapManager2 *vm);
+            void reset();
             //bool containsLoadedMapTile(unsigned int pTileIdent) const { return(iLoadedMapTiles.containsKey(pTileIdent)); }
         public:
             static std::string getTileFileName(uint32 mapID, uint32 tileX, uint32 tileY);
@@ -69,17 +80,17 @@ namespace VMAP
             ~StaticMapTree();
 
             bool isInLineOfSight(const G3D::Vector3& pos1, const G3D::Vector3& pos2) const;
+            void isInLineOfSight(const G3D::Vector3* pos1, const G3D::Vector3* pos2, bool* results, uint32 count) const;
             bool getObjectHitPos(const G3D::Vector3& pos1, const G3D::Vector3& pos2, G3D::Vector3& pResultHitPos, float pModifyDist) const;
             float getHeight(const G3D::Vector3& pPos, float maxSearchDist) const;
             bool getAreaInfo(G3D::Vector3 &pos, uint32 &flags, int32 &adtId, int32 &rootId, int32 &groupId) const;
-            bool GetLocationInfo(const Vector3 &pos, LocationInfo &info) const;
+            bool GetLiquidLevel(const Vector3 &pos, uint8 reqLiquidType, float &level, float &floor, uint32 &type) const;
 
-            bool InitMap(const std::string &fname, VMapManager2 *vm);
+            // the tree of the map is read on the first tile load and freed again with the last tile
             void UnloadMap(VMapManager2 *vm);
             bool LoadMapTile(uint32 tileX, uint32 tileY, VMapManager2 *vm);
             void UnloadMapTile(uint32 tileX, uint32 tileY, VMapManager2 *vm);
             bool isTiled() const { return iIsTiled; }
-            uint32 numLoadedTiles() const { return iLoadedTiles.size(); }
     };
 
     struct AreaInfo
@@ -41,6 +41,7 @@ SmartScript::SmartScript()
     mInvinceabilityHpLevel = 0;
     mPathId = 0;
     mTargetStorage = new ObjectListMap();
+    memset(mEventTypeOffsets, 0, sizeof(mEventTypeOffsets));
     mStoredEvents.clear();
     mTextTimer = 0;
     mLastTextID = 0;
@@ -60,6 +61,9 @@ SmartScript::~SmartScript()
         delete itr->second;
 
     delete mTargetStorage;
+
+    for (std::vector<ObjectList*>::const_iterator itr = mFreeTargetLists.begin(); itr != mFreeTargetLists.end(); ++itr)
+        delete *itr;
 }
 
 void SmartScript::OnReset()
@@ -93,15 +97,34 @@ void SmartScript::ProcessEventsFor(SMART_EVENT e, Unit* unit, uint32 var0, uint3
             }
         }
     }
-    for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
-    {
-        SMART_EVENT eventType = SMART_EVENT((*i).GetEventType());
-        if (eventType == SMART_EVENT_LINK)//special handling
-            continue;
 
-        if (eventType == e/* && (!(*i).event.event_phase_mask || IsInPhase((*i).event.event_phase_mask)) && !((*i).event.event_flags & SMART_EVENT_FLAG_NOT_REPEATABLE && (*i).runOnce)*/)
-            ProcessEvent(*i, unit, var0, var1, bvar, spell, gob);
-    }
+    if (e == SMART_EVENT_LINK || e >= SMART_EVENT_END)//special handling
+        return;
+
+    // only the events of this type, in script order; mEvents is not changed while they are processed
+    for (uint16 i = mEventTypeOffsets[e]; i < mEventTypeOffsets[e + 1]; ++i)
+        ProcessEvent(mEvents[mEventsByType[i]], unit, var0, var1, bvar, spell, gob);
+}
+
+void SmartScript::BuildEventTypeIndex()
+{
+    ASSERT(mEvents.size() <= 0xFFFF);
+
+    uint16 count[SMART_EVENT_END];
+    memset(count, 0, sizeof(count));
+    for (SmartAIEventList::const_iterator i = mEvents.begin(); i != mEvents.end(); ++i)
+        if (i->GetEventType() < SMART_EVENT_END)
+            ++count[i->GetEventType()];
+
+    mEventTypeOffsets[0] = 0;
+    for (uint32 type = 0; type < SMART_EVENT_END; ++type)
+        mEventTypeOffsets[type + 1] = mEventTypeOffsets[type] + count[type];
+
+    mEventsByType.resize(mEventTypeOffsets[SMART_EVENT_END]);
+    memcpy(count, mEventTypeOffsets, sizeof(count));
+    for (uint16 i = 0; i < mEvents.size(); ++i)
+        if (mEvents[i].GetEventType() < SMART_EVENT_END)
+            mEventsByType[count[mEvents[i].GetEventType()]++] = i;
 }
 
 void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
@@ -150,7 +173,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                FreeTargetList(targets);
             }
 
             mLastTextID = e.action.talk.textGroupID;
@@ -180,7 +203,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         (*itr)->GetName(), (*itr)->GetGUIDLow(), uint8(e.action.talk.textGroupID));
                 }
 
-                delete targets;
+                FreeTargetList(targets);
             }
             break;
         }
@@ -199,7 +222,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                FreeTargetList(targets);
             }
             break;
         }
@@ -218,7 +241,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                FreeTargetList(targets);
             }
             break;
         }
@@ -252,7 +275,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                FreeTargetList(targets);
             }
             break;
         }
@@ -296,7 +319,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_FAIL_QUEST:
@@ -315,7 +338,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_ADD_QUEST:
@@ -337,7 +360,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_REACT_STATE:
@@ -385,7 +408,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_THREAT_ALL_PCT:
@@ -424,7 +447,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_CALL_AREAEXPLOREDOREVENTHAPPENS:
@@ -443,7 +466,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_SEND_CASTCREATUREORGO:
@@ -465,7 +488,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_CAST:
@@ -490,7 +513,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_INVOKER_CAST:
@@ -516,7 +539,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_ADD_AURA:
@@ -535,7 +558,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_ACTIVATE_GOBJECT:
@@ -556,7 +579,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_RESET_GOBJECT:
@@ -575,7 +598,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_EMOTE_STATE:
@@ -594,7 +617,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_UNIT_FLAG:
@@ -613,7 +636,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_REMOVE_UNIT_FLAG:
@@ -632,7 +655,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_AUTO_ATTACK:
@@ -724,7 +747,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_REMOVEAURASFROMSPELL:
@@ -743,7 +766,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->GetGUIDLow(), e.action.removeAura.spell);
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_FOLLOW:
@@ -766,7 +789,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_RANDOM_PHASE:
@@ -833,7 +856,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         (*itr)->GetGUIDLow(), e.action.killedMonster.creature);
                 }
 
-                delete targets;
+                FreeTargetList(targets);
             }
             else if (trigger && IsPlayer(unit))
             {
@@ -888,7 +911,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             sLog->outDebug(LOG_FILTER_DATABASE_AI, "SmartScript::ProcessAction: SMART_ACTION_SET_INST_DATA64: Field: %u, data: "UI64FMTD,
                 e.action.setInstanceData64.field, targets->front()->GetGUID());
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_UPDATE_TEMPLATE:
@@ -981,7 +1004,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->ToUnit()->Unmount();
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_INVINCIBILITY_HP_LEVEL:
@@ -1009,7 +1032,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->ToGameObject()->AI()->SetData(e.action.setData.field, e.action.setData.data);
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_MOVE_FORWARD:
@@ -1052,7 +1075,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_SUMMON_CREATURE:
@@ -1072,7 +1095,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                             summon->AI()->AttackStart((*itr)->ToUnit());
                 }
 
-                delete targets;
+                FreeTargetList(targets);
             }
 
             if (e.GetTargetType() != SMART_TARGET_POSITION)
@@ -1101,7 +1124,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     GetBaseObject()->SummonGameObject(e.action.summonGO.entry, x, y, z, o, 0, 0, 0, 0, e.action.summonGO.despawnTime);
                 }
 
-                delete targets;
+                FreeTargetList(targets);
             }
 
             if (e.GetTargetType() != SMART_TARGET_POSITION)
@@ -1124,7 +1147,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 (*itr)->ToUnit()->Kill((*itr)->ToUnit());
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_INSTALL_AI_TEMPLATE:
@@ -1146,7 +1169,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 (*itr)->ToPlayer()->AddItem(e.action.item.entry, e.action.item.count);
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_REMOVE_ITEM:
@@ -1163,7 +1186,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 (*itr)->ToPlayer()->DestroyItemCount(e.action.item.entry, e.action.item.count, true);
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_STORE_VARIABLE_DECIMAL:
@@ -1193,7 +1216,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 (*itr)->ToPlayer()->TeleportTo(e.action.teleport.mapID, e.target.x, e.target.y, e.target.z, e.target.o);
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_FLY:
@@ -1280,7 +1303,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             else if (targets && !targets->empty())
                 me->SetFacing(0, (*targets->begin()));
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_PLAYMOVIE:
@@ -1297,7 +1320,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 (*itr)->ToPlayer()->SendMovieStart(e.action.movie.entry);
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_MOVE_TO_POS:
@@ -1324,7 +1347,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->ToGameObject()->Respawn();
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_CLOSE_GOSSIP:
@@ -1337,7 +1360,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsPlayer(*itr))
                     (*itr)->ToPlayer()->PlayerTalkClass->SendCloseGossip();
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_EQUIP:
@@ -1379,7 +1402,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_CREATE_TIMED_EVENT:
@@ -1447,7 +1470,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_RESET_SCRIPT_BASE_OBJECT:
@@ -1470,12 +1493,12 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr) && (*itr)->ToUnit()->GetVehicleKit())
                 {
                     me->EnterVehicle((*itr)->ToUnit(), e.action.enterVehicle.seat);
-                    delete targets;
+                    FreeTargetList(targets);
                     return;
                 }
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_CALL_TIMED_ACTIONLIST:
@@ -1503,7 +1526,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                FreeTargetList(targets);
             }
             break;
         }
@@ -1517,7 +1540,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->SetUInt32Value(UNIT_NPC_FLAGS, e.action.unitFlag.flag);
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_ADD_NPC_FLAG:
@@ -1530,7 +1553,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->SetFlag(UNIT_NPC_FLAGS, e.action.unitFlag.flag);
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_REMOVE_NPC_FLAG:
@@ -1543,7 +1566,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->RemoveFlag(UNIT_NPC_FLAGS, e.action.unitFlag.flag);
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_CROSS_CAST:
@@ -1555,7 +1578,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             ObjectList* targets = GetTargets(e, unit);
             if (!targets)
             {
-                delete casters; // casters already validated, delete now
+                FreeTargetList(casters); // casters already validated, free now
                 return;
             }
 
@@ -1572,8 +1595,8 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
-            delete casters;
+            FreeTargetList(targets);
+            FreeTargetList(casters);
             break;
         }
         case SMART_ACTION_CALL_RANDOM_TIMED_ACTIONLIST:
@@ -1620,7 +1643,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                FreeTargetList(targets);
             }
             break;
         }
@@ -1650,7 +1673,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                FreeTargetList(targets);
             }
             break;
         }
@@ -1664,7 +1687,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsPlayer(*itr))
                     (*itr)->ToPlayer()->ActivateTaxiPathTo(e.action.taxi.id);
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_RANDOM_MOVE:
@@ -1684,7 +1707,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_UNIT_FIELD_BYTES_1:
@@ -1696,7 +1719,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->SetByteFlag(UNIT_FIELD_BYTES_1, 0, e.action.setunitByte.byte1);
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_REMOVE_UNIT_FIELD_BYTES_1:
@@ -1709,7 +1732,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->RemoveByteFlag(UNIT_FIELD_BYTES_1, 0, e.action.delunitByte.byte1);
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_INTERRUPT_SPELL:
@@ -1722,7 +1745,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->InterruptNonMeleeSpells(e.action.interruptSpellCasting.withDelayed, e.action.interruptSpellCasting.spell_id, e.action.interruptSpellCasting.withInstant);
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_SEND_GO_CUSTOM_ANIM:
@@ -1735,7 +1758,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsGameObject(*itr))
                     (*itr)->ToGameObject()->SendCustomAnim(e.action.sendGoCustomAnim.anim);
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_DYNAMIC_FLAG:
@@ -1748,7 +1771,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->SetUInt32Value(UNIT_DYNAMIC_FLAGS, e.action.unitFlag.flag);
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_ADD_DYNAMIC_FLAG:
@@ -1761,7 +1784,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->SetFlag(UNIT_DYNAMIC_FLAGS, e.action.unitFlag.flag);
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_REMOVE_DYNAMIC_FLAG:
@@ -1774,7 +1797,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->RemoveFlag(UNIT_DYNAMIC_FLAGS, e.action.unitFlag.flag);
 
-            delete targets;
+            FreeTargetList(targets);
             break;
         }
         case SMART_ACTION_JUMP_TO_POS:
@@ -1902,7 +1925,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
     else if (Unit* tempLastInvoker = GetLastInvoker())
         trigger = tempLastInvoker;
 
-    ObjectList* l = new ObjectList();
+    ObjectList* l = AllocTargetList();
     switch (e.GetTargetType())
     {
         case SMART_TARGET_SELF:
@@ -1969,7 +1992,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                     l->push_back(*itr);
             }
 
-            delete units;
+            FreeTargetList(units);
             break;
         }
         case SMART_TARGET_CREATURE_DISTANCE:
@@ -1988,7 +2011,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                     l->push_back(*itr);
             }
 
-            delete units;
+            FreeTargetList(units);
             break;
         }
         case SMART_TARGET_GAMEOBJECT_DISTANCE:
@@ -2007,7 +2030,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                     l->push_back(*itr);
             }
 
-            delete units;
+            FreeTargetList(units);
             break;
         }
         case SMART_TARGET_GAMEOBJECT_RANGE:
@@ -2026,7 +2049,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                     l->push_back(*itr);
             }
 
-            delete units;
+            FreeTargetList(units);
             break;
         }
         case SMART_TARGET_CREATURE_GUID:
@@ -2084,7 +2107,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                     if (IsPlayer(*itr) && GetBaseObject()->IsInRange(*itr, (float)e.target.playerRange.minDist, (float)e.target.playerRange.maxDist))
                         l->push_back(*itr);
 
-            delete units;
+            FreeTargetList(units);
             break;
         }
         case SMART_TARGET_PLAYER_DISTANCE:
@@ -2095,7 +2118,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                 if (IsPlayer(*itr))
                     l->push_back(*itr);
 
-            delete units;
+            FreeTargetList(units);
             break;
         }
         case SMART_TARGET_STORED:
@@ -2145,7 +2168,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
 
     if (l->empty())
     {
-        delete l;
+        FreeTargetList(l);
         l = NULL;
     }
 
@@ -2154,17 +2177,37 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
 
 ObjectList* SmartScript::GetWorldObjectsInDist(float dist)
 {
-    ObjectList* targets = new ObjectList();
+    ObjectList* targets = AllocTargetList();
     WorldObject* obj = GetBaseObject();
     if (obj)
     {
         Trinity::AllWorldObjectsInRange u_check(obj, dist);
-        Trinity::WorldObjectListSearcher<Trinity::AllWorldObjectsInRange> searcher(obj, *targets, u_check);
+        Trinity::WorldObjectListSearcher<Trinity::AllWorldObjectsInRange, ObjectList> searcher(obj, *targets, u_check);
         obj->VisitNearbyObject(dist, searcher);
     }
     return targets;
 }
 
+ObjectList* SmartScript::AllocTargetList()
+{
+    if (mFreeTargetLists.empty())
+        return new ObjectList();
+
+    ObjectList* targets = mFreeTargetLists.back();
+    mFreeTargetLists.pop_back();
+    return targets;
+}
+
+void SmartScript::FreeTargetList(ObjectList* targets)
+{
+    if (!targets)
+        return;
+
+    // cleared but not shrunk, the next search fills it again without allocating
+    targets->clear();
+    mFreeTargetLists.push_back(targets);
+}
+
 void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
 {
     if (!e.active && e.GetEventType() != SMART_EVENT_LINK)
@@ -2660,6 +2703,7 @@ void SmartScript::InstallEvents()
             mEvents.push_back(*i);//must be before UpdateTimers
 
         mInstallEvents.clear();
+        BuildEventTypeIndex();
     }
 }
 
@@ -2744,6 +2788,7 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEn
         }
         mEvents.push_back((*i));//NOTE: 'world(0)' events still get processed in ANY instance mode
     }
+    BuildEventTypeIndex();
     if (mEvents.empty() && obj)
         sLog->outErrorDb("SmartScript: Entry %u has events but no events added to list because of instance flags.", obj->GetEntry());
     if (mEvents.empty() && at)
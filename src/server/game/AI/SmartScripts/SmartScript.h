@@ -49,6 +49,9 @@ class SmartScript
         void ProcessAction(SmartScriptHolder& e, Unit* unit = NULL, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, const SpellInfo* spell = NULL, GameObject* gob = NULL);
         ObjectList* GetTargets(SmartScriptHolder const& e, Unit* invoker = NULL);
         ObjectList* GetWorldObjectsInDist(float dist);
+        // target lists are kept for reuse, give back every list GetTargets returned
+        ObjectList* AllocTargetList();
+        void FreeTargetList(ObjectList* targets);
         void InstallTemplate(SmartScriptHolder const& e);
         SmartScriptHolder CreateEvent(SMART_EVENT e, uint32 event_flags, uint32 event_param1, uint32 event_param2, uint32 event_param3, uint32 event_param4, SMART_ACTION action, uint32 action_param1, uint32 action_param2, uint32 action_param3, uint32 action_param4, uint32 action_param5, uint32 action_param6, SMARTAI_TARGETS t, uint32 target_param1, uint32 target_param2, uint32 target_param3, uint32 phaseMask = 0);
         void AddEvent(SMART_EVENT e, uint32 event_flags, uint32 event_param1, uint32 event_param2, uint32 event_param3, uint32 event_param4, SMART_ACTION action, uint32 action_param1, uint32 action_param2, uint32 action_param3, uint32 action_param4, uint32 action_param5, uint32 action_param6, SMARTAI_TARGETS t, uint32 target_param1, uint32 target_param2, uint32 target_param3, uint32 phaseMask = 0);
@@ -109,7 +112,7 @@ class SmartScript
                 return;
 
             if (mTargetStorage->find(id) != mTargetStorage->end())
-                delete (*mTargetStorage)[id];
+                FreeTargetList((*mTargetStorage)[id]);
 
             (*mTargetStorage)[id] = targets;
         }
@@ -228,7 +231,11 @@ class SmartScript
         void SetPhase(uint32 p = 0) { mEventPhase = p; }
 
         SmartAIEventList mEvents;
+        // indexes into mEvents grouped by event type, the ones of type t are [mEventTypeOffsets[t], mEventTypeOffsets[t + 1])
+        std::vector<uint16> mEventsByType;
+        uint16 mEventTypeOffsets[SMART_EVENT_END + 1];
         SmartAIEventList mInstallEvents;
+        std::vector<ObjectList*> mFreeTargetLists;
         SmartAIEventList mTimedActionList;
         bool mResumeActionList;
         Creature* me;
@@ -253,6 +260,7 @@ class SmartScript
 
         SMARTAI_TEMPLATE mTemplate;
         void InstallEvents();
+        void BuildEventTypeIndex();
 
         void RemoveStoredEvent (uint32 id)
         {
@@ -1180,7 +1180,7 @@ struct SmartScriptHolder
 
 typedef UNORDERED_MAP<uint32, WayPoint*> WPPath;
 
-typedef std::list<WorldObject*> ObjectList;
+typedef std::vector<WorldObject*> ObjectList;
 typedef UNORDERED_MAP<uint32, ObjectList*> ObjectListMap;
 
 class SmartWaypointMgr
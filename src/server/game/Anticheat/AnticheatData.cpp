@@ -17,9 +17,16 @@ void AnticheatData::Reset()
     memset(&_tempReportsTimer, 0, sizeof(_tempReportsTimer[0]) * MAX_REPORT_TYPES);
 }
 
-void  AnticheatData::SaveToDB(const char* tableName, uint32 guidLow)
+void AnticheatData::SaveToDB(const char* tableName, uint32 guidLow)
 {
-    CharacterDatabase.PExecute("REPLACE INTO %s(guid,average,total_reports,speed_reports,fly_reports,jump_reports,waterwalk_reports,teleportplane_reports,climb_reports,creation_time) VALUES (%u,%f,%u,%u,%u,%u,%u,%u,%u,%u)",
+    SQLTransaction trans = CharacterDatabase.BeginTransaction();
+    SaveToDB(tableName, guidLow, trans);
+    CharacterDatabase.CommitTransaction(trans);
+}
+
+void AnticheatData::SaveToDB(const char* tableName, uint32 guidLow, SQLTransaction& trans)
+{
+    trans->PAppend("REPLACE INTO %s(guid,average,total_reports,speed_reports,fly_reports,jump_reports,waterwalk_reports,teleportplane_reports,climb_reports,creation_time) VALUES (%u,%f,%u,%u,%u,%u,%u,%u,%u,%u)",
                                tableName, guidLow,
                                _average, _totalReports, 
                                _typeReports[SPEED_HACK_REPORT],
@@ -64,7 +71,7 @@ const MovementInfo& AnticheatData::GetLastMovementInfo() const
     return _lastMovementInfo;
 }
 
-void AnticheatData::SetLastMovementInfo(MovementInfo& moveInfo)
+void AnticheatData::SetLastMovementInfo(MovementInfo const& moveInfo)
 {
     _lastMovementInfo = moveInfo;
 }
@@ -11,12 +11,13 @@ public:
 
     void Reset();
     void SaveToDB(const char* tableName, uint32 guidLow);
+    void SaveToDB(const char* tableName, uint32 guidLow, SQLTransaction& trans);
 
     void SetLastOpcode(uint32 opcode);
     uint32 GetLastOpcode() const;
 
     const MovementInfo& GetLastMovementInfo() const;
-    void SetLastMovementInfo(MovementInfo& moveInfo);
+    void SetLastMovementInfo(MovementInfo const& moveInfo);
 
     void SetPosition(float x, float y, float z, float o);
 
@@ -54,4 +55,16 @@ private:
     bool            _hasDailyReport;
 };
 
+// Report made on a map thread, logged and saved on the world thread by AnticheatMgr::Update
+struct AnticheatReport
+{
+    uint32          guidLow;
+    uint32          accountId;
+    std::string     playerName;
+    ReportTypes     type;
+    bool            notify;             ///< Tell the online game masters
+    bool            saveDaily;          ///< First report over the daily threshold
+    AnticheatData   data;               ///< Player data when reported
+};
+
 #endif
@@ -46,26 +46,23 @@ AnticheatMgr::AnticheatMgr()
 
 AnticheatMgr::~AnticheatMgr()
 {
-    _data.clear();
 }
 
-void AnticheatMgr::JumpHackDetection(Player* player, MovementInfo movementInfo,uint32 opcode)
+void AnticheatMgr::JumpHackDetection(Player* player, AnticheatData& data, MovementInfo const& /*movementInfo*/, uint32 opcode)
 {
     if ((sWorld->getIntConfig(CONFIG_ANTICHEAT_DETECTIONS_ENABLED) & JUMP_HACK_DETECTION) == 0)
         return;
 
-    uint32 key = player->GetGUIDLow();
-    if (_data[key].GetLastOpcode() == MSG_MOVE_JUMP && opcode == MSG_MOVE_JUMP)
-        BuildReport(player, JUMP_HACK_REPORT);
+    if (data.GetLastOpcode() == MSG_MOVE_JUMP && opcode == MSG_MOVE_JUMP)
+        BuildReport(player, data, JUMP_HACK_REPORT);
 }
 
-void AnticheatMgr::WalkOnWaterHackDetection(Player* player, MovementInfo movementInfo)
+void AnticheatMgr::WalkOnWaterHackDetection(Player* player, AnticheatData& data, MovementInfo const& /*movementInfo*/)
 {
     if ((sWorld->getIntConfig(CONFIG_ANTICHEAT_DETECTIONS_ENABLED) & WALK_WATER_HACK_DETECTION) == 0)
         return;
 
-    uint32 key = player->GetGUIDLow();
-    if (!_data[key].GetLastMovementInfo().HasMovementFlag(MOVEMENTFLAG_WATERWALKING))
+    if (!data.GetLastMovementInfo().HasMovementFlag(MOVEMENTFLAG_WATERWALKING))
         return;
 
     // if we are a ghost we can walk on water
@@ -77,16 +74,15 @@ void AnticheatMgr::WalkOnWaterHackDetection(Player* player, MovementInfo movemen
         player->HasAuraType(SPELL_AURA_WATER_WALK))
         return;
 
-    BuildReport(player, WALK_WATER_HACK_REPORT);
+    BuildReport(player, data, WALK_WATER_HACK_REPORT);
 }
 
-void AnticheatMgr::FlyHackDetection(Player* player, MovementInfo movementInfo)
+void AnticheatMgr::FlyHackDetection(Player* player, AnticheatData& data, MovementInfo const& /*movementInfo*/)
 {
     if ((sWorld->getIntConfig(CONFIG_ANTICHEAT_DETECTIONS_ENABLED) & FLY_HACK_DETECTION) == 0)
         return;
 
-    uint32 key = player->GetGUIDLow();
-    if (!_data[key].GetLastMovementInfo().HasMovementFlag(MOVEMENTFLAG_FLYING))
+    if (!data.GetLastMovementInfo().HasMovementFlag(MOVEMENTFLAG_FLYING))
         return;
 
     if (player->HasAuraType(SPELL_AURA_FLY) ||
@@ -94,16 +90,15 @@ void AnticheatMgr::FlyHackDetection(Player* player, MovementInfo movementInfo)
         player->HasAuraType(SPELL_AURA_MOD_INCREASE_FLIGHT_SPEED))
         return;
 
-    BuildReport(player, FLY_HACK_REPORT);
+    BuildReport(player, data, FLY_HACK_REPORT);
 }
 
-void AnticheatMgr::TeleportPlaneHackDetection(Player* player, MovementInfo movementInfo)
+void AnticheatMgr::TeleportPlaneHackDetection(Player* player, AnticheatData& data, MovementInfo const& movementInfo)
 {
     if ((sWorld->getIntConfig(CONFIG_ANTICHEAT_DETECTIONS_ENABLED) & TELEPORT_PLANE_HACK_DETECTION) == 0)
         return;
 
-    uint32 key = player->GetGUIDLow();
-    if (_data[key].GetLastMovementInfo().pos.GetPositionZ() != 0 ||
+    if (data.GetLastMovementInfo().pos.GetPositionZ() != 0 ||
         movementInfo.pos.GetPositionZ() != 0)
         return;
 
@@ -120,18 +115,17 @@ void AnticheatMgr::TeleportPlaneHackDetection(Player* player, MovementInfo movem
 
     // we are not really walking there
     if (z_diff > 1.0f)
-        BuildReport(player, TELEPORT_PLANE_HACK_REPORT);
+        BuildReport(player, data, TELEPORT_PLANE_HACK_REPORT);
 }
 
 // basic detection
-void AnticheatMgr::ClimbHackDetection(Player* player, MovementInfo movementInfo, uint32 opcode)
+void AnticheatMgr::ClimbHackDetection(Player* player, AnticheatData& data, MovementInfo const& movementInfo, uint32 opcode)
 {
     if ((sWorld->getIntConfig(CONFIG_ANTICHEAT_DETECTIONS_ENABLED) & CLIMB_HACK_DETECTION) == 0)
         return;
 
-    uint32 key = player->GetGUIDLow();
     if (opcode != MSG_MOVE_HEARTBEAT ||
-        _data[key].GetLastOpcode() != MSG_MOVE_HEARTBEAT)
+        data.GetLastOpcode() != MSG_MOVE_HEARTBEAT)
         return;
 
     // in this case we don't care if they are "legal" flags, they are handled in another parts of the Anticheat Manager.
@@ -147,22 +141,21 @@ void AnticheatMgr::ClimbHackDetection(Player* player, MovementInfo movementInfo,
     float deltaXY = movementInfo.pos.GetExactDist2d(&playerPos);
     float angle = MapManager::NormalizeOrientation(tan(deltaZ / deltaXY));
     if (angle > CLIMB_ANGLE)
-        BuildReport(player, CLIMB_HACK_REPORT);
+        BuildReport(player, data, CLIMB_HACK_REPORT);
 }
 
-void AnticheatMgr::SpeedHackDetection(Player* player,MovementInfo movementInfo)
+void AnticheatMgr::SpeedHackDetection(Player* player, AnticheatData& data, MovementInfo const& movementInfo)
 {
     if ((sWorld->getIntConfig(CONFIG_ANTICHEAT_DETECTIONS_ENABLED) & SPEED_HACK_DETECTION) == 0)
         return;
 
-    uint32 key = player->GetGUIDLow();
     // We also must check the map because the movementFlag can be modified by the client.
     // If we just check the flag, they could always add that flag and always skip the speed hacking detection.
     // 369 == DEEPRUN TRAM
-    if (_data[key].GetLastMovementInfo().HasMovementFlag(MOVEMENTFLAG_ONTRANSPORT) && player->GetMapId() == 369)
+    if (data.GetLastMovementInfo().HasMovementFlag(MOVEMENTFLAG_ONTRANSPORT) && player->GetMapId() == 369)
         return;
 
-    uint32 distance2D = uint32(movementInfo.pos.GetExactDist2d(&_data[key].GetLastMovementInfo().pos));
+    uint32 distance2D = uint32(movementInfo.pos.GetExactDist2d(&data.GetLastMovementInfo().pos));
     uint8 moveType = 0;
     // we need to know HOW is the player moving
     // TO-DO: Should we check the incoming movement flags?
@@ -179,7 +172,7 @@ void AnticheatMgr::SpeedHackDetection(Player* player,MovementInfo movementInfo)
     uint32 speedRate = uint32(player->GetSpeed(UnitMoveType(moveType)) + movementInfo.j_xyspeed);
     
     // how long the player took to move to here.
-    uint32 timeDiff = getMSTimeDiff(_data[key].GetLastMovementInfo().time, movementInfo.time);
+    uint32 timeDiff = getMSTimeDiff(data.GetLastMovementInfo().time, movementInfo.time);
     if (!timeDiff)
         timeDiff = 1;
 
@@ -188,10 +181,10 @@ void AnticheatMgr::SpeedHackDetection(Player* player,MovementInfo movementInfo)
 
     // we did the (uint32) cast to accept a margin of tolerance
     if (clientSpeedRate > speedRate)
-        BuildReport(player, SPEED_HACK_REPORT);
+        BuildReport(player, data, SPEED_HACK_REPORT);
 }
 
-void AnticheatMgr::StartHackDetection(Player* player, MovementInfo movementInfo, uint32 opcode)
+void AnticheatMgr::StartHackDetection(Player* player, MovementInfo const& movementInfo, uint32 opcode)
 {
     if (!sWorld->getBoolConfig(CONFIG_ANTICHEAT_ENABLE))
         return;
@@ -199,18 +192,22 @@ void AnticheatMgr::StartHackDetection(Player* player, MovementInfo movementInfo,
     if (player->isGameMaster())
         return;
 
+    uint32 key = player->GetGUIDLow();
+    DataShard& shard = GetShard(key);
+    ACE_GUARD(ACE_Thread_Mutex, Guard, shard.lock);
+
+    AnticheatData& data = shard.data[key];
     if (!player->isInFlight() && !player->GetTransport() && !player->GetVehicle())
     {
-        SpeedHackDetection(player, movementInfo);
-        FlyHackDetection(player, movementInfo);
-        WalkOnWaterHackDetection(player, movementInfo);
-        JumpHackDetection(player, movementInfo, opcode);
-        TeleportPlaneHackDetection(player, movementInfo);
-        ClimbHackDetection(player, movementInfo, opcode);
+        SpeedHackDetection(player, data, movementInfo);
+        FlyHackDetection(player, data, movementInfo);
+        WalkOnWaterHackDetection(player, data, movementInfo);
+        JumpHackDetection(player, data, movementInfo, opcode);
+        TeleportPlaneHackDetection(player, data, movementInfo);
+        ClimbHackDetection(player, data, movementInfo, opcode);
     }
-    uint32 key = player->GetGUIDLow();
-    _data[key].SetLastMovementInfo(movementInfo);
-    _data[key].SetLastOpcode(opcode);
+    data.SetLastMovementInfo(movementInfo);
+    data.SetLastOpcode(opcode);
 }
 
 void AnticheatMgr::StartScripts()
@@ -223,10 +220,15 @@ void AnticheatMgr::HandlePlayerLogin(Player* player)
     uint32 guidLow = player->GetGUIDLow();
     // we must delete this to prevent errors in case of crash
     CharacterDatabase.PExecute("DELETE FROM players_reports_status WHERE guid = %u", guidLow);
+    QueryResult result = CharacterDatabase.PQuery("SELECT * FROM daily_players_reports WHERE guid = %u", guidLow);
+
+    DataShard& shard = GetShard(guidLow);
+    ACE_GUARD(ACE_Thread_Mutex, Guard, shard.lock);
+
     // we initialize the pos of lastMovementPosition var.
-    _data[guidLow].SetPosition(player->GetPositionX(), player->GetPositionY(), player->GetPositionZ(), player->GetOrientation());
-    if (QueryResult result = CharacterDatabase.PQuery("SELECT * FROM daily_players_reports WHERE guid = %u", guidLow))
-        _data[guidLow].SetDailyReportState(true);
+    shard.data[guidLow].SetPosition(player->GetPositionX(), player->GetPositionY(), player->GetPositionZ(), player->GetOrientation());
+    if (result)
+        shard.data[guidLow].SetDailyReportState(true);
 }
 
 void AnticheatMgr::HandlePlayerLogout(Player* player)
@@ -235,28 +237,38 @@ void AnticheatMgr::HandlePlayerLogout(Player* player)
     // We must also delete it at logout to prevent have data of offline players in the db when we query the database (IE: The GM Command)
     CharacterDatabase.PExecute("DELETE FROM players_reports_status WHERE guid = %u", player->GetGUIDLow());
     // Delete not needed data from the memory.
-    _data.erase(player->GetGUIDLow());
+    DataShard& shard = GetShard(player->GetGUIDLow());
+    ACE_GUARD(ACE_Thread_Mutex, Guard, shard.lock);
+    shard.data.erase(player->GetGUIDLow());
 }
 
-void AnticheatMgr::SavePlayerData(Player* player)
+void AnticheatMgr::SavePlayerData(Player* player, SQLTransaction& trans)
 {
     uint32 guidLow = player->GetGUIDLow();
-    _data[guidLow].SaveToDB("players_reports_status", guidLow);
+    DataShard& shard = GetShard(guidLow);
+    ACE_GUARD(ACE_Thread_Mutex, Guard, shard.lock);
+    shard.data[guidLow].SaveToDB("players_reports_status", guidLow, trans);
 }
 
 uint32 AnticheatMgr::GetTotalReports(uint32 guidLow)
 {
-    return _data[guidLow].GetTotalReports();
+    DataShard& shard = GetShard(guidLow);
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, Guard, shard.lock, 0);
+    return shard.data[guidLow].GetTotalReports();
 }
 
 float AnticheatMgr::GetAverage(uint32 guidLow)
 {
-    return _data[guidLow].GetAverage();
+    DataShard& shard = GetShard(guidLow);
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, Guard, shard.lock, 0.0f);
+    return shard.data[guidLow].GetAverage();
 }
 
 uint32 AnticheatMgr::GetTypeReports(uint32 guidLow, uint8 type)
 {
-    return _data[guidLow].GetTypeReports(type);
+    DataShard& shard = GetShard(guidLow);
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, Guard, shard.lock, 0);
+    return shard.data[guidLow].GetTypeReports(type);
 }
 
 bool AnticheatMgr::MustCheckTempReports(uint8 type)
@@ -267,12 +279,9 @@ bool AnticheatMgr::MustCheckTempReports(uint8 type)
     return true;
 }
 
-void AnticheatMgr::BuildReport(Player* player, ReportTypes reportType)
+void AnticheatMgr::BuildReport(Player* player, AnticheatData& data, ReportTypes reportType)
 {
     uint32 actualTime = getMSTime();
-
-    uint32 key = player->GetGUIDLow();
-    AnticheatData& data = _data[key];
     if (MustCheckTempReports(reportType))
     {
         if (!data.GetTempReportsTimer(reportType))
@@ -310,31 +319,71 @@ void AnticheatMgr::BuildReport(Player* player, ReportTypes reportType)
         data.SetAverage(average);
     }
 
+    // logged and saved by Update, we are on a map thread
+    AnticheatReport report;
+    report.guidLow = player->GetGUIDLow();
+    report.accountId = player->GetSession()->GetAccountId();
+    report.playerName = player->GetName();
+    report.type = reportType;
+    report.saveDaily = false;
+    report.notify = data.GetTotalReports() > sWorld->getIntConfig(CONFIG_ANTICHEAT_REPORTS_INGAME_NOTIFICATION);
+
     if (data.GetTotalReports() > sWorld->getIntConfig(CONFIG_ANTICHEAT_MAX_REPORTS_FOR_DAILY_REPORT))
     {
         if (!data.GetDailyReportState())
         {
-            data.SaveToDB("daily_players_reports", key);
+            report.saveDaily = true;
             data.SetDailyReportState(true);
         }
     }
 
-    if (data.GetTotalReports() > sWorld->getIntConfig(CONFIG_ANTICHEAT_REPORTS_INGAME_NOTIFICATION))
+    report.data = data;
+
+    ACE_GUARD(ACE_Thread_Mutex, Guard, _reportsLock);
+    _reports.push_back(report);
+}
+
+void AnticheatMgr::Update()
+{
+    AnticheatReportList reports;
     {
-        std::ostringstream ss;
-        ss << "|cFFFFFC00[AC]|cFF00FFFF[|cFF60FF00";
-        ss << player->GetName();
-        ss << "|cFF00FFFF] Possible cheater: ";
-        ss << CheatTypeToString(reportType);
-
-        // Display warning at the center of the screen
-        std::string str = ss.str();
-        WorldPacket data(SMSG_NOTIFICATION, (str.size() + 1));
-        data << str;
-        sWorld->SendGlobalGMMessage(&data);
+        ACE_GUARD(ACE_Thread_Mutex, Guard, _reportsLock);
+        if (_reports.empty())
+            return;
+
+        reports.swap(_reports);
     }
-    // Write information to log file
-    sLogMgr->WriteLn(LOG_NAME, "[%u] %s (account: %u): %s", player->GetGUIDLow(), player->GetName(), player->GetSession()->GetAccountId(), CheatTypeToString(reportType));
+
+    SQLTransaction trans = CharacterDatabase.BeginTransaction();
+    bool save = false;
+    for (AnticheatReportList::iterator itr = reports.begin(); itr != reports.end(); ++itr)
+    {
+        if (itr->saveDaily)
+        {
+            itr->data.SaveToDB("daily_players_reports", itr->guidLow, trans);
+            save = true;
+        }
+
+        if (itr->notify)
+        {
+            std::ostringstream ss;
+            ss << "|cFFFFFC00[AC]|cFF00FFFF[|cFF60FF00";
+            ss << itr->playerName;
+            ss << "|cFF00FFFF] Possible cheater: ";
+            ss << CheatTypeToString(itr->type);
+
+            // Display warning at the center of the screen
+            std::string str = ss.str();
+            WorldPacket data(SMSG_NOTIFICATION, (str.size() + 1));
+            data << str;
+            sWorld->SendGlobalGMMessage(&data);
+        }
+        // Write information to log file
+        sLogMgr->WriteLn(LOG_NAME, "[%u] %s (account: %u): %s", itr->guidLow, itr->playerName.c_str(), itr->accountId, CheatTypeToString(itr->type));
+    }
+
+    if (save)
+        CharacterDatabase.CommitTransaction(trans);
 }
 
 void AnticheatMgr::AnticheatGlobalCommand(ChatHandler* handler)
@@ -389,19 +438,31 @@ void AnticheatMgr::AnticheatDeleteCommand(uint32 guid)
 {
     if (!guid)
     {
-        for (AnticheatPlayersDataMap::iterator itr = _data.begin(); itr != _data.end(); ++itr)
-            itr->second.Reset();
+        for (uint32 i = 0; i < ANTICHEAT_DATA_SHARDS; ++i)
+        {
+            ACE_GUARD(ACE_Thread_Mutex, Guard, _shards[i].lock);
+            for (AnticheatPlayersDataMap::iterator itr = _shards[i].data.begin(); itr != _shards[i].data.end(); ++itr)
+                itr->second.Reset();
+        }
         CharacterDatabase.Execute("DELETE FROM players_reports_status");
     }
     else
     {
-        _data[guid].Reset();
+        {
+            DataShard& shard = GetShard(guid);
+            ACE_GUARD(ACE_Thread_Mutex, Guard, shard.lock);
+            shard.data[guid].Reset();
+        }
         CharacterDatabase.PExecute("DELETE FROM players_reports_status WHERE guid = %u", guid);
     }
 }
 
 void AnticheatMgr::ResetDailyReportStates()
 {
-     for (AnticheatPlayersDataMap::iterator itr = _data.begin(); itr != _data.end(); ++itr)
-         _data[itr->first].SetDailyReportState(false);
+    for (uint32 i = 0; i < ANTICHEAT_DATA_SHARDS; ++i)
+    {
+        ACE_GUARD(ACE_Thread_Mutex, Guard, _shards[i].lock);
+        for (AnticheatPlayersDataMap::iterator itr = _shards[i].data.begin(); itr != _shards[i].data.end(); ++itr)
+            itr->second.SetDailyReportState(false);
+    }
 }
@@ -22,6 +22,8 @@
 #include "SharedDefines.h"
 #include "Chat.h"
 
+#include <ace/Thread_Mutex.h>
+
 enum ReportTypes
 {
     SPEED_HACK_REPORT = 0,
@@ -47,8 +49,14 @@ enum DetectionTypes
 class Player;
 class AnticheatData;
 
+struct AnticheatReport;
+
 // GUIDLow is the key.
 typedef std::map<uint32, AnticheatData> AnticheatPlayersDataMap;
+typedef std::vector<AnticheatReport> AnticheatReportList;
+
+// Players are spread over the shards by GUIDLow, each with its own lock
+#define ANTICHEAT_DATA_SHARDS 16
 
 class AnticheatMgr
 {
@@ -57,11 +65,14 @@ class AnticheatMgr
     ~AnticheatMgr();
 
 public:
-    void StartHackDetection(Player* player, MovementInfo movementInfo, uint32 opcode);
+    void StartHackDetection(Player* player, MovementInfo const& movementInfo, uint32 opcode);
     void DeletePlayerReport(Player* player, bool login);
     void DeletePlayerData(Player* player);
     void CreatePlayerData(Player* player);
-    void SavePlayerData(Player* player);
+    void SavePlayerData(Player* player, SQLTransaction& trans);
+
+    // Logs and saves the reports made since the last call, on the world thread
+    void Update();
 
     void StartScripts();
 
@@ -78,18 +89,28 @@ public:
     void ResetDailyReportStates();
 
 private:
-    void SpeedHackDetection(Player* player, MovementInfo movementInfo);
-    void FlyHackDetection(Player* player, MovementInfo movementInfo);
-    void WalkOnWaterHackDetection(Player* player, MovementInfo movementInfo);
-    void JumpHackDetection(Player* player, MovementInfo movementInfo, uint32 opcode);
-    void TeleportPlaneHackDetection(Player* player, MovementInfo movementInfo);
-    void ClimbHackDetection(Player* player, MovementInfo movementInfo, uint32 opcode);
+    struct DataShard
+    {
+        ACE_Thread_Mutex lock;
+        AnticheatPlayersDataMap data;
+    };
+
+    DataShard& GetShard(uint32 guidLow) { return _shards[guidLow % ANTICHEAT_DATA_SHARDS]; }
+
+    void SpeedHackDetection(Player* player, AnticheatData& data, MovementInfo const& movementInfo);
+    void FlyHackDetection(Player* player, AnticheatData& data, MovementInfo const& movementInfo);
+    void WalkOnWaterHackDetection(Player* player, AnticheatData& data, MovementInfo const& movementInfo);
+    void JumpHackDetection(Player* player, AnticheatData& data, MovementInfo const& movementInfo, uint32 opcode);
+    void TeleportPlaneHackDetection(Player* player, AnticheatData& data, MovementInfo const& movementInfo);
+    void ClimbHackDetection(Player* player, AnticheatData& data, MovementInfo const& movementInfo, uint32 opcode);
 
-    void BuildReport(Player* player, ReportTypes reportType);
+    void BuildReport(Player* player, AnticheatData& data, ReportTypes reportType);
 
     bool MustCheckTempReports(uint8 type);
 
-    AnticheatPlayersDataMap _data;                        ///< Player data
+    DataShard _shards[ANTICHEAT_DATA_SHARDS];             ///< Player data, movement is handled on the map threads
+    ACE_Thread_Mutex _reportsLock;
+    AnticheatReportList _reports;                         ///< Reports not logged yet
 };
 
 #define sAnticheatMgr ACE_Singleton<AnticheatMgr, ACE_Null_Mutex>::instance()
@@ -390,6 +390,13 @@ void AuctionHouseMgr::LoadAuctions()
     sLog->outString();
 }
 
+void AuctionHouseMgr::ResetSearchNames()
+{
+    mHordeAuctions.ResetSearchNames();
+    mAllianceAuctions.ResetSearchNames();
+    mNeutralAuctions.ResetSearchNames();
+}
+
 void AuctionHouseMgr::AddAItem(Item* it)
 {
     ASSERT(it);
@@ -459,12 +466,19 @@ void AuctionHouseObject::AddAuction(AuctionEntry *auction)
     ASSERT(auction);
 
     AuctionsMap[auction->Id] = auction;
+
+    if (Item* item = sAuctionMgr->GetAItem(auction->item_guidlow))
+        SearchIndex.AddAuction(auction, item);
+
+    ExpiryQueue.push(AuctionExpiry(auction->expire_time, auction->Id));
+
     sScriptMgr->OnAuctionAdd(this, auction);
 }
 
 bool AuctionHouseObject::RemoveAuction(AuctionEntry *auction, uint32 /*item_template*/)
 {
     bool wasInMap = AuctionsMap.erase(auction->Id) ? true : false;
+    SearchIndex.RemoveAuction(auction->Id);
 
     sScriptMgr->OnAuctionRemove(this, auction);
 
@@ -478,25 +492,21 @@ void AuctionHouseObject::Update()
     time_t curTime = sWorld->GetGameTime();
     ///- Handle expired auctions
 
-    // If storage is empty, no need to update. next == NULL in this case.
-    if (AuctionsMap.empty())
+    // auctions ending within the next minute are settled now, the next update is a minute away
+    if (ExpiryQueue.empty() || ExpiryQueue.top().first > curTime + 60)
         return;
 
-    QueryResult result = CharacterDatabase.PQuery("SELECT id FROM auctionhouse WHERE time <= %u ORDER BY TIME ASC", (uint32)curTime+60);
-
-    if (!result)
-        return;
+    SQLTransaction trans = CharacterDatabase.BeginTransaction();
 
-    do
+    while (!ExpiryQueue.empty() && ExpiryQueue.top().first <= curTime + 60)
     {
-        // from auctionhousehandler.cpp, creates auction pointer & player pointer
-        AuctionEntry* auction = GetAuction(result->Fetch()->GetUInt32());
+        AuctionEntry* auction = GetAuction(ExpiryQueue.top().second);
+        ExpiryQueue.pop();
 
+        // already bought out or cancelled
         if (!auction)
             continue;
 
-        SQLTransaction trans = CharacterDatabase.BeginTransaction();
-
         ///- Either cancel the auction if there was no bidder
         if (auction->bidder == 0)
         {
@@ -515,15 +525,17 @@ void AuctionHouseObject::Update()
         }
 
         uint32 item_template = auction->item_template;
+        uint32 item_guidlow = auction->item_guidlow;
 
         ///- In any case clear the auction
         auction->DeleteFromDB(trans);
-        CharacterDatabase.CommitTransaction(trans);
 
         RemoveAuction(auction, item_template);
-        sAuctionMgr->RemoveAItem(auction->item_guidlow);
+        sAuctionMgr->RemoveAItem(item_guidlow);
     }
-    while (result->NextRow());
+
+    // all auctions settled by this update are written with one asynchronous transaction
+    CharacterDatabase.CommitTransaction(trans);
 }
 
 void AuctionHouseObject::BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount)
@@ -561,79 +573,33 @@ void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player
     uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
     uint32& count, uint32& totalcount)
 {
-    int loc_idx = player->GetSession()->GetSessionDbLocaleIndex();
-    int locdbc_idx = player->GetSession()->GetSessionDbcLocale();
-
-    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+    AuctionSearchIndex::Query query;
+    query.name = wsearchedname;
+    query.locale = player->GetSession()->GetSessionDbLocaleIndex();
+    query.itemClass = itemClass;
+    query.itemSubClass = itemSubClass;
+    query.inventoryType = inventoryType;
+    query.quality = quality;
+    query.levelMin = levelmin;
+    query.levelMax = levelmax;
+
+    std::vector<uint32> auctionIds;
+    SearchIndex.Search(query, auctionIds);
+
+    for (std::vector<uint32>::const_iterator itr = auctionIds.begin(); itr != auctionIds.end(); ++itr)
     {
-        AuctionEntry *Aentry = itr->second;
-        Item *item = sAuctionMgr->GetAItem(Aentry->item_guidlow);
-        if (!item)
-            continue;
-
-        ItemTemplate const *proto = item->GetTemplate();
-
-        if (itemClass != 0xffffffff && proto->Class != itemClass)
-            continue;
-
-        if (itemSubClass != 0xffffffff && proto->SubClass != itemSubClass)
-            continue;
-
-        if (inventoryType != 0xffffffff && proto->InventoryType != inventoryType)
-            continue;
-
-        if (quality != 0xffffffff && proto->Quality != quality)
+        AuctionEntry *Aentry = GetAuction(*itr);
+        if (!Aentry)
             continue;
 
-        if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
-            continue;
-
-        if (usable != 0x00 && player->CanUseItem(item) != EQUIP_ERR_OK)
-            continue;
-
-        // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
-        // No need to do any of this if no search term was entered
-        if (!wsearchedname.empty())
+        // the item is only needed by the usable check and by the listed page
+        if (usable != 0x00 || (count < 50 && totalcount >= listfrom))
         {
-            std::string name = proto->Name1;
-            if (name.empty())
+            Item *item = sAuctionMgr->GetAItem(Aentry->item_guidlow);
+            if (!item)
                 continue;
 
-            // local name
-            if (loc_idx >= 0)
-                if (ItemLocale const *il = sObjectMgr->GetItemLocale(proto->ItemId))
-                    ObjectMgr::GetLocaleString(il->Name, loc_idx, name);
-
-            // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
-            //  that matches the search but it may not equal item->GetItemRandomPropertyId()
-            //  used in BuildAuctionInfo() which then causes wrong items to be listed
-            int32 propRefID = item->GetItemRandomPropertyId();
-
-            if (propRefID)
-            {
-                // Append the suffix to the name (ie: of the Monkey) if one exists
-                // These are found in ItemRandomProperties.dbc, not ItemRandomSuffix.dbc
-                //  even though the DBC names seem misleading
-                const ItemRandomPropertiesEntry *itemRandProp = sItemRandomPropertiesStore.LookupEntry(propRefID);
-
-                if (itemRandProp)
-                {
-                    char* const* temp = itemRandProp->nameSuffix;
-                    //char* temp = itemRandProp->nameSuffix;
-
-                    // dbc local name
-                    if (temp)
-                    {
-                        // Append the suffix (ie: of the Monkey) to the name using localization
-                        // or default enUS if localization is invalid
-                        name += ' ';
-                        name += temp[locdbc_idx >= 0 ? locdbc_idx : LOCALE_enUS];
-                    }
-                }
-            }
-
-            // Perform the search (with or without suffix)
-            if (!Utf8FitTo(name, wsearchedname))
+            if (usable != 0x00 && player->CanUseItem(item) != EQUIP_ERR_OK)
                 continue;
         }
 
@@ -24,6 +24,9 @@
 #include "Common.h"
 #include "DatabaseEnv.h"
 #include "DBCStructure.h"
+#include "AuctionSearchIndex.h"
+
+#include <queue>
 
 class Item;
 class Player;
@@ -114,8 +117,17 @@ class AuctionHouseObject
         uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
         uint32& count, uint32& totalcount);
 
+    // the item names of the search index are rebuilt from the item locales on the next search
+    void ResetSearchNames() { SearchIndex.ResetNames(); }
+
   private:
+    // auctions by expiry time, the earliest on top; removed auctions are skipped when they reach the top
+    typedef std::pair<time_t, uint32> AuctionExpiry;
+    typedef std::priority_queue<AuctionExpiry, std::vector<AuctionExpiry>, std::greater<AuctionExpiry> > AuctionExpiryQueue;
+
     AuctionEntryMap AuctionsMap;
+    AuctionSearchIndex SearchIndex;
+    AuctionExpiryQueue ExpiryQueue;
 
     // storage for "next" auction item for next Update()
     AuctionEntryMap::const_iterator next;
@@ -162,6 +174,8 @@ class AuctionHouseMgr
         //load first auction items, because of check if item exists, when loading
         void LoadAuctionItems();
         void LoadAuctions();
+        // after the item locales were reloaded
+        void ResetSearchNames();
 
         void AddAItem(Item* it);
         bool RemoveAItem(uint32 id);
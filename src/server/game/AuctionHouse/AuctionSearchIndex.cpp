@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AuctionSearchIndex.h"
+#include "AuctionHouseMgr.h"
+#include "ObjectMgr.h"
+#include "World.h"
+#include "DBCStores.h"
+#include "Item.h"
+#include "Util.h"
+
+void AuctionSearchIndex::AddAuction(AuctionEntry const* auction, Item const* item)
+{
+    ItemTemplate const* proto = item->GetTemplate();
+
+    IndexedAuction& indexed = m_auctions[auction->Id];
+    indexed.itemId = proto->ItemId;
+    indexed.randomPropertyId = item->GetItemRandomPropertyId();
+    indexed.itemClass = proto->Class;
+    indexed.itemSubClass = proto->SubClass;
+    indexed.inventoryType = proto->InventoryType;
+    indexed.quality = proto->Quality;
+    indexed.requiredLevel = proto->RequiredLevel;
+
+    m_classBuckets[indexed.itemClass].insert(auction->Id);
+    m_subClassBuckets[indexed.itemClass << 16 | indexed.itemSubClass].insert(auction->Id);
+
+    for (LocaleNamesMap::iterator itr = m_localeNames.begin(); itr != m_localeNames.end(); ++itr)
+        AddName(itr->second, auction->Id, indexed, itr->first);
+}
+
+void AuctionSearchIndex::RemoveAuction(uint32 auctionId)
+{
+    AuctionMap::iterator auctionItr = m_auctions.find(auctionId);
+    if (auctionItr == m_auctions.end())
+        return;
+
+    IndexedAuction const& indexed = auctionItr->second;
+    m_classBuckets[indexed.itemClass].erase(auctionId);
+    m_subClassBuckets[indexed.itemClass << 16 | indexed.itemSubClass].erase(auctionId);
+
+    for (LocaleNamesMap::iterator itr = m_localeNames.begin(); itr != m_localeNames.end(); ++itr)
+    {
+        LocaleNames& names = itr->second;
+        UNORDERED_MAP<uint32, std::wstring>::iterator nameItr = names.names.find(auctionId);
+        if (nameItr == names.names.end())
+            continue;
+
+        std::wstring const& name = nameItr->second;
+        for (size_t i = 0; i + 3 <= name.size(); ++i)
+        {
+            UNORDERED_MAP<uint64, AuctionIdList>::iterator trigramItr = names.trigrams.find(Trigram(name, i));
+            if (trigramItr == names.trigrams.end())
+                continue;
+
+            AuctionIdList& ids = trigramItr->second;
+            AuctionIdList::iterator id = std::lower_bound(ids.begin(), ids.end(), auctionId);
+            if (id != ids.end() && *id == auctionId)
+                ids.erase(id);
+
+            if (ids.empty())
+                names.trigrams.erase(trigramItr);
+        }
+
+        names.names.erase(nameItr);
+    }
+
+    m_auctions.erase(auctionItr);
+}
+
+void AuctionSearchIndex::ResetNames()
+{
+    m_localeNames.clear();
+}
+
+void AuctionSearchIndex::Search(Query const& query, std::vector<uint32>& auctionIds)
+{
+    LocaleNames const* names = query.name.empty() ? NULL : &GetLocaleNames(query.locale);
+
+    if (names && query.name.size() >= 3)
+    {
+        // every trigram of the searched name is in the name of a match, start from the rarest one
+        AuctionIdList const* candidates = NULL;
+        for (size_t i = 0; i + 3 <= query.name.size(); ++i)
+        {
+            UNORDERED_MAP<uint64, AuctionIdList>::const_iterator itr = names->trigrams.find(Trigram(query.name, i));
+            if (itr == names->trigrams.end())
+                return;
+
+            if (!candidates || itr->second.size() < candidates->size())
+                candidates = &itr->second;
+        }
+
+        for (AuctionIdList::const_iterator itr = candidates->begin(); itr != candidates->end(); ++itr)
+            if (Matches(m_auctions[*itr], query) && MatchesName(*names, *itr, query.name))
+                auctionIds.push_back(*itr);
+
+        return;
+    }
+
+    AuctionIdSet const* bucket = NULL;
+    if (query.itemClass != 0xffffffff)
+    {
+        bool bySubClass = query.itemSubClass != 0xffffffff;
+        BucketMap const& buckets = bySubClass ? m_subClassBuckets : m_classBuckets;
+        BucketMap::const_iterator itr = buckets.find(bySubClass ? query.itemClass << 16 | query.itemSubClass : query.itemClass);
+        if (itr == buckets.end())
+            return;
+
+        bucket = &itr->second;
+    }
+
+    if (bucket)
+    {
+        for (AuctionIdSet::const_iterator itr = bucket->begin(); itr != bucket->end(); ++itr)
+            if (Matches(m_auctions[*itr], query) && (!names || MatchesName(*names, *itr, query.name)))
+                auctionIds.push_back(*itr);
+    }
+    else
+    {
+        for (AuctionMap::const_iterator itr = m_auctions.begin(); itr != m_auctions.end(); ++itr)
+            if (Matches(itr->second, query) && (!names || MatchesName(*names, itr->first, query.name)))
+                auctionIds.push_back(itr->first);
+    }
+}
+
+bool AuctionSearchIndex::Matches(IndexedAuction const& auction, Query const& query)
+{
+    if (query.itemClass != 0xffffffff && auction.itemClass != query.itemClass)
+        return false;
+
+    if (query.itemSubClass != 0xffffffff && auction.itemSubClass != query.itemSubClass)
+        return false;
+
+    if (query.inventoryType != 0xffffffff && auction.inventoryType != query.inventoryType)
+        return false;
+
+    if (query.quality != 0xffffffff && auction.quality != query.quality)
+        return false;
+
+    if (query.levelMin != 0x00 && (auction.requiredLevel < query.levelMin || (query.levelMax != 0x00 && auction.requiredLevel > query.levelMax)))
+        return false;
+
+    return true;
+}
+
+std::wstring AuctionSearchIndex::BuildName(IndexedAuction const& auction, LocaleConstant locale)
+{
+    std::wstring wname;
+
+    ItemTemplate const* proto = sObjectMgr->GetItemTemplate(auction.itemId);
+    if (!proto)
+        return wname;
+
+    std::string name = proto->Name1;
+    if (name.empty())
+        return wname;
+
+    // local name
+    if (ItemLocale const* il = sObjectMgr->GetItemLocale(proto->ItemId))
+        ObjectMgr::GetLocaleString(il->Name, locale, name);
+
+    // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
+    //  that matches the search but it may not equal item->GetItemRandomPropertyId()
+    //  used in BuildAuctionInfo() which then causes wrong items to be listed
+    if (auction.randomPropertyId)
+    {
+        // Append the suffix to the name (ie: of the Monkey) if one exists
+        // These are found in ItemRandomProperties.dbc, not ItemRandomSuffix.dbc
+        //  even though the DBC names seem misleading
+        if (ItemRandomPropertiesEntry const* itemRandProp = sItemRandomPropertiesStore.LookupEntry(auction.randomPropertyId))
+        {
+            // Append the suffix (ie: of the Monkey) to the name using localization
+            name += ' ';
+            name += itemRandProp->nameSuffix[sWorld->GetAvailableDbcLocale(locale)];
+        }
+    }
+
+    if (!Utf8toWStr(name, wname))
+        return std::wstring();
+
+    wstrToLower(wname);
+    return wname;
+}
+
+uint64 AuctionSearchIndex::Trigram(std::wstring const& str, size_t pos)
+{
+    return uint64(str[pos] & 0x1FFFFF) << 42 | uint64(str[pos + 1] & 0x1FFFFF) << 21 | uint64(str[pos + 2] & 0x1FFFFF);
+}
+
+AuctionSearchIndex::LocaleNames& AuctionSearchIndex::GetLocaleNames(LocaleConstant locale)
+{
+    LocaleNamesMap::iterator itr = m_localeNames.find(locale);
+    if (itr != m_localeNames.end())
+        return itr->second;
+
+    LocaleNames& names = m_localeNames[locale];
+    for (AuctionMap::const_iterator auctionItr = m_auctions.begin(); auctionItr != m_auctions.end(); ++auctionItr)
+        AddName(names, auctionItr->first, auctionItr->second, locale);
+
+    return names;
+}
+
+void AuctionSearchIndex::AddName(LocaleNames& names, uint32 auctionId, IndexedAuction const& auction, LocaleConstant locale)
+{
+    std::wstring& name = names.names[auctionId];
+    name = BuildName(auction, locale);
+
+    for (size_t i = 0; i + 3 <= name.size(); ++i)
+    {
+        AuctionIdList& ids = names.trigrams[Trigram(name, i)];
+        // a trigram can repeat within a name
+        AuctionIdList::iterator id = std::lower_bound(ids.begin(), ids.end(), auctionId);
+        if (id == ids.end() || *id != auctionId)
+            ids.insert(id, auctionId);
+    }
+}
+
+bool AuctionSearchIndex::MatchesName(LocaleNames const& names, uint32 auctionId, std::wstring const& name) const
+{
+    UNORDERED_MAP<uint32, std::wstring>::const_iterator itr = names.names.find(auctionId);
+    return itr != names.names.end() && itr->second.find(name) != std::wstring::npos;
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _AUCTION_SEARCH_INDEX_H
+#define _AUCTION_SEARCH_INDEX_H
+
+#include "Common.h"
+
+#include <map>
+#include <set>
+#include <vector>
+
+struct AuctionEntry;
+class Item;
+
+/*
+ * Index of the auctions of one auction house, used to answer
+ * CMSG_AUCTION_LIST_ITEMS without looking at every auction.
+ *
+ * Every auction is kept with the item fields the search filters on,
+ * and in buckets by item class and by item class and subclass. For
+ * each client locale that searched by name, the lower-cased item name
+ * with its random property suffix and an index of the character
+ * trigrams of these names are built on the first such search and kept
+ * up to date from then on. All lists are ordered by auction id, the
+ * order in which the auctions are listed.
+ */
+class AuctionSearchIndex
+{
+    public:
+        struct Query
+        {
+            std::wstring name;                              // lower-cased, empty for any
+            LocaleConstant locale;                          // locale the name is searched in
+            uint32 itemClass;                               // 0xFFFFFFFF for any
+            uint32 itemSubClass;                            // 0xFFFFFFFF for any
+            uint32 inventoryType;                           // 0xFFFFFFFF for any
+            uint32 quality;                                 // 0xFFFFFFFF for any
+            uint8 levelMin;                                 // 0 for any
+            uint8 levelMax;                                 // 0 for any
+        };
+
+        void AddAuction(AuctionEntry const* auction, Item const* item);
+        void RemoveAuction(uint32 auctionId);
+
+        // forgets the names, to be rebuilt from the reloaded item locales
+        void ResetNames();
+
+        // ids of the matching auctions, in id order
+        void Search(Query const& query, std::vector<uint32>& auctionIds);
+
+    private:
+        typedef std::set<uint32> AuctionIdSet;
+        typedef std::vector<uint32> AuctionIdList;          // sorted
+
+        struct IndexedAuction
+        {
+            uint32 itemId;
+            int32 randomPropertyId;
+            uint32 itemClass;
+            uint32 itemSubClass;
+            uint32 inventoryType;
+            uint32 quality;
+            uint32 requiredLevel;
+        };
+
+        struct LocaleNames
+        {
+            UNORDERED_MAP<uint32, std::wstring> names;      // by auction id
+            UNORDERED_MAP<uint64, AuctionIdList> trigrams;
+        };
+
+        typedef std::map<uint32, IndexedAuction> AuctionMap;
+        typedef std::map<uint32, AuctionIdSet> BucketMap;
+        typedef std::map<LocaleConstant, LocaleNames> LocaleNamesMap;
+
+        static bool Matches(IndexedAuction const& auction, Query const& query);
+        static std::wstring BuildName(IndexedAuction const& auction, LocaleConstant locale);
+        static uint64 Trigram(std::wstring const& str, size_t pos);
+
+        LocaleNames& GetLocaleNames(LocaleConstant locale);
+        void AddName(LocaleNames& names, uint32 auctionId, IndexedAuction const& auction, LocaleConstant locale);
+        bool MatchesName(LocaleNames const& names, uint32 auctionId, std::wstring const& name) const;
+
+        AuctionMap m_auctions;
+        BucketMap m_classBuckets;                           // by item class
+        BucketMap m_subClassBuckets;                        // by item class << 16 | subclass
+        LocaleNamesMap m_localeNames;
+};
+
+#endif
@@ -22,6 +22,7 @@
 #include "ArenaTeamMgr.h"
 #include "World.h"
 #include "WorldPacket.h"
+#include "SharedWorldPacket.h"
 
 #include "ArenaTeam.h"
 #include "Battleground.h"
@@ -590,17 +591,19 @@ void Battleground::SetTeamStartLoc(uint32 TeamID, float X, float Y, float Z, flo
 
 void Battleground::SendPacketToAll(WorldPacket* packet)
 {
+    SharedWorldPacket shared(*packet);
     for (BattlegroundPlayerMap::const_iterator itr = m_Players.begin(); itr != m_Players.end(); ++itr)
         if (Player* player = _GetPlayer(itr, "SendPacketToAll"))
-            player->GetSession()->SendPacket(packet);
+            player->GetSession()->SendPacket(shared);
 }
 
 void Battleground::SendPacketToTeam(uint32 TeamID, WorldPacket* packet, Player *sender, bool self)
 {
+    SharedWorldPacket shared(*packet);
     for (BattlegroundPlayerMap::const_iterator itr = m_Players.begin(); itr != m_Players.end(); ++itr)
         if (Player* player = _GetPlayerForTeam(TeamID, itr, "SendPacketToTeam"))
             if (self || sender != player)
-                player->GetSession()->SendPacket(packet);
+                player->GetSession()->SendPacket(shared);
 }
 
 void Battleground::PlaySoundToAll(uint32 SoundID)
@@ -28,6 +28,8 @@
 #include "SystemConfig.h"
 #include "revision.h"
 #include "Util.h"
+#include "WorldSocketMgr.h"
+#include "UpdateData.h"
 
 bool ChatHandler::HandleHelpCommand(const char* args)
 {
@@ -99,6 +101,16 @@ bool ChatHandler::HandleServerInfoCommand(const char* /*args*/)
     PSendSysMessage(LANG_UPTIME, uptime.c_str());
     PSendSysMessage("Update time diff: %u.", updateTime);
 
+    uint64 sendCalls, sentBytes;
+    sWorldSocketMgr->GetOutputStatistics(sendCalls, sentBytes);
+    PSendSysMessage("Network output: " UI64FMTD " bytes in " UI64FMTD " send calls (%.1f bytes per call).",
+        sentBytes, sendCalls, sendCalls ? double(sentBytes) / sendCalls : 0.0);
+
+    uint64 compressedPackets, compressedIn, compressedOut, compressionTime;
+    UpdateData::GetCompressionStatistics(compressedPackets, compressedIn, compressedOut, compressionTime);
+    PSendSysMessage("Update compression: " UI64FMTD " packets, " SI64FMTD " of " UI64FMTD " bytes saved, " UI64FMTD " ms spent.",
+        compressedPackets, int64(compressedIn) - int64(compressedOut), compressedIn, compressionTime / 1000);
+
     return true;
 }
 
@@ -3780,6 +3780,120 @@ bool ChatHandler::HandleServerPLimitCommand(const char *args)
     return true;
 }
 
+bool ChatHandler::HandleServerMapsCommand(const char *args)
+{
+    uint32 count = 10;
+    if (*args)
+    {
+        int32 val = atoi((char*)args);
+        if (val <= 0)
+            return false;
+        count = uint32(val);
+    }
+
+    if (!sMapMgr->GetMapUpdater()->activated())
+        SendSysMessage("Map updater is not active (MapUpdate.Threads), map update times are not measured.");
+
+    std::vector<Map*> maps;
+    sMapMgr->GetMapsByUpdateTime(maps);
+
+    for (std::vector<Map*>::const_iterator itr = maps.begin(); itr != maps.end() && count; ++itr, --count)
+    {
+        Map* map = *itr;
+        PSendSysMessage("Map %u (%s) instance %u: %u players, last update %u ms, max update %u ms.",
+            map->GetId(), map->GetMapName(), map->GetInstanceId(), map->GetPlayers().getSize(),
+            map->GetLastUpdateTime(), map->GetMaxUpdateTime());
+    }
+
+    return true;
+}
+
+template<class T>
+static void SendDatabasePoolStatistics(ChatHandler* handler, DatabaseWorkerPool<T>& pool)
+{
+    DatabasePoolStatistics stats;
+    pool.GetStatistics(stats);
+
+    handler->PSendSysMessage("Database '%s': %u synchronous connections active, %u idle, %u threads waiting, " UI64FMTD " waits over timeout.",
+        pool.GetDatabaseName().c_str(), stats.activeConnections, stats.idleConnections, stats.waitingThreads, stats.waitTimeouts);
+    handler->PSendSysMessage("Waits: none " UI64FMTD ", <1ms " UI64FMTD ", <10ms " UI64FMTD ", <100ms " UI64FMTD ", <1s " UI64FMTD ", longer " UI64FMTD ".",
+        stats.waitHistogram[0], stats.waitHistogram[1], stats.waitHistogram[2], stats.waitHistogram[3], stats.waitHistogram[4], stats.waitHistogram[5]);
+
+    std::multimap<uint64, uint32> callers;
+    for (std::map<uint32, uint64>::const_iterator itr = stats.queriesByCaller.begin(); itr != stats.queriesByCaller.end(); ++itr)
+        callers.insert(std::make_pair(itr->second, itr->first));
+
+    uint32 count = 5;
+    for (std::multimap<uint64, uint32>::const_reverse_iterator itr = callers.rbegin(); itr != callers.rend() && count; ++itr, --count)
+    {
+        if (itr->second == SYNCH_CALLER_ADHOC)
+            handler->PSendSysMessage("  ad hoc queries: " UI64FMTD, itr->first);
+        else if (itr->second == SYNCH_CALLER_TRANSACTION)
+            handler->PSendSysMessage("  transactions: " UI64FMTD, itr->first);
+        else
+            handler->PSendSysMessage("  prepared statement %u: " UI64FMTD, itr->second, itr->first);
+    }
+}
+
+bool ChatHandler::HandleServerDatabaseCommand(const char* /*args*/)
+{
+    SendDatabasePoolStatistics(this, WorldDatabase);
+    SendDatabasePoolStatistics(this, CharacterDatabase);
+    SendDatabasePoolStatistics(this, LoginDatabase);
+
+    uint64 batches, batchedStatements, coalescedRows, fallbacks;
+    MySQLConnection::GetBatchStatistics(batches, batchedStatements, coalescedRows, fallbacks);
+    PSendSysMessage("Batched writes: " UI64FMTD " statements sent in " UI64FMTD " round trips, " UI64FMTD " rows merged into inserts, " UI64FMTD " inserts retried row by row.",
+        batchedStatements, batches, coalescedRows, fallbacks);
+    return true;
+}
+
+template<class T>
+static bool SetSynchConnectionCount(DatabaseWorkerPool<T>& pool, uint32 count)
+{
+    while (pool.GetSynchConnectionCount() < count)
+        if (!pool.AddSynchConnection())
+            return false;
+
+    while (pool.GetSynchConnectionCount() > count)
+        if (!pool.RemoveSynchConnection())
+            return false;
+
+    return true;
+}
+
+bool ChatHandler::HandleServerSetSynchConnectionsCommand(const char* args)
+{
+    char* db = strtok((char*)args, " ");
+    char* countStr = strtok(NULL, " ");
+    if (!db || !countStr)
+        return false;
+
+    int32 count = atoi(countStr);
+    if (count < 1 || count > 32)
+        return false;
+
+    bool ok;
+    if (strcmp(db, "world") == 0)
+        ok = SetSynchConnectionCount(WorldDatabase, count);
+    else if (strcmp(db, "character") == 0)
+        ok = SetSynchConnectionCount(CharacterDatabase, count);
+    else if (strcmp(db, "login") == 0)
+        ok = SetSynchConnectionCount(LoginDatabase, count);
+    else
+        return false;
+
+    if (!ok)
+    {
+        PSendSysMessage("Could not change the synchronous connections of the %s database, see the SQL driver log.", db);
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    PSendSysMessage("The %s database now has %d synchronous connections.", db, count);
+    return true;
+}
+
 bool ChatHandler::HandleCastCommand(const char *args)
 {
     if (!*args)
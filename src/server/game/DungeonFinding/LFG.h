@@ -83,6 +83,7 @@ struct LfgLockStatus
     LfgLockStatusType lockstatus;                          ///< Lock type
 };
 
+typedef std::list<uint64> LfgGuidList;
 typedef std::set<uint32> LfgDungeonSet;
 typedef std::map<uint32, LfgLockStatusType> LfgLockMap;
 typedef std::map<uint64, LfgLockMap> LfgLockPartyMap;
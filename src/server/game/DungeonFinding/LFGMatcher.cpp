@@ -0,0 +1,437 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LFGMatcher.h"
+#include "LFGMgr.h"
+#include "Group.h"
+#include "Log.h"
+
+// A composition of t tanks, h healers and d damage dealers is bit t * 8 + h * 4 + d
+// of a role composition mask, the full group being bit 15
+#define ROLE_COMPOSITION(t, h, d) (1 << ((t) * 8 + (h) * 4 + (d)))
+#define ROLE_COMPOSITIONS_TANK   0xFF00                    // compositions with a tank
+#define ROLE_COMPOSITIONS_HEALER 0xF0F0                    // compositions with a healer
+
+// Candidates tried when looking for a group for an entry. With many
+// entries that all fit the new one but not each other the search could
+// go on for long; the entry stays queued and is a candidate for the next
+// ones instead.
+#define LFG_MATCHER_MAX_STEPS 20000
+
+static bool Intersects(std::vector<uint32> const& left, std::vector<uint32> const& right)
+{
+    std::vector<uint32>::const_iterator itLeft = left.begin();
+    std::vector<uint32>::const_iterator itRight = right.begin();
+    while (itLeft != left.end() && itRight != right.end())
+    {
+        if (*itLeft < *itRight)
+            ++itLeft;
+        else if (*itRight < *itLeft)
+            ++itRight;
+        else
+            return true;
+    }
+    return false;
+}
+
+static uint8 MaxDamage(uint16 roles)
+{
+    if (roles & 0x8888)
+        return 3;
+    if (roles & 0x4444)
+        return 2;
+    if (roles & 0x2222)
+        return 1;
+    return 0;
+}
+
+LfgMatcher::LfgMatcher() : m_scheduled(false), m_sequence(0)
+{
+}
+
+void LfgMatcher::AddDungeon(uint32 dungeonId)
+{
+    if (m_dungeonBits.find(dungeonId) != m_dungeonBits.end())
+        return;
+
+    if (m_dungeonIds.size() >= LFG_MATCHER_MAX_DUNGEONS)
+    {
+        sLog->outError("LfgMatcher::AddDungeon: More than %u dungeons, dungeon %u will never be matched", LFG_MATCHER_MAX_DUNGEONS, dungeonId);
+        return;
+    }
+
+    m_dungeonBits[dungeonId] = uint16(m_dungeonIds.size());
+    m_dungeonIds.push_back(dungeonId);
+}
+
+void LfgMatcher::BuildDungeonBits(LfgDungeonSet const& dungeons, LfgDungeonBits& bits) const
+{
+    bits.reset();
+    for (LfgDungeonSet::const_iterator it = dungeons.begin(); it != dungeons.end(); ++it)
+    {
+        std::map<uint32, uint16>::const_iterator itBit = m_dungeonBits.find(*it);
+        if (itBit != m_dungeonBits.end())
+            bits.set(itBit->second);
+    }
+}
+
+/**
+   Role compositions a player with the given roles can fill
+
+   @param[in]     roles Player selected roles
+   @return Mask of compositions, 0 if no role
+*/
+uint16 LfgMatcher::RoleCompositions(uint8 roles)
+{
+    uint16 compositions = 0;
+    if (roles & ROLE_TANK)
+        compositions |= ROLE_COMPOSITION(1, 0, 0);
+    if (roles & ROLE_HEALER)
+        compositions |= ROLE_COMPOSITION(0, 1, 0);
+    if (roles & ROLE_DAMAGE)
+        compositions |= ROLE_COMPOSITION(0, 0, 1);
+    return compositions;
+}
+
+/**
+   Role compositions two sets of players can fill together, without more
+   tanks, healers or damage dealers than needed
+
+   @param[in]     left Compositions of the first set, ROLE_COMPOSITION(0, 0, 0) for no player
+   @param[in]     right Compositions of the second set
+   @return Mask of compositions, 0 if they do not fit together
+*/
+uint16 LfgMatcher::CombineRoleCompositions(uint16 left, uint16 right)
+{
+    uint16 compositions = 0;
+    for (uint8 i = 0; i < 16; ++i)
+    {
+        if (!(left & (1 << i)))
+            continue;
+
+        for (uint8 j = 0; j < 16; ++j)
+        {
+            if (!(right & (1 << j)))
+                continue;
+
+            uint8 tanks = (i >> 3) + (j >> 3);
+            uint8 healers = ((i >> 2) & 1) + ((j >> 2) & 1);
+            uint8 damage = (i & 3) + (j & 3);
+            if (tanks <= LFG_TANKS_NEEDED && healers <= LFG_HEALERS_NEEDED && damage <= LFG_DPS_NEEDED)
+                compositions |= ROLE_COMPOSITION(tanks, healers, damage);
+        }
+    }
+    return compositions;
+}
+
+void LfgMatcher::Add(LfgMatcherEntry const& entry)
+{
+    ACE_GUARD(ACE_Thread_Mutex, Guard, m_lock);
+    m_pending.push_back(entry);
+}
+
+void LfgMatcher::Remove(uint64 guid)
+{
+    ACE_GUARD(ACE_Thread_Mutex, Guard, m_lock);
+
+    for (std::deque<LfgMatcherEntry>::iterator it = m_pending.begin(); it != m_pending.end();)
+    {
+        if (it->guid == guid)
+            it = m_pending.erase(it);
+        else
+            ++it;
+    }
+
+    std::map<uint64, uint32>::iterator itSlot = m_slotsByGuid.find(guid);
+    if (itSlot != m_slotsByGuid.end())
+        Erase(itSlot->second);
+}
+
+bool LfgMatcher::Schedule()
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, Guard, m_lock, false);
+
+    if (m_scheduled || m_pending.empty())
+        return false;
+
+    m_scheduled = true;
+    return true;
+}
+
+void LfgMatcher::Process()
+{
+    for (;;)
+    {
+        // one entry at a time, not to hold the queue changes of the world thread for long
+        ACE_GUARD(ACE_Thread_Mutex, Guard, m_lock);
+
+        if (m_pending.empty())
+        {
+            m_scheduled = false;
+            return;
+        }
+
+        LfgMatcherEntry entry = m_pending.front();
+        m_pending.pop_front();
+
+        std::map<uint64, uint32>::iterator itSlot = m_slotsByGuid.find(entry.guid);
+        if (itSlot != m_slotsByGuid.end())
+            Erase(itSlot->second);
+
+        FindMatch(Insert(entry));
+    }
+}
+
+void LfgMatcher::TakeMatches(LfgMatchList& matches)
+{
+    ACE_GUARD(ACE_Thread_Mutex, Guard, m_lock);
+    matches.splice(matches.end(), m_matches);
+}
+
+bool LfgMatcher::IsCompatible(LfgMatcherEntry const& left, LfgMatcherEntry const& right) const
+{
+    if (left.queueId != right.queueId)
+        return false;
+
+    if (left.numPlayers + right.numPlayers > MAXGROUPSIZE || (left.lfgGroup && right.lfgGroup))
+        return false;
+
+    if (!CombineRoleCompositions(left.roles, right.roles) || !(left.dungeons & right.dungeons).any())
+        return false;
+
+    // player in both queues or ignoring a player of the other one
+    return !Intersects(left.members, right.members) && !Intersects(left.ignores, right.members) &&
+        !Intersects(right.ignores, left.members);
+}
+
+bool LfgMatcher::IsCompatible(uint32 left, uint32 right) const
+{
+    std::vector<uint64> const& compatible = m_slots[left].compatible;
+    return right / 64 < compatible.size() && (compatible[right / 64] & (uint64(1) << (right % 64)));
+}
+
+void LfgMatcher::SetCompatible(uint32 left, uint32 right)
+{
+    std::vector<uint64>& compatible = m_slots[left].compatible;
+    if (right / 64 >= compatible.size())
+        compatible.resize(m_slots.size() / 64 + 1, 0);
+
+    compatible[right / 64] |= uint64(1) << (right % 64);
+}
+
+uint32 LfgMatcher::Insert(LfgMatcherEntry const& entry)
+{
+    uint32 slot;
+    if (!m_freeSlots.empty())
+    {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else
+    {
+        slot = uint32(m_slots.size());
+        m_slots.push_back(Slot());
+    }
+
+    m_slots[slot].entry = entry;
+    m_slots[slot].sequence = ++m_sequence;
+    m_slotsByGuid[entry.guid] = slot;
+
+    for (uint32 other = 0; other < m_slots.size(); ++other)
+    {
+        if (other == slot || !m_slots[other].sequence)
+            continue;
+
+        if (IsCompatible(entry, m_slots[other].entry))
+        {
+            SetCompatible(slot, other);
+            SetCompatible(other, slot);
+        }
+    }
+
+    return slot;
+}
+
+void LfgMatcher::Erase(uint32 slot)
+{
+    for (uint32 other = 0; other < m_slots.size(); ++other)
+    {
+        std::vector<uint64>& compatible = m_slots[other].compatible;
+        if (slot / 64 < compatible.size())
+            compatible[slot / 64] &= ~(uint64(1) << (slot % 64));
+    }
+
+    Slot& erased = m_slots[slot];
+    m_slotsByGuid.erase(erased.entry.guid);
+    erased.entry = LfgMatcherEntry();
+    erased.sequence = 0;
+    erased.compatible.assign(erased.compatible.size(), 0);
+    m_freeSlots.push_back(slot);
+}
+
+struct LfgSlotSequenceOrder
+{
+    LfgSlotSequenceOrder(std::vector<uint32> const& sequences) : m_sequences(sequences) { }
+
+    bool operator()(uint32 left, uint32 right) const { return m_sequences[left] < m_sequences[right]; }
+
+    std::vector<uint32> const& m_sequences;
+};
+
+/**
+   Looks for a group formed by the entry of the given slot and the entries
+   compatible with it. The entries of a group found are taken out of the
+   queue.
+
+   @param[in]     slot Slot of the entry
+*/
+void LfgMatcher::FindMatch(uint32 slot)
+{
+    LfgMatcherEntry const& entry = m_slots[slot].entry;
+    if (!entry.roles || !entry.dungeons.any())
+        return;
+
+    Search search;
+    search.slots.push_back(slot);
+    search.numPlayers = entry.numPlayers;
+    search.lfgGroup = entry.lfgGroup;
+    search.roles = entry.roles;
+    search.dungeons = entry.dungeons;
+    search.steps = 0;
+
+    std::vector<uint32> sequences(m_slots.size());
+    for (uint32 i = 0; i < m_slots.size(); ++i)
+        sequences[i] = m_slots[i].sequence;
+
+    if (search.numPlayers < MAXGROUPSIZE)
+    {
+        std::vector<uint64> const& compatible = m_slots[slot].compatible;
+        for (uint32 word = 0; word < compatible.size(); ++word)
+            for (uint32 bit = 0; bit < 64; ++bit)
+                if (compatible[word] & (uint64(1) << bit))
+                    search.candidates.push_back(word * 64 + bit);
+        std::sort(search.candidates.begin(), search.candidates.end(), LfgSlotSequenceOrder(sequences));
+
+        // roles the candidates from each one on can still give, to stop as soon as they can not complete the group
+        size_t numCandidates = search.candidates.size();
+        search.tanks.assign(numCandidates + 1, 0);
+        search.healers.assign(numCandidates + 1, 0);
+        search.damage.assign(numCandidates + 1, 0);
+        for (size_t i = numCandidates; i > 0; --i)
+        {
+            uint16 roles = m_slots[search.candidates[i - 1]].entry.roles;
+            search.tanks[i - 1] = std::min<uint8>(LFG_TANKS_NEEDED, search.tanks[i] + ((roles & ROLE_COMPOSITIONS_TANK) ? 1 : 0));
+            search.healers[i - 1] = std::min<uint8>(LFG_HEALERS_NEEDED, search.healers[i] + ((roles & ROLE_COMPOSITIONS_HEALER) ? 1 : 0));
+            search.damage[i - 1] = std::min<uint8>(LFG_DPS_NEEDED, search.damage[i] + MaxDamage(roles));
+        }
+
+        if (!Extend(search, 0))
+        {
+            if (search.steps > LFG_MATCHER_MAX_STEPS)
+                sLog->outDebug(LOG_FILTER_LFG, "LfgMatcher::FindMatch: [" UI64FMTD "] search stopped after %u steps, %u candidates", entry.guid, search.steps, uint32(numCandidates));
+            return;
+        }
+    }
+
+    LfgMatch match;
+    std::sort(search.slots.begin(), search.slots.end(), LfgSlotSequenceOrder(sequences));
+
+    for (std::vector<uint32>::const_iterator it = search.slots.begin(); it != search.slots.end(); ++it)
+    {
+        match.queues.push_back(m_slots[*it].entry.guid);
+        match.versions.push_back(m_slots[*it].entry.version);
+    }
+
+    for (uint32 bit = 0; bit < m_dungeonIds.size(); ++bit)
+        if (search.dungeons.test(bit))
+            match.dungeons.insert(m_dungeonIds[bit]);
+
+    for (std::vector<uint32>::const_iterator it = search.slots.begin(); it != search.slots.end(); ++it)
+        Erase(*it);
+
+    m_matches.push_back(match);
+}
+
+bool LfgMatcher::Extend(Search& search, size_t from)
+{
+    if (search.numPlayers == MAXGROUPSIZE)
+        return true;
+
+    for (size_t i = from; i < search.candidates.size(); ++i)
+    {
+        if (++search.steps > LFG_MATCHER_MAX_STEPS || !CanComplete(search, i))
+            return false;
+
+        uint32 slot = search.candidates[i];
+        LfgMatcherEntry const& entry = m_slots[slot].entry;
+        if (search.numPlayers + entry.numPlayers > MAXGROUPSIZE || (search.lfgGroup && entry.lfgGroup))
+            continue;
+
+        // candidates are all compatible with the first entry
+        bool compatible = true;
+        for (size_t j = 1; j < search.slots.size() && compatible; ++j)
+            compatible = IsCompatible(slot, search.slots[j]);
+        if (!compatible)
+            continue;
+
+        uint16 roles = CombineRoleCompositions(search.roles, entry.roles);
+        LfgDungeonBits dungeons = search.dungeons & entry.dungeons;
+        if (!roles || !dungeons.any())
+            continue;
+
+        uint8 numPlayers = search.numPlayers;
+        bool lfgGroup = search.lfgGroup;
+        uint16 savedRoles = search.roles;
+        LfgDungeonBits savedDungeons = search.dungeons;
+
+        search.slots.push_back(slot);
+        search.numPlayers += entry.numPlayers;
+        search.lfgGroup = search.lfgGroup || entry.lfgGroup;
+        search.roles = roles;
+        search.dungeons = dungeons;
+        if (Extend(search, i + 1))
+            return true;
+
+        search.slots.pop_back();
+        search.numPlayers = numPlayers;
+        search.lfgGroup = lfgGroup;
+        search.roles = savedRoles;
+        search.dungeons = savedDungeons;
+    }
+
+    return false;
+}
+
+/**
+   Whether the candidates from the given one on may still complete the group
+
+   @param[in]     search Group being formed
+   @param[in]     from First candidate that may be added
+*/
+bool LfgMatcher::CanComplete(Search const& search, size_t from) const
+{
+    for (uint8 i = 0; i < 16; ++i)
+    {
+        if (!(search.roles & (1 << i)))
+            continue;
+
+        if ((i >> 3) + search.tanks[from] >= LFG_TANKS_NEEDED && ((i >> 2) & 1) + search.healers[from] >= LFG_HEALERS_NEEDED &&
+            (i & 3) + search.damage[from] >= LFG_DPS_NEEDED)
+            return true;
+    }
+    return false;
+}
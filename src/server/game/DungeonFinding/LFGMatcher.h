@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _LFGMATCHER_H
+#define _LFGMATCHER_H
+
+#include "Common.h"
+#include "LFG.h"
+
+#include <ace/Thread_Mutex.h>
+#include <bitset>
+#include <deque>
+
+#define LFG_MATCHER_MAX_DUNGEONS 512
+
+typedef std::bitset<LFG_MATCHER_MAX_DUNGEONS> LfgDungeonBits;
+
+/// Role compositions of no player, the ones of the players are combined with
+#define LFG_ROLE_COMPOSITION_EMPTY 0x0001
+
+/// Snapshot of a queued player or group, all the matcher knows about it
+struct LfgMatcherEntry
+{
+    LfgMatcherEntry() : guid(0), version(0), queueId(0), numPlayers(0), lfgGroup(false), roles(0) { }
+
+    uint64 guid;                                           ///< Player or group guid
+    uint32 version;                                        ///< Queue entry the snapshot was taken of, see LFGMgr::AddToQueue
+    uint8 queueId;                                         ///< Entries only match within a queue
+    uint8 numPlayers;
+    bool lfgGroup;                                         ///< Group already in a lfg dungeon
+    uint16 roles;                                          ///< Role compositions the entry can fill, see LfgMatcher::RoleCompositions
+    LfgDungeonBits dungeons;                               ///< Selected dungeons none of the players is locked for
+    std::vector<uint32> members;                           ///< Player low guids, sorted
+    std::vector<uint32> ignores;                           ///< Low guids ignored by the players, sorted
+};
+
+/// Entries that form a group, in queue order
+struct LfgMatch
+{
+    uint8 queueId;
+    LfgGuidList queues;
+    std::vector<uint32> versions;                          ///< Queue entry of each of the queues when matched
+    LfgDungeonSet dungeons;                                ///< Dungeons all of them can do
+};
+
+typedef std::list<LfgMatch> LfgMatchList;
+
+/*
+ * Finds groups among the queued players and groups without touching any
+ * Player or Group, so that it can run on a thread of its own.
+ *
+ * Every entry gets a queue slot. When it is added, its compatibility
+ * with every queued entry of its queue (distinct players, no ignores, at
+ * most one lfg group, not too many players, roles that fit together and
+ * a dungeon in common) is stored as a bit in a row per slot. A group is
+ * then searched only among the entries compatible with the new one, in
+ * queue order; entries queued before were already checked against each
+ * other when they were added.
+ *
+ * Roles are kept as a mask of the (tanks, healers, damage) compositions,
+ * within the needed ones, an entry can fill; the compositions of a set of
+ * entries are the sums of theirs.
+ */
+class LfgMatcher
+{
+    public:
+        LfgMatcher();
+
+        /// Gives a dungeon a bit, to be called before anything is queued
+        void AddDungeon(uint32 dungeonId);
+        void BuildDungeonBits(LfgDungeonSet const& dungeons, LfgDungeonBits& bits) const;
+
+        static uint16 RoleCompositions(uint8 roles);
+        static uint16 CombineRoleCompositions(uint16 left, uint16 right);
+
+        void Add(LfgMatcherEntry const& entry);
+        void Remove(uint64 guid);
+
+        /// Whether a Process call has to be scheduled for the added entries
+        bool Schedule();
+        /// Queues the added entries, looking for a group for each of them
+        void Process();
+        void TakeMatches(LfgMatchList& matches);
+
+    private:
+        struct Slot
+        {
+            Slot() : sequence(0) { }
+
+            LfgMatcherEntry entry;
+            uint32 sequence;                               ///< Queue order, 0 for a free slot
+            std::vector<uint64> compatible;                ///< Bit per slot
+        };
+
+        struct Search
+        {
+            std::vector<uint32> slots;
+            uint8 numPlayers;
+            bool lfgGroup;
+            uint16 roles;
+            LfgDungeonBits dungeons;
+            std::vector<uint32> candidates;
+            std::vector<uint8> tanks;                      ///< Tanks the candidates from this one on can give
+            std::vector<uint8> healers;
+            std::vector<uint8> damage;
+            uint32 steps;
+        };
+
+        bool IsCompatible(LfgMatcherEntry const& left, LfgMatcherEntry const& right) const;
+        bool IsCompatible(uint32 left, uint32 right) const;
+        void SetCompatible(uint32 left, uint32 right);
+
+        uint32 Insert(LfgMatcherEntry const& entry);
+        void Erase(uint32 slot);
+        void FindMatch(uint32 slot);
+        bool Extend(Search& search, size_t from);
+        bool CanComplete(Search const& search, size_t from) const;
+
+        std::vector<uint32> m_dungeonIds;                  ///< By bit
+        std::map<uint32, uint16> m_dungeonBits;            ///< By dungeon id
+
+        ACE_Thread_Mutex m_lock;
+        std::deque<LfgMatcherEntry> m_pending;
+        bool m_scheduled;
+        std::vector<Slot> m_slots;
+        std::vector<uint32> m_freeSlots;
+        std::map<uint64, uint32> m_slotsByGuid;
+        uint32 m_sequence;
+        LfgMatchList m_matches;
+};
+
+#endif
@@ -31,7 +31,22 @@
 #include "Group.h"
 #include "Player.h"
 
-LFGMgr::LFGMgr(): m_update(true), m_QueueTimer(0), m_lfgProposalId(1),
+class LfgMatchRequest : public ACE_Method_Request
+{
+    public:
+        LfgMatchRequest(LfgMatcher& matcher) : m_matcher(matcher) { }
+
+        virtual int call()
+        {
+            m_matcher.Process();
+            return 0;
+        }
+
+    private:
+        LfgMatcher& m_matcher;
+};
+
+LFGMgr::LFGMgr(): m_update(true), m_QueueTimer(0), m_lfgProposalId(1), m_lastQueueVersion(0),
 m_WaitTimeAvg(-1), m_WaitTimeTank(-1), m_WaitTimeHealer(-1), m_WaitTimeDps(-1),
 m_NumWaitTimeAvg(0), m_NumWaitTimeTank(0), m_NumWaitTimeHealer(0), m_NumWaitTimeDps(0)
 {
@@ -49,13 +64,20 @@ m_NumWaitTimeAvg(0), m_NumWaitTimeTank(0), m_NumWaitTimeHealer(0), m_NumWaitTime
                 if (dungeon->type != LFG_TYPE_RANDOM)
                     m_CachedDungeonMap[dungeon->grouptype].insert(dungeon->ID);
                 m_CachedDungeonMap[0].insert(dungeon->ID);
+                m_matcher.AddDungeon(dungeon->ID);
             }
         }
+
+        if (sWorld->getBoolConfig(CONFIG_DUNGEON_FINDER_BACKGROUND_MATCHING) && m_matchWorker.activate() == -1)
+            sLog->outError("LFGMgr: Can't start the matching thread, matching on the world thread");
     }
 }
 
 LFGMgr::~LFGMgr()
 {
+    if (m_matchWorker.activated())
+        m_matchWorker.deactivate();
+
     for (LfgRewardMap::iterator itr = m_RewardMap.begin(); itr != m_RewardMap.end(); ++itr)
         delete itr->second;
 
@@ -196,58 +218,61 @@ void LFGMgr::Update(uint32 diff)
         }
     }
 
-    // Check if a proposal can be formed with the new groups being added
+    // Hand the new groups over to the matcher, that checks if a proposal can be formed with them
     for (LfgGuidListMap::iterator it = m_newToQueue.begin(); it != m_newToQueue.end(); ++it)
     {
-        uint8 queueId = it->first;
-        LfgGuidList& newToQueue = it->second;
-        LfgGuidList& currentQueue = m_currentQueue[queueId];
-        LfgGuidList firstNew;
-        while (!newToQueue.empty())
+        for (LfgGuidList::const_iterator itGuid = it->second.begin(); itGuid != it->second.end(); ++itGuid)
         {
-            uint64 frontguid = newToQueue.front();
-            sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::Update: QueueId %u: checking [" UI64FMTD "] newToQueue(%u), currentQueue(%u)", queueId, frontguid, uint32(newToQueue.size()), uint32(currentQueue.size()));
-            firstNew.push_back(frontguid);
-            newToQueue.pop_front();
+            LfgMatcherEntry entry;
+            if (BuildMatcherEntry(*itGuid, it->first, entry))
+                m_matcher.Add(entry);
+        }
+        it->second.clear();
+    }
 
-            LfgGuidList temporalList = currentQueue;
-            if (LfgProposal* pProposal = FindNewGroups(firstNew, temporalList)) // Group found!
-            {
-                // Remove groups in the proposal from new and current queues (not from queue map)
-                for (LfgGuidList::const_iterator itQueue = pProposal->queues.begin(); itQueue != pProposal->queues.end(); ++itQueue)
-                {
-                    currentQueue.remove(*itQueue);
-                    newToQueue.remove(*itQueue);
-                }
-                m_Proposals[++m_lfgProposalId] = pProposal;
+    if (m_matchWorker.activated())
+    {
+        if (m_matcher.Schedule())
+            m_matchWorker.execute(new LfgMatchRequest(m_matcher));
+    }
+    else
+        m_matcher.Process();
 
-                uint64 guid = 0;
-                for (LfgProposalPlayerMap::const_iterator itPlayers = pProposal->players.begin(); itPlayers != pProposal->players.end(); ++itPlayers)
-                {
-                    guid = itPlayers->first;
-                    SetState(guid, LFG_STATE_PROPOSAL);
-                    if (Player* plr = ObjectAccessor::FindPlayer(itPlayers->first))
-                    {
-                        Group *grp = plr->GetGroup();
-                        if (grp)
-                         {
-                            uint64 gguid = grp->GetGUID();
-                            SetState(gguid, LFG_STATE_PROPOSAL);
-                            plr->GetSession()->SendLfgUpdateParty(LfgUpdateData(LFG_UPDATETYPE_PROPOSAL_BEGIN, GetSelectedDungeons(guid), GetComment(guid)));
-                        }
-                        else
-                            plr->GetSession()->SendLfgUpdatePlayer(LfgUpdateData(LFG_UPDATETYPE_PROPOSAL_BEGIN, GetSelectedDungeons(guid), GetComment(guid)));
-                        plr->GetSession()->SendLfgUpdateProposal(m_lfgProposalId, pProposal);
-                    }
-                }
+    LfgMatchList matches;
+    m_matcher.TakeMatches(matches);
+    for (LfgMatchList::const_iterator itMatch = matches.begin(); itMatch != matches.end(); ++itMatch)
+    {
+        if (!IsMatchUpToDate(*itMatch))
+            continue;
 
-                if (pProposal->state == LFG_PROPOSAL_SUCCESS)
-                    UpdateProposal(m_lfgProposalId, guid, true);
+        LfgProposal* pProposal = CreateProposal(*itMatch);
+        if (!pProposal)
+            continue;
+
+        m_Proposals[++m_lfgProposalId] = pProposal;
+
+        uint64 guid = 0;
+        for (LfgProposalPlayerMap::const_iterator itPlayers = pProposal->players.begin(); itPlayers != pProposal->players.end(); ++itPlayers)
+        {
+            guid = itPlayers->first;
+            SetState(guid, LFG_STATE_PROPOSAL);
+            if (Player* plr = ObjectAccessor::FindPlayer(itPlayers->first))
+            {
+                Group *grp = plr->GetGroup();
+                if (grp)
+                 {
+                    uint64 gguid = grp->GetGUID();
+                    SetState(gguid, LFG_STATE_PROPOSAL);
+                    plr->GetSession()->SendLfgUpdateParty(LfgUpdateData(LFG_UPDATETYPE_PROPOSAL_BEGIN, GetSelectedDungeons(guid), GetComment(guid)));
+                }
+                else
+                    plr->GetSession()->SendLfgUpdatePlayer(LfgUpdateData(LFG_UPDATETYPE_PROPOSAL_BEGIN, GetSelectedDungeons(guid), GetComment(guid)));
+                plr->GetSession()->SendLfgUpdateProposal(m_lfgProposalId, pProposal);
             }
-            else
-                currentQueue.push_back(frontguid);         // Lfg group not found, add this group to the queue.
-            firstNew.clear();
         }
+
+        if (pProposal->state == LFG_PROPOSAL_SUCCESS)
+            UpdateProposal(m_lfgProposalId, guid, true);
     }
 
     // Update all players status queue info
@@ -313,6 +338,9 @@ void LFGMgr::AddToQueue(const uint64 guid, uint8 queueId)
     if (sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP))
         queueId = 0;
 
+    // matches found with an older entry of the guid are dropped
+    m_queueVersions[guid] = ++m_lastQueueVersion;
+
     LfgGuidList& list = m_newToQueue[queueId];
     if (std::find(list.begin(), list.end(), guid) != list.end())
         sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::AddToQueue: [" UI64FMTD "] already in new queue. ignoring", guid);
@@ -331,13 +359,11 @@ void LFGMgr::AddToQueue(const uint64 guid, uint8 queueId)
 */
 bool LFGMgr::RemoveFromQueue(const uint64 guid)
 {
-    for (LfgGuidListMap::iterator it = m_currentQueue.begin(); it != m_currentQueue.end(); ++it)
-        it->second.remove(guid);
-
     for (LfgGuidListMap::iterator it = m_newToQueue.begin(); it != m_newToQueue.end(); ++it)
         it->second.remove(guid);
 
-    RemoveFromCompatibles(guid);
+    m_matcher.Remove(guid);
+    m_queueVersions.erase(guid);
 
     LfgQueueInfoMap::iterator it = m_QueueInfoMap.find(guid);
     if (it != m_QueueInfoMap.end())
@@ -728,93 +754,124 @@ void LFGMgr::OfferContinue(Group* grp)
 }
 
 /**
-   Checks que main queue to try to form a Lfg group. Returns first match found (if any)
+   Takes a snapshot of a queued player or group for the matcher
 
-   @param[in]     check List of guids trying to match with other groups
-   @param[in]     all List of all other guids in main queue to match against
-   @return Pointer to proposal, if match is found
+   @param[in]     guid Player or group guid
+   @param[in]     queueId Queue the guid is added to
+   @param[out]    entry Matcher entry
+   @return false if guid is not queued
 */
-LfgProposal* LFGMgr::FindNewGroups(LfgGuidList& check, LfgGuidList& all)
+bool LFGMgr::BuildMatcherEntry(uint64 guid, uint8 queueId, LfgMatcherEntry& entry)
 {
-    sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::FindNewGroup: (%s) - all(%s)", ConcatenateGuids(check).c_str(), ConcatenateGuids(all).c_str());
+    LfgQueueInfoMap::const_iterator itQueue = m_QueueInfoMap.find(guid);
+    if (itQueue == m_QueueInfoMap.end())
+    {
+        sLog->outError("LFGMgr::BuildMatcherEntry: [" UI64FMTD "] is not queued but listed as queued!", guid);
+        m_matcher.Remove(guid);
+        return false;
+    }
 
-    LfgProposal* pProposal = NULL;
-    if (!check.size() || check.size() > MAXGROUPSIZE || !CheckCompatibility(check, pProposal))
-        return NULL;
+    LfgQueueInfo const* queue = itQueue->second;
+    entry.guid = guid;
+    std::map<uint64, uint32>::const_iterator itVersion = m_queueVersions.find(guid);
+    entry.version = itVersion != m_queueVersions.end() ? itVersion->second : 0;
+    entry.queueId = queueId;
+    entry.numPlayers = uint8(queue->roles.size());
+
+    if (IS_GROUP(guid))
+        if (Group* grp = sGroupMgr->GetGroupByGUID(GUID_LOPART(guid)))
+            entry.lfgGroup = grp->isLFGGroup();
 
-    // Try to match with queued groups
-    while (!pProposal && all.size() > 0)
+    LfgDungeonSet dungeons = queue->dungeons;
+    uint16 roles = LFG_ROLE_COMPOSITION_EMPTY;
+    for (LfgRolesMap::const_iterator it = queue->roles.begin(); it != queue->roles.end(); ++it)
     {
-        check.push_back(all.front());
-        all.pop_front();
-        pProposal = FindNewGroups(check, all);
-        check.pop_back();
+        entry.members.push_back(GUID_LOPART(it->first));
+        roles = LfgMatcher::CombineRoleCompositions(roles, LfgMatcher::RoleCompositions(it->second));
+
+        Player* plr = ObjectAccessor::FindPlayer(it->first);
+        if (!plr)
+        {
+            // never matched, as when the players were checked at each match
+            sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::BuildMatcherEntry: [" UI64FMTD "] Warning! [" UI64FMTD "] offline! Marking as not compatible!", guid, it->first);
+            roles = 0;
+            continue;
+        }
+
+        plr->GetSocial()->GetIgnores(entry.ignores);
+
+        LfgLockMap const& lockMap = GetLockedDungeons(it->first);
+        for (LfgLockMap::const_iterator itLock = lockMap.begin(); itLock != lockMap.end(); ++itLock)
+            dungeons.erase(itLock->first & 0x00FFFFFF);  // Compare dungeon ids
     }
-    return pProposal;
+
+    entry.roles = roles;
+    m_matcher.BuildDungeonBits(dungeons, entry.dungeons);
+
+    std::sort(entry.members.begin(), entry.members.end());
+    std::sort(entry.ignores.begin(), entry.ignores.end());
+    entry.ignores.erase(std::unique(entry.ignores.begin(), entry.ignores.end()), entry.ignores.end());
+    return true;
 }
 
 /**
-   Check compatibilities between groups
+   Checks that none of the groups found by the matcher left the queue or was
+   queued again since the snapshot the matcher worked on was taken; their
+   newer entry, if any, is still to be matched. The groups that did not
+   change are added to the queue again if the match is dropped.
 
-   @param[in]     check List of guids to check compatibilities
-   @param[out]    pProposal Proposal found if groups are compatibles and Match
-   @return true if group are compatibles
+   @param[in]     match Groups matched
+   @return true if the match was found with the current queue entries
 */
-bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
+bool LFGMgr::IsMatchUpToDate(LfgMatch const& match)
 {
-    if (pProposal)                                         // Do not check anything if we already have a proposal
-        return false;
-
-    std::string strGuids = ConcatenateGuids(check);
-
-    if (check.size() > MAXGROUPSIZE || check.empty())
+    std::vector<bool> current(match.versions.size());
+    bool upToDate = true;
+    uint32 i = 0;
+    for (LfgGuidList::const_iterator it = match.queues.begin(); it != match.queues.end(); ++it, ++i)
     {
-        sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::CheckCompatibility: (%s): Size wrong - Not compatibles", strGuids.c_str());
-        return false;
+        std::map<uint64, uint32>::const_iterator itVersion = m_queueVersions.find(*it);
+        current[i] = itVersion != m_queueVersions.end() && itVersion->second == match.versions[i];
+        upToDate = upToDate && current[i];
     }
 
-    if (check.size() == 1 && IS_PLAYER_GUID(check.front())) // Player joining dungeon... compatible
+    if (upToDate)
         return true;
 
-    // Previously cached?
-    LfgAnswer answer = GetCompatibles(strGuids);
-    if (answer != LFG_ANSWER_PENDING)
-    {
-        sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::CheckCompatibility: (%s) compatibles (cached): %d", strGuids.c_str(), answer);
-        return bool(answer);
-    }
+    sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::IsMatchUpToDate: (%s) queue changed since the match was found, dropped", ConcatenateGuids(match.queues).c_str());
+    i = 0;
+    for (LfgGuidList::const_iterator it = match.queues.begin(); it != match.queues.end(); ++it, ++i)
+        if (current[i])
+            AddToQueue(*it, match.queueId);
 
-    // Check all but new compatiblitity
-    if (check.size() > 2)
-    {
-        uint64 frontGuid = check.front();
-        check.pop_front();
+    return false;
+}
 
-        // Check all-but-new compatibilities (New, A, B, C, D) --> check(A, B, C, D)
-        if (!CheckCompatibility(check, pProposal))          // Group not compatible
-        {
-            sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::CheckCompatibility: (%s) not compatibles (%s not compatibles)", strGuids.c_str(), ConcatenateGuids(check).c_str());
-            SetCompatibles(strGuids, false);
-            return false;
-        }
-        check.push_front(frontGuid);
-        // all-but-new compatibles, now check with new
-    }
+/**
+   Creates the proposal for the groups found by the matcher, after checking
+   them again as they were when queued. Groups that are still queued are
+   added to the queue again if they can not be proposed anymore.
 
+   @param[in]     match Groups matched
+   @return Proposal, NULL if the match is no longer valid
+*/
+LfgProposal* LFGMgr::CreateProposal(LfgMatch const& match)
+{
+    std::string strGuids = ConcatenateGuids(match.queues);
+
+    LfgGuidList queues;
     uint8 numPlayers = 0;
     uint8 numLfgGroups = 0;
     uint32 groupLowGuid = 0;
     LfgQueueInfoMap pqInfoMap;
-    for (LfgGuidList::const_iterator it = check.begin(); it != check.end() && numLfgGroups < 2 && numPlayers <= MAXGROUPSIZE; ++it)
+    for (LfgGuidList::const_iterator it = match.queues.begin(); it != match.queues.end(); ++it)
     {
         uint64 guid = (*it);
         LfgQueueInfoMap::iterator itQueue = m_QueueInfoMap.find(guid);
-        if (itQueue == m_QueueInfoMap.end())
-        {
-            sLog->outError("LFGMgr::CheckCompatibility: [" UI64FMTD "] is not queued but listed as queued!", (*it));
-            RemoveFromQueue(guid);
-            return false;
-        }
+        if (itQueue == m_QueueInfoMap.end())               // Left the queue since the match was found
+            continue;
+
+        queues.push_back(guid);
         pqInfoMap[guid] = itQueue->second;
         numPlayers += itQueue->second->roles.size();
 
@@ -831,24 +888,12 @@ bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
         }
     }
 
-    if (check.size() == 1 && numPlayers != MAXGROUPSIZE)   // Single group with less than MAXGROUPSIZE - Compatibles
-        return true;
-
-    // Do not match - groups already in a lfgDungeon or too much players
-    if (numLfgGroups > 1 || numPlayers > MAXGROUPSIZE)
-    {
-        SetCompatibles(strGuids, false);
-        if (numLfgGroups > 1)
-            sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::CheckCompatibility: (%s) More than one Lfggroup (%u)", strGuids.c_str(), numLfgGroups);
-        else
-            sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::CheckCompatibility: (%s) Too much players (%u)", strGuids.c_str(), numPlayers);
-        return false;
-    }
+    bool valid = queues.size() == match.queues.size() && numLfgGroups <= 1 && numPlayers == MAXGROUPSIZE;
 
     // ----- Player checks -----
     LfgRolesMap rolesMap;
     uint64 leader = 0;
-    for (LfgQueueInfoMap::const_iterator it = pqInfoMap.begin(); it != pqInfoMap.end(); ++it)
+    for (LfgQueueInfoMap::const_iterator it = pqInfoMap.begin(); it != pqInfoMap.end() && valid; ++it)
     {
         for (LfgRolesMap::const_iterator itRoles = it->second->roles.begin(); itRoles != it->second->roles.end(); ++itRoles)
         {
@@ -860,15 +905,12 @@ bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
         }
     }
 
-    if (rolesMap.size() != numPlayers)                     // Player in multiples queues!
-        return false;
-
     PlayerSet players;
     for (LfgRolesMap::const_iterator it = rolesMap.begin(); it != rolesMap.end(); ++it)
     {
         Player* plr = ObjectAccessor::FindPlayer(it->first);
         if (!plr)
-            sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::CheckCompatibility: (%s) Warning! [" UI64FMTD "] offline! Marking as not compatibles!", strGuids.c_str(), it->first);
+            sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::CreateProposal: (%s) Warning! [" UI64FMTD "] offline!", strGuids.c_str(), it->first);
         else
         {
             for (PlayerSet::const_iterator itPlayer = players.begin(); itPlayer != players.end() && plr; ++itPlayer)
@@ -876,7 +918,7 @@ bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
                 // Do not form a group with ignoring candidates
                 if (plr->GetSocial()->HasIgnore((*itPlayer)->GetGUIDLow()) || (*itPlayer)->GetSocial()->HasIgnore(plr->GetGUIDLow()))
                 {
-                    sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::CheckCompatibility: (%s) Players [" UI64FMTD "] and [" UI64FMTD "] ignoring", strGuids.c_str(), (*itPlayer)->GetGUID(), plr->GetGUID());
+                    sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::CreateProposal: (%s) Players [" UI64FMTD "] and [" UI64FMTD "] ignoring", strGuids.c_str(), (*itPlayer)->GetGUID(), plr->GetGUID());
                     plr = NULL;
                 }
             }
@@ -885,48 +927,28 @@ bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
         }
     }
 
-    // if we dont have the same ammount of players then we have self ignoring candidates or different faction groups
-    // otherwise check if roles are compatible
-    if (players.size() != numPlayers || !CheckGroupRoles(rolesMap))
-    {
-        if (players.size() == numPlayers)
-            sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::CheckCompatibility: (%s) Roles not compatible", strGuids.c_str());
-        SetCompatibles(strGuids, false);
-        return false;
-    }
+    // Players in multiple queues, offline, ignoring each other or with roles not compatible
+    if (valid && (rolesMap.size() != numPlayers || players.size() != numPlayers || !CheckGroupRoles(rolesMap)))
+        valid = false;
 
     // ----- Selected Dungeon checks -----
-    // Check if there are any compatible dungeon from the selected dungeons
-    LfgDungeonSet compatibleDungeons;
-
-    LfgQueueInfoMap::const_iterator itFirst = pqInfoMap.begin();
-    for (LfgDungeonSet::const_iterator itDungeon = itFirst->second->dungeons.begin(); itDungeon != itFirst->second->dungeons.end(); ++itDungeon)
+    LfgDungeonSet compatibleDungeons = match.dungeons;
+    if (valid)
     {
-        LfgQueueInfoMap::const_iterator itOther = itFirst;
-        ++itOther;
-        while(itOther != pqInfoMap.end() && itOther->second->dungeons.find(*itDungeon) != itOther->second->dungeons.end())
-            ++itOther;
-
-        if (itOther == pqInfoMap.end())
-            compatibleDungeons.insert(*itDungeon);
+        LfgLockPartyMap lockMap;
+        GetCompatibleDungeons(compatibleDungeons, players, lockMap);
+        valid = !compatibleDungeons.empty();
     }
-    LfgLockPartyMap lockMap;
-    GetCompatibleDungeons(compatibleDungeons, players, lockMap);
 
-    if (compatibleDungeons.empty())
+    if (!valid)
     {
-        SetCompatibles(strGuids, false);
-        return false;
+        sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::CreateProposal: (%s) no longer compatibles, readding to queue", strGuids.c_str());
+        for (LfgGuidList::const_iterator it = queues.begin(); it != queues.end(); ++it)
+            AddToQueue(*it, match.queueId);
+        return NULL;
     }
-    SetCompatibles(strGuids, true);
 
-    // ----- Group is compatible, if we have MAXGROUPSIZE members then match is found
-    if (numPlayers != MAXGROUPSIZE)
-    {
-        sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::CheckCompatibility: (%s) Compatibles but not match. Players(%u)", strGuids.c_str(), numPlayers);
-        return true;
-    }
-    sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::CheckCompatibility: (%s) MATCH! Group formed", strGuids.c_str());
+    sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::CreateProposal: (%s) MATCH! Group formed", strGuids.c_str());
 
     // GROUP FORMED!
     // TODO - Improve algorithm to select proper group based on Item Level
@@ -938,10 +960,10 @@ bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
     std::advance(itDungeon, urand(0, compatibleDungeons.size() - 1));
 
     // Create a new proposal
-    pProposal = new LfgProposal(*itDungeon);
+    LfgProposal* pProposal = new LfgProposal(*itDungeon);
     pProposal->cancelTime = time_t(time(NULL)) + LFG_TIME_PROPOSAL;
     pProposal->state = LFG_PROPOSAL_INITIATING;
-    pProposal->queues = check;
+    pProposal->queues = queues;
     pProposal->groupLowGuid = groupLowGuid;
 
     // Assign new roles to players and assign new leader
@@ -975,7 +997,7 @@ bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
     if (numAccept == MAXGROUPSIZE)
         pProposal->state = LFG_PROPOSAL_SUCCESS;
 
-    return true;
+    return pProposal;
 }
 
 /**
@@ -1094,53 +1116,6 @@ void LFGMgr::UpdateRoleCheck(uint64 gguid, uint64 guid /* = 0 */, uint8 roles /*
     }
 }
 
-/**
-   Remove from cached compatible dungeons any entry that contains the given guid
-
-   @param[in]     guid Guid to remove from compatible cache
-*/
-void LFGMgr::RemoveFromCompatibles(uint64 guid)
-{
-    std::stringstream out;
-    out << guid;
-    std::string strGuid = out.str();
-
-    sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::RemoveFromCompatibles: Removing [" UI64FMTD "]", guid);
-    for (LfgCompatibleMap::iterator itNext = m_CompatibleMap.begin(); itNext != m_CompatibleMap.end();)
-    {
-        LfgCompatibleMap::iterator it = itNext++;
-        if (it->first.find(strGuid) != std::string::npos)  // Found, remove it
-            m_CompatibleMap.erase(it);
-    }
-}
-
-/**
-   Stores the compatibility of a list of guids
-
-   @param[in]     key String concatenation of guids (| used as separator)
-   @param[in]     compatibles Compatibles or not
-*/
-void LFGMgr::SetCompatibles(std::string key, bool compatibles)
-{
-    m_CompatibleMap[key] = LfgAnswer(compatibles);
-}
-
-/**
-   Get the compatibility of a group of guids
-
-   @param[in]     key String concatenation of guids (| used as separator)
-   @return 1 (Compatibles), 0 (Not compatibles), -1 (Not set)
-*/
-LfgAnswer LFGMgr::GetCompatibles(std::string key)
-{
-    LfgAnswer answer = LFG_ANSWER_PENDING;
-    LfgCompatibleMap::iterator it = m_CompatibleMap.find(key);
-    if (it != m_CompatibleMap.end())
-        answer = it->second;
-
-    return answer;
-}
-
 /**
    Given a list of dungeons remove the dungeons players have restrictions.
 
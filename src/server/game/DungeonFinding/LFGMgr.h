@@ -21,6 +21,8 @@
 #include "Common.h"
 #include <ace/Singleton.h>
 #include "LFG.h"
+#include "LFGMatcher.h"
+#include "DelayExecutor.h"
 
 class LfgGroupData;
 class LfgPlayerData;
@@ -125,13 +127,11 @@ struct LfgProposalPlayer;
 struct LfgPlayerBoot;
 
 typedef std::set<uint64> LfgGuidSet;
-typedef std::list<uint64> LfgGuidList;
 typedef std::map<uint8, LfgGuidList> LfgGuidListMap;
 typedef std::set<Player*> PlayerSet;
 typedef std::list<Player*> LfgPlayerList;
 typedef std::multimap<uint32, LfgReward const*> LfgRewardMap;
 typedef std::pair<LfgRewardMap::const_iterator, LfgRewardMap::const_iterator> LfgRewardMapBounds;
-typedef std::map<std::string, LfgAnswer> LfgCompatibleMap;
 typedef std::map<uint64, LfgDungeonSet> LfgDungeonMap;
 typedef std::map<uint64, uint8> LfgRolesMap;
 typedef std::map<uint64, LfgAnswer> LfgAnswerMap;
@@ -316,13 +316,11 @@ class LFGMgr
         void RemoveProposal(LfgProposalMap::iterator itProposal, LfgUpdateType type);
 
         // Group Matching
-        LfgProposal* FindNewGroups(LfgGuidList& check, LfgGuidList& all);
+        bool BuildMatcherEntry(uint64 guid, uint8 queueId, LfgMatcherEntry& entry);
+        bool IsMatchUpToDate(LfgMatch const& match);
+        LfgProposal* CreateProposal(LfgMatch const& match);
         bool CheckGroupRoles(LfgRolesMap &groles, bool removeLeaderFlag = true);
-        bool CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal);
         void GetCompatibleDungeons(LfgDungeonSet& dungeons, const PlayerSet& players, LfgLockPartyMap& lockMap);
-        void SetCompatibles(std::string concatenatedGuids, bool compatibles);
-        LfgAnswer GetCompatibles(std::string concatenatedGuids);
-        void RemoveFromCompatibles(uint64 guid);
 
         // Generic
         const LfgDungeonSet& GetDungeonsByRandom(uint32 randomdungeon);
@@ -333,6 +331,7 @@ class LFGMgr
         bool m_update;                                     ///< Doing an update?
         uint32 m_QueueTimer;                               ///< used to check interval of update
         uint32 m_lfgProposalId;                            ///< used as internal counter for proposals
+        uint32 m_lastQueueVersion;                         ///< used as internal counter for queue entries
         int32 m_WaitTimeAvg;                               ///< Average wait time to find a group queuing as multiple roles
         int32 m_WaitTimeTank;                              ///< Average wait time to find a group queuing as tank
         int32 m_WaitTimeHealer;                            ///< Average wait time to find a group queuing as healer
@@ -346,9 +345,10 @@ class LFGMgr
         LfgRewardMap m_RewardMap;                          ///< Stores rewards for random dungeons
         // Queue
         LfgQueueInfoMap m_QueueInfoMap;                    ///< Queued groups
-        LfgGuidListMap m_currentQueue;                     ///< Ordered list. Used to find groups
-        LfgGuidListMap m_newToQueue;                       ///< New groups to add to queue
-        LfgCompatibleMap m_CompatibleMap;                  ///< Compatible dungeons
+        LfgGuidListMap m_newToQueue;                       ///< New groups to add to the matcher
+        std::map<uint64, uint32> m_queueVersions;          ///< Current queue entry of each queued group
+        LfgMatcher m_matcher;                              ///< Queued groups waiting for a match
+        DelayExecutor m_matchWorker;                       ///< Runs the matcher when not done on the world thread
         // Rolecheck - Proposal - Vote Kicks
         LfgRoleCheckMap m_RoleChecks;                      ///< Current Role checks
         LfgProposalMap m_Proposals;                        ///< Current Proposals
@@ -252,6 +252,8 @@ Item::Item()
     m_refundRecipient = 0;
     m_paidMoney = 0;
     m_paidExtendedCost = 0;
+
+    m_updateMap = NULL;
 }
 
 bool Item::Create(uint32 guidlow, uint32 itemid, Player const* owner)
@@ -1126,6 +1128,32 @@ void Item::BuildUpdate(UpdateDataMapType& data_map)
     if (Player *owner = GetOwner())
         BuildFieldsUpdate(owner, data_map);
     ClearUpdateMask(false);
+    m_updateMap = NULL;
+}
+
+bool Item::AddToObjectUpdate()
+{
+    // owner may already be out of world here (Player::RemoveFromWorld), but its map is still set
+    Player* owner = ObjectAccessor::GetObjectInOrOutOfWorld(GetOwnerGUID(), (Player*)NULL);
+    Map* map = owner ? owner->FindMap() : NULL;
+    if (!map)
+        return false;
+
+    // still queued in the map the owner left, the map it is sent from changes
+    if (m_updateMap && m_updateMap != map)
+        m_updateMap->RemoveUpdateObject(this);
+
+    m_updateMap = map;
+    map->AddUpdateObject(this);
+    return true;
+}
+
+void Item::RemoveFromObjectUpdate()
+{
+    // the map it was queued in, the owner may have changed map or the item its owner since
+    if (m_updateMap)
+        m_updateMap->RemoveUpdateObject(this);
+    m_updateMap = NULL;
 }
 
 void Item::SaveRefundDataToDB()
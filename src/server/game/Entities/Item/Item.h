@@ -356,6 +356,8 @@ class Item : public Object
         bool CheckSoulboundTradeExpire();
 
         void BuildUpdate(UpdateDataMapType&);
+        bool AddToObjectUpdate();
+        void RemoveFromObjectUpdate();
 
         uint32 GetScriptId() const { return GetTemplate()->ScriptId; }
     private:
@@ -369,6 +371,7 @@ class Item : public Object
         uint32 m_refundRecipient;
         uint32 m_paidMoney;
         uint32 m_paidExtendedCost;
+        Map* m_updateMap;                                   // map the item is queued in for its update block
         AllowedLooterSet allowedGUIDs;
 };
 #endif
@@ -108,7 +108,6 @@ Object::~Object()
     {
         sLog->outCrash("Object::~Object - guid="UI64FMTD", typeid=%d, entry=%u deleted but still in update list!!", GetGUID(), GetTypeId(), GetEntry());
         ASSERT(false);
-        sObjectAccessor->RemoveUpdateObject(this);
     }
 
     delete [] m_uint32Values;
@@ -249,7 +248,12 @@ void Object::SendUpdateToPlayer(Player* player)
 void Object::BuildValuesUpdateBlockForPlayer(UpdateData *data, Player *target) const
 {
     ByteBuffer buf(500);
+    _BuildValuesUpdateBlock(buf, target);
+    data->AddUpdateBlock(buf);
+}
 
+void Object::_BuildValuesUpdateBlock(ByteBuffer& buf, Player* target) const
+{
     buf << (uint8) UPDATETYPE_VALUES;
     buf.append(GetPackGUID());
 
@@ -258,8 +262,51 @@ void Object::BuildValuesUpdateBlockForPlayer(UpdateData *data, Player *target) c
 
     _SetUpdateBits(&updateMask, target);
     _BuildValuesUpdate(UPDATETYPE_VALUES, &buf, &updateMask, target);
+}
 
-    data->AddUpdateBlock(buf);
+// must follow the viewer dependent cases of _SetUpdateBits and _BuildValuesUpdate for UPDATETYPE_VALUES
+UpdateViewClass Object::GetValuesUpdateViewClass(Player* target) const
+{
+    if (target == this)
+        return UPDATE_VIEW_SELF;
+
+    if (isType(TYPEMASK_GAMEOBJECT))
+    {
+        GameObject const* go = (GameObject const*)this;
+        if (go->IsTransport())
+            return UPDATE_VIEW_PLAYER;
+
+        // GAMEOBJECT_DYNAMIC is always sent
+        if (target->isGameMaster())
+            return UPDATE_VIEW_GAMEMASTER;
+
+        return go->ActivateToQuest(target) ? UPDATE_VIEW_QUEST : UPDATE_VIEW_PLAYER;
+    }
+
+    if (!isType(TYPEMASK_UNIT))
+        return UPDATE_VIEW_PLAYER;
+
+    Unit const* unit = (Unit const*)this;
+
+    // UNIT_FIELD_AURASTATE is always sent then, with the states of the auras cast by the viewer
+    if (unit->HasFlag(UNIT_FIELD_AURASTATE, PER_CASTER_AURA_STATE_MASK))
+        return UPDATE_VIEW_PER_TARGET;
+
+    if (Creature const* creature = ToCreature())
+    {
+        if (_IsValueChanged(UNIT_NPC_FLAGS) && HasFlag(UNIT_NPC_FLAGS, UNIT_NPC_FLAG_SPELLCLICK | UNIT_NPC_FLAG_TRAINER))
+            return UPDATE_VIEW_PER_TARGET;
+
+        if (_IsValueChanged(UNIT_DYNAMIC_FLAGS) && (creature->hasLootRecipient() || HasFlag(UNIT_DYNAMIC_FLAGS, UNIT_DYNFLAG_LOOTABLE)))
+            return UPDATE_VIEW_PER_TARGET;
+    }
+
+    if ((_IsValueChanged(UNIT_FIELD_BYTES_2) || _IsValueChanged(UNIT_FIELD_FACTIONTEMPLATE)) &&
+        unit->IsControlledByPlayer() && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP))
+        return UPDATE_VIEW_PER_TARGET;
+
+    // UNIT_FIELD_FLAGS and the display of triggers
+    return target->isGameMaster() ? UPDATE_VIEW_GAMEMASTER : UPDATE_VIEW_PLAYER;
 }
 
 void Object::BuildOutOfRangeUpdateBlock(UpdateData * data) const
@@ -744,12 +791,12 @@ void Object::ClearUpdateMask(bool remove)
     if (m_objectUpdated)
     {
         if (remove)
-            sObjectAccessor->RemoveUpdateObject(this);
+            RemoveFromObjectUpdate();
         m_objectUpdated = false;
     }
 }
 
-void Object::BuildFieldsUpdate(Player *pl, UpdateDataMapType &data_map) const
+void Object::BuildFieldsUpdate(Player *pl, UpdateDataMapType &data_map, ValuesUpdateBlockCache* cache) const
 {
     UpdateDataMapType::iterator iter = data_map.find(pl);
 
@@ -760,7 +807,18 @@ void Object::BuildFieldsUpdate(Player *pl, UpdateDataMapType &data_map) const
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    UpdateViewClass viewClass = cache ? GetValuesUpdateViewClass(pl) : UPDATE_VIEW_PER_TARGET;
+    if (viewClass == UPDATE_VIEW_PER_TARGET)
+    {
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+        return;
+    }
+
+    ByteBuffer& block = cache->blocks[viewClass];
+    if (block.empty())
+        _BuildValuesUpdateBlock(block, pl);
+
+    iter->second.AddUpdateBlock(block);
 }
 
 void Object::_LoadIntoDataField(const char* data, uint32 startOffset, uint32 count)
@@ -811,10 +869,7 @@ void Object::SetInt32Value(uint16 index, int32 value)
         if (m_inWorld)
         {
             if (!m_objectUpdated)
-            {
-                sObjectAccessor->AddUpdateObject(this);
-                m_objectUpdated = true;
-            }
+                m_objectUpdated = AddToObjectUpdate();
         }
     }
 }
@@ -830,10 +885,7 @@ void Object::SetUInt32Value(uint16 index, uint32 value)
         if (m_inWorld)
         {
             if (!m_objectUpdated)
-            {
-                sObjectAccessor->AddUpdateObject(this);
-                m_objectUpdated = true;
-            }
+                m_objectUpdated = AddToObjectUpdate();
         }
     }
 }
@@ -856,10 +908,7 @@ void Object::SetUInt64Value(uint16 index, const uint64 value)
         if (m_inWorld)
         {
             if (!m_objectUpdated)
-            {
-                sObjectAccessor->AddUpdateObject(this);
-                m_objectUpdated = true;
-            }
+                m_objectUpdated = AddToObjectUpdate();
         }
     }
 }
@@ -875,10 +924,7 @@ bool Object::AddUInt64Value(uint16 index, const uint64 value)
         if (m_inWorld)
         {
             if (!m_objectUpdated)
-            {
-                sObjectAccessor->AddUpdateObject(this);
-                m_objectUpdated = true;
-            }
+                m_objectUpdated = AddToObjectUpdate();
         }
         return true;
     }
@@ -896,10 +942,7 @@ bool Object::RemoveUInt64Value(uint16 index, const uint64 value)
         if (m_inWorld)
         {
             if (!m_objectUpdated)
-            {
-                sObjectAccessor->AddUpdateObject(this);
-                m_objectUpdated = true;
-            }
+                m_objectUpdated = AddToObjectUpdate();
         }
         return true;
     }
@@ -917,10 +960,7 @@ void Object::SetFloatValue(uint16 index, float value)
         if (m_inWorld)
         {
             if (!m_objectUpdated)
-            {
-                sObjectAccessor->AddUpdateObject(this);
-                m_objectUpdated = true;
-            }
+                m_objectUpdated = AddToObjectUpdate();
         }
     }
 }
@@ -943,10 +983,7 @@ void Object::SetByteValue(uint16 index, uint8 offset, uint8 value)
         if (m_inWorld)
         {
             if (!m_objectUpdated)
-            {
-                sObjectAccessor->AddUpdateObject(this);
-                m_objectUpdated = true;
-            }
+                m_objectUpdated = AddToObjectUpdate();
         }
     }
 }
@@ -969,10 +1006,7 @@ void Object::SetUInt16Value(uint16 index, uint8 offset, uint16 value)
         if (m_inWorld)
         {
             if (!m_objectUpdated)
-            {
-                sObjectAccessor->AddUpdateObject(this);
-                m_objectUpdated = true;
-            }
+                m_objectUpdated = AddToObjectUpdate();
         }
     }
 }
@@ -1038,10 +1072,7 @@ void Object::SetFlag(uint16 index, uint32 newFlag)
         if (m_inWorld)
         {
             if (!m_objectUpdated)
-            {
-                sObjectAccessor->AddUpdateObject(this);
-                m_objectUpdated = true;
-            }
+                m_objectUpdated = AddToObjectUpdate();
         }
     }
 }
@@ -1061,10 +1092,7 @@ void Object::RemoveFlag(uint16 index, uint32 oldFlag)
         if (m_inWorld)
         {
             if (!m_objectUpdated)
-            {
-                sObjectAccessor->AddUpdateObject(this);
-                m_objectUpdated = true;
-            }
+                m_objectUpdated = AddToObjectUpdate();
         }
     }
 }
@@ -1086,10 +1114,7 @@ void Object::SetByteFlag(uint16 index, uint8 offset, uint8 newFlag)
         if (m_inWorld)
         {
             if (!m_objectUpdated)
-            {
-                sObjectAccessor->AddUpdateObject(this);
-                m_objectUpdated = true;
-            }
+                m_objectUpdated = AddToObjectUpdate();
         }
     }
 }
@@ -1111,10 +1136,7 @@ void Object::RemoveByteFlag(uint16 index, uint8 offset, uint8 oldFlag)
         if (m_inWorld)
         {
             if (!m_objectUpdated)
-            {
-                sObjectAccessor->AddUpdateObject(this);
-                m_objectUpdated = true;
-            }
+                m_objectUpdated = AddToObjectUpdate();
         }
     }
 }
@@ -1830,10 +1852,7 @@ void Object::ForceValuesUpdateAtIndex(uint32 i)
     if (m_inWorld)
     {
         if (!m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+            m_objectUpdated = AddToObjectUpdate();
     }
 }
 
@@ -2767,6 +2786,7 @@ struct WorldObjectChangeAccumulator
     UpdateDataMapType &i_updateDatas;
     WorldObject &i_object;
     std::set<uint64> plr_list;
+    ValuesUpdateBlockCache i_blocks;                        // most viewers share the same block
     WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d) : i_updateDatas(d), i_object(obj) {}
     void Visit(PlayerMapType &m)
     {
@@ -2813,7 +2833,7 @@ struct WorldObjectChangeAccumulator
         // Only send update once to a player
         if (plr_list.find(plr->GetGUID()) == plr_list.end() && plr->HaveAtClient(&i_object))
         {
-            i_object.BuildFieldsUpdate(plr, i_updateDatas);
+            i_object.BuildFieldsUpdate(plr, i_updateDatas, &i_blocks);
             plr_list.insert(plr->GetGUID());
         }
     }
@@ -2836,6 +2856,17 @@ void WorldObject::BuildUpdate(UpdateDataMapType& data_map)
     ClearUpdateMask(false);
 }
 
+bool WorldObject::AddToObjectUpdate()
+{
+    GetMap()->AddUpdateObject(this);
+    return true;
+}
+
+void WorldObject::RemoveFromObjectUpdate()
+{
+    GetMap()->RemoveUpdateObject(this);
+}
+
 uint64 WorldObject::GetTransGUID() const
 {
     if (GetTransport())
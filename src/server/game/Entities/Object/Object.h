@@ -119,6 +119,23 @@ class Transport;
 
 typedef UNORDERED_MAP<Player*, UpdateData> UpdateDataMapType;
 
+// viewers in the same class get byte-identical values update blocks of an object
+enum UpdateViewClass
+{
+    UPDATE_VIEW_PLAYER          = 0,                        // any other player
+    UPDATE_VIEW_GAMEMASTER      = 1,
+    UPDATE_VIEW_QUEST           = 2,                        // gameobject activated for a quest of the viewer
+    UPDATE_VIEW_SELF            = 3,                        // player viewing itself, sees all its fields
+    MAX_UPDATE_VIEW_CLASSES     = 4,
+    UPDATE_VIEW_PER_TARGET      = MAX_UPDATE_VIEW_CLASSES   // changed fields depend on the viewer itself
+};
+
+// values update blocks of an object built during one update, by view class
+struct ValuesUpdateBlockCache
+{
+    ByteBuffer blocks[MAX_UPDATE_VIEW_CLASSES];             // empty until built for a viewer of the class
+};
+
 class Object
 {
     public:
@@ -314,7 +331,12 @@ class Object
         virtual bool hasQuest(uint32 /* quest_id */) const { return false; }
         virtual bool hasInvolvedQuest(uint32 /* quest_id */) const { return false; }
         virtual void BuildUpdate(UpdateDataMapType&) {}
-        void BuildFieldsUpdate(Player *, UpdateDataMapType &) const;
+        void BuildFieldsUpdate(Player *, UpdateDataMapType &, ValuesUpdateBlockCache* cache = NULL) const;
+        UpdateViewClass GetValuesUpdateViewClass(Player* target) const;
+
+        // queue/unqueue the object in the update list of the map it is sent from, false if there is none yet
+        virtual bool AddToObjectUpdate() = 0;
+        virtual void RemoveFromObjectUpdate() = 0;
 
         // FG: some hacky helpers
         void ForceValuesUpdateAtIndex(uint32);
@@ -342,6 +364,8 @@ class Object
         virtual void _SetCreateBits(UpdateMask *updateMask, Player *target) const;
         void _BuildMovementUpdate(ByteBuffer * data, uint16 flags) const;
         void _BuildValuesUpdate(uint8 updatetype, ByteBuffer *data, UpdateMask *updateMask, Player *target) const;
+        void _BuildValuesUpdateBlock(ByteBuffer& buf, Player* target) const;
+        bool _IsValueChanged(uint16 index) const { return m_uint32Values[index] != m_uint32Values_mirror[index]; }
 
         uint16 m_objectType;
 
@@ -812,6 +836,8 @@ class WorldObject : public Object, public WorldLocation
         void DestroyForNearbyPlayers();
         virtual void UpdateObjectVisibility(bool forced = true);
         void BuildUpdate(UpdateDataMapType&);
+        bool AddToObjectUpdate();
+        void RemoveFromObjectUpdate();
 
         //relocation and visibility system functions
         void AddToNotify(uint16 f) { m_notifyflags |= f;}
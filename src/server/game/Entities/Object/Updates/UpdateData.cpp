@@ -25,10 +25,153 @@
 #include "World.h"
 #include "zlib.h"
 
+#include <ace/TSS_T.h>
+#include <ace/Guard_T.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/OS_NS_sys_time.h>
+
+// packets counted by a thread before they are added to the totals
+#define COMPRESSION_STATISTICS_FLUSH 64
+
+static ACE_Thread_Mutex s_compressionStatisticsLock;
+static uint64 s_compressedPackets = 0;
+static uint64 s_compressedInBytes = 0;
+static uint64 s_compressedOutBytes = 0;
+static uint64 s_compressionTime = 0;                        // microseconds
+
+// deflate state of a thread that builds update packets, reset between packets instead of initialized for each
+class UpdateCompressor
+{
+    public:
+        UpdateCompressor() : m_level(0), m_packets(0), m_inBytes(0), m_outBytes(0), m_time(0)
+        {
+            m_stream.zalloc = (alloc_func)0;
+            m_stream.zfree = (free_func)0;
+            m_stream.opaque = (voidpf)0;
+        }
+
+        ~UpdateCompressor()
+        {
+            if (m_level)
+                deflateEnd(&m_stream);
+
+            FlushStatistics();
+        }
+
+        // stream ready to compress a new packet with the given level, NULL on error
+        z_stream* GetStream(int level)
+        {
+            if (!m_level)
+            {
+                int z_res = deflateInit(&m_stream, level);
+                if (z_res != Z_OK)
+                {
+                    sLog->outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
+                    return NULL;
+                }
+
+                m_level = level;
+                return &m_stream;
+            }
+
+            int z_res = deflateReset(&m_stream);
+            if (z_res != Z_OK)
+            {
+                sLog->outError("Can't compress update packet (zlib: deflateReset) Error code: %i (%s)", z_res, zError(z_res));
+                deflateEnd(&m_stream);
+                m_level = 0;
+                return NULL;
+            }
+
+            if (level != m_level)
+            {
+                // nothing was fed to the stream since the reset, so this only switches the parameters
+                z_res = deflateParams(&m_stream, level, Z_DEFAULT_STRATEGY);
+                if (z_res != Z_OK)
+                {
+                    sLog->outError("Can't compress update packet (zlib: deflateParams) Error code: %i (%s)", z_res, zError(z_res));
+                    deflateEnd(&m_stream);
+                    m_level = 0;
+                    return NULL;
+                }
+
+                m_level = level;
+            }
+
+            return &m_stream;
+        }
+
+        void CountPacket(uint32 inBytes, uint32 outBytes, uint64 time)
+        {
+            ++m_packets;
+            m_inBytes += inBytes;
+            m_outBytes += outBytes;
+            m_time += time;
+
+            if (m_packets >= COMPRESSION_STATISTICS_FLUSH)
+                FlushStatistics();
+        }
+
+    private:
+        void FlushStatistics()
+        {
+            if (!m_packets)
+                return;
+
+            ACE_GUARD(ACE_Thread_Mutex, guard, s_compressionStatisticsLock);
+            s_compressedPackets += m_packets;
+            s_compressedInBytes += m_inBytes;
+            s_compressedOutBytes += m_outBytes;
+            s_compressionTime += m_time;
+
+            m_packets = 0;
+            m_inBytes = 0;
+            m_outBytes = 0;
+            m_time = 0;
+        }
+
+        z_stream m_stream;
+        int m_level;                                        // 0 while the stream is not initialized
+
+        uint32 m_packets;
+        uint64 m_inBytes;
+        uint64 m_outBytes;
+        uint64 m_time;
+};
+
+typedef ACE_TSS<UpdateCompressor> UpdateCompressorTSS;
+static UpdateCompressorTSS updateCompressor;
+
+// the configured level, lowered to Z_BEST_SPEED for small packets and while the world update runs late
+static int GetCompressionLevel(int size)
+{
+    int level = int(sWorld->getIntConfig(CONFIG_COMPRESSION));
+    if (level == Z_BEST_SPEED)
+        return level;
+
+    if (size < int(sWorld->getIntConfig(CONFIG_COMPRESSION_ADAPTIVE_MIN_SIZE)))
+        return Z_BEST_SPEED;
+
+    uint32 maxDiff = sWorld->getIntConfig(CONFIG_COMPRESSION_ADAPTIVE_MAX_DIFF);
+    if (maxDiff && sWorld->GetUpdateTime() > maxDiff)
+        return Z_BEST_SPEED;
+
+    return level;
+}
+
 UpdateData::UpdateData() : m_blockCount(0)
 {
 }
 
+void UpdateData::GetCompressionStatistics(uint64& packets, uint64& inBytes, uint64& outBytes, uint64& time)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, s_compressionStatisticsLock);
+    packets = s_compressedPackets;
+    inBytes = s_compressedInBytes;
+    outBytes = s_compressedOutBytes;
+    time = s_compressionTime;
+}
+
 void UpdateData::AddOutOfRangeGUID(std::set<uint64>& guids)
 {
     m_outOfRangeGUIDs.insert(guids.begin(), guids.end());
@@ -47,27 +190,21 @@ void UpdateData::AddUpdateBlock(const ByteBuffer &block)
 
 void UpdateData::Compress(void* dst, uint32 *dst_size, void* src, int src_size)
 {
-    z_stream c_stream;
-
-    c_stream.zalloc = (alloc_func)0;
-    c_stream.zfree = (free_func)0;
-    c_stream.opaque = (voidpf)0;
+    ACE_Time_Value startTime = ACE_OS::gettimeofday();
 
-    // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld->getIntConfig(CONFIG_COMPRESSION));
-    if (z_res != Z_OK)
+    z_stream* c_stream = updateCompressor->GetStream(GetCompressionLevel(src_size));
+    if (!c_stream)
     {
-        sLog->outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
         *dst_size = 0;
         return;
     }
 
-    c_stream.next_out = (Bytef*)dst;
-    c_stream.avail_out = *dst_size;
-    c_stream.next_in = (Bytef*)src;
-    c_stream.avail_in = (uInt)src_size;
+    c_stream->next_out = (Bytef*)dst;
+    c_stream->avail_out = *dst_size;
+    c_stream->next_in = (Bytef*)src;
+    c_stream->avail_in = (uInt)src_size;
 
-    z_res = deflate(&c_stream, Z_NO_FLUSH);
+    int z_res = deflate(c_stream, Z_NO_FLUSH);
     if (z_res != Z_OK)
     {
         sLog->outError("Can't compress update packet (zlib: deflate) Error code: %i (%s)", z_res, zError(z_res));
@@ -75,14 +212,14 @@ void UpdateData::Compress(void* dst, uint32 *dst_size, void* src, int src_size)
         return;
     }
 
-    if (c_stream.avail_in != 0)
+    if (c_stream->avail_in != 0)
     {
         sLog->outError("Can't compress update packet (zlib: deflate not greedy)");
         *dst_size = 0;
         return;
     }
 
-    z_res = deflate(&c_stream, Z_FINISH);
+    z_res = deflate(c_stream, Z_FINISH);
     if (z_res != Z_STREAM_END)
     {
         sLog->outError("Can't compress update packet (zlib: deflate should report Z_STREAM_END instead %i (%s)", z_res, zError(z_res));
@@ -90,15 +227,10 @@ void UpdateData::Compress(void* dst, uint32 *dst_size, void* src, int src_size)
         return;
     }
 
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
-    {
-        sLog->outError("Can't compress update packet (zlib: deflateEnd) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+    *dst_size = c_stream->total_out;
 
-    *dst_size = c_stream.total_out;
+    ACE_Time_Value spent = ACE_OS::gettimeofday() - startTime;
+    updateCompressor->CountPacket(uint32(src_size), *dst_size, uint64(spent.sec()) * 1000000 + spent.usec());
 }
 
 bool UpdateData::BuildPacket(WorldPacket* packet)
@@ -61,6 +61,9 @@ class UpdateData
 
         std::set<uint64> const& GetOutOfRangeGUIDs() const { return m_outOfRangeGUIDs; }
 
+        // totals over all compressed update packets, time in microseconds
+        static void GetCompressionStatistics(uint64& packets, uint64& inBytes, uint64& outBytes, uint64& time);
+
     protected:
         uint32 m_blockCount;
         std::set<uint64> m_outOfRangeGUIDs;
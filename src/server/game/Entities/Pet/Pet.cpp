@@ -93,15 +93,18 @@ void Pet::RemoveFromWorld()
     }
 }
 
-bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool current)
+bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool current, SQLQueryHolder* holder)
 {
     m_loading = true;
 
     uint32 ownerid = owner->GetGUIDLow();
 
     QueryResult result;
+    PreparedQueryResult loginResult;                        // current pet (slot 0), loaded at login
 
-    if (petnumber)
+    if (holder)
+        loginResult = holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOADPET);
+    else if (petnumber)
         // known petnumber entry                  0   1      2(?)   3        4      5    6           7     8     9        10         11       12            13      14        15              16
         result = CharacterDatabase.PQuery("SELECT id, entry, owner, modelid, level, exp, Reactstate, slot, name, renamed, curhealth, curmana, curhappiness, abdata, savetime, CreatedBySpell, PetType "
             "FROM character_pet WHERE owner = '%u' AND id = '%u'",
@@ -124,13 +127,13 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
             "FROM character_pet WHERE owner = '%u' AND (slot = '%u' OR slot > '%u') ",
             ownerid, PET_SAVE_AS_CURRENT, PET_SAVE_LAST_STABLE_SLOT);
 
-    if (!result)
+    if (!result && !loginResult)
     {
         m_loading = false;
         return false;
     }
 
-    Field *fields = result->Fetch();
+    Field *fields = loginResult ? loginResult->Fetch() : result->Fetch();
 
     // update for case of current pet "slot = 0"
     petentry = fields[1].GetUInt32();
@@ -284,16 +287,37 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
     InitTalentForLevel();                                   // set original talents points before spell loading
 
     uint32 timediff = uint32(time(NULL) - fields[14].GetUInt32());
-    _LoadAuras(timediff);
+    if (holder)
+        _LoadAuras(holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOADPETAURAS), timediff);
+    else
+    {
+        PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_LOAD_PET_AURAS);
+        stmt->setUInt32(0, pet_number);
+        _LoadAuras(CharacterDatabase.Query(stmt), timediff);
+    }
 
     // load action bar, if data broken will fill later by default spells.
     if (!is_temporary_summoned)
     {
         m_charmInfo->LoadPetActionBar(fields[13].GetString());
 
-        _LoadSpells();
+        if (holder)
+            _LoadSpells(holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOADPETSPELLS));
+        else
+        {
+            PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_LOAD_PET_SPELLS);
+            stmt->setUInt32(0, pet_number);
+            _LoadSpells(CharacterDatabase.Query(stmt));
+        }
         InitTalentForLevel();                               // re-init to check talent count
-        _LoadSpellCooldowns();
+        if (holder)
+            _LoadSpellCooldowns(holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOADPETSPELLCOOLDOWNS));
+        else
+        {
+            PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_LOAD_PET_SPELL_COOLDOWNS);
+            stmt->setUInt32(0, pet_number);
+            _LoadSpellCooldowns(CharacterDatabase.Query(stmt));
+        }
         LearnPetPassives();
         InitLevelupSpellsForLevel();
         CastPetAuras(current);
@@ -312,13 +336,18 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
 
     if (getPetType() == HUNTER_PET)
     {
-        result = CharacterDatabase.PQuery("SELECT genitive, dative, accusative, instrumental, prepositional FROM character_pet_declinedname WHERE owner = '%u' AND id = '%u'", owner->GetGUIDLow(), GetCharmInfo()->GetPetNumber());
+        QueryResult declinedResult;
+        PreparedQueryResult loginDeclinedResult;
+        if (holder)
+            loginDeclinedResult = holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOADPETDECLINEDNAMES);
+        else
+            declinedResult = CharacterDatabase.PQuery("SELECT genitive, dative, accusative, instrumental, prepositional FROM character_pet_declinedname WHERE owner = '%u' AND id = '%u'", owner->GetGUIDLow(), GetCharmInfo()->GetPetNumber());
 
-        if (result)
+        if (declinedResult || loginDeclinedResult)
         {
             delete m_declinedname;
             m_declinedname = new DeclinedName;
-            Field *fields2 = result->Fetch();
+            Field *fields2 = loginDeclinedResult ? loginDeclinedResult->Fetch() : declinedResult->Fetch();
             for (uint8 i = 0; i < MAX_DECLINED_NAME_CASES; ++i)
             {
                 m_declinedname->name[i] = fields2[i].GetString();
@@ -1033,13 +1062,11 @@ uint32 Pet::GetCurrentFoodBenefitLevel(uint32 itemlevel)
         return 0;                                           //food too low level
 }
 
-void Pet::_LoadSpellCooldowns()
+void Pet::_LoadSpellCooldowns(PreparedQueryResult result)
 {
     m_CreatureSpellCooldowns.clear();
     m_CreatureCategoryCooldowns.clear();
 
-    QueryResult result = CharacterDatabase.PQuery("SELECT spell, time FROM pet_spell_cooldown WHERE guid = '%u'", m_charmInfo->GetPetNumber());
-
     if (result)
     {
         time_t curTime = time(NULL);
@@ -1098,10 +1125,8 @@ void Pet::_SaveSpellCooldowns(SQLTransaction& trans)
     }
 }
 
-void Pet::_LoadSpells()
+void Pet::_LoadSpells(PreparedQueryResult result)
 {
-    QueryResult result = CharacterDatabase.PQuery("SELECT spell, active FROM pet_spell WHERE guid = '%u'", m_charmInfo->GetPetNumber());
-
     if (result)
     {
         do
@@ -1144,12 +1169,10 @@ void Pet::_SaveSpells(SQLTransaction& trans)
     }
 }
 
-void Pet::_LoadAuras(uint32 timediff)
+void Pet::_LoadAuras(PreparedQueryResult result, uint32 timediff)
 {
     sLog->outDebug(LOG_FILTER_PETS, "Loading auras for pet %u", GetGUIDLow());
 
-    QueryResult result = CharacterDatabase.PQuery("SELECT caster_guid, spell, effect_mask, recalculate_mask, stackcount, amount0, amount1, amount2, base_amount0, base_amount1, base_amount2, maxduration, remaintime, remaincharges FROM pet_aura WHERE guid = '%u'", m_charmInfo->GetPetNumber());
-
     if (result)
     {
         do
@@ -0,0 +1,253 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_CLIENTGUIDSET_H
+#define TRINITY_CLIENTGUIDSET_H
+
+#include "Common.h"
+#include "Errors.h"
+
+#include <iterator>
+
+/*
+ * Guids of the objects a player has at client (Player::ClientGUIDs).
+ *
+ * Open addressed with linear probing in a single array, so looking up the
+ * objects of a crowded cell touches no tree nodes. Besides the guid, every
+ * slot keeps the visibility pass it was last seen in: a visibility update
+ * calls BeginPass(), marks what the grid visit reaches and then takes the
+ * guids left unmarked, which are the ones out of range, instead of copying
+ * the whole set up front and erasing what was reached from the copy.
+ * Guids inserted during a pass count as seen in it.
+ *
+ * Iterators are invalidated by insert and erase, like the ones of an
+ * unordered set; the order of iteration is unspecified.
+ */
+class ClientGUIDSet
+{
+    public:
+        class const_iterator
+        {
+            public:
+                typedef std::forward_iterator_tag iterator_category;
+                typedef uint64 value_type;
+                typedef ptrdiff_t difference_type;
+                typedef uint64 const* pointer;
+                typedef uint64 const& reference;
+
+                const_iterator() : m_set(NULL), m_index(0) { }
+
+                reference operator*() const { return m_set->m_slots[m_index].guid; }
+
+                const_iterator& operator++()
+                {
+                    m_index = m_set->NextIndex(m_index + 1);
+                    return *this;
+                }
+
+                const_iterator operator++(int)
+                {
+                    const_iterator itr = *this;
+                    ++(*this);
+                    return itr;
+                }
+
+                bool operator==(const_iterator const& right) const { return m_index == right.m_index && m_set == right.m_set; }
+                bool operator!=(const_iterator const& right) const { return !(*this == right); }
+
+            private:
+                friend class ClientGUIDSet;
+
+                const_iterator(ClientGUIDSet const* set, uint32 index) : m_set(set), m_index(index) { }
+
+                ClientGUIDSet const* m_set;
+                uint32 m_index;
+        };
+
+        typedef const_iterator iterator;
+
+        ClientGUIDSet() : m_slots(NULL), m_capacity(0), m_size(0), m_pass(1) { }
+        ~ClientGUIDSet() { free(m_slots); }
+
+        const_iterator begin() const { return const_iterator(this, NextIndex(0)); }
+        const_iterator end() const { return const_iterator(this, m_capacity); }
+
+        bool empty() const { return m_size == 0; }
+        size_t size() const { return m_size; }
+        size_t count(uint64 guid) const { return FindIndex(guid) != m_capacity ? 1 : 0; }
+
+        // returns whether the guid was not in the set yet
+        bool insert(uint64 guid)
+        {
+            ASSERT(guid);
+            if ((m_size + 1) * 2 > m_capacity)
+                Rehash(m_capacity ? m_capacity * 2 : 16);
+
+            uint32 index = HomeIndex(guid);
+            while (m_slots[index].guid)
+            {
+                if (m_slots[index].guid == guid)
+                    return false;
+                index = (index + 1) & (m_capacity - 1);
+            }
+
+            m_slots[index].guid = guid;
+            m_slots[index].pass = m_pass;
+            ++m_size;
+            return true;
+        }
+
+        size_t erase(uint64 guid)
+        {
+            uint32 index = FindIndex(guid);
+            if (index == m_capacity)
+                return 0;
+
+            EraseIndex(index);
+            return 1;
+        }
+
+        // keeps the allocated slots, a player entering a map fills them again right away
+        void clear()
+        {
+            if (m_slots)
+                memset(m_slots, 0, m_capacity * sizeof(Slot));
+            m_size = 0;
+        }
+
+        // starts a visibility pass, every guid is unmarked after it
+        void BeginPass()
+        {
+            if (++m_pass)
+                return;
+
+            // wrapped around, drop the stamps of the old passes
+            for (uint32 i = 0; i < m_capacity; ++i)
+                m_slots[i].pass = 0;
+            m_pass = 1;
+        }
+
+        // returns false if the guid is not in the set or was already marked in this pass
+        bool Mark(uint64 guid)
+        {
+            uint32 index = FindIndex(guid);
+            if (index == m_capacity || m_slots[index].pass == m_pass)
+                return false;
+
+            m_slots[index].pass = m_pass;
+            return true;
+        }
+
+        // removes the guids not marked in this pass, appending them to guids
+        void TakeUnmarked(std::vector<uint64>& guids)
+        {
+            size_t first = guids.size();
+            for (uint32 i = 0; i < m_capacity; ++i)
+                if (m_slots[i].guid && m_slots[i].pass != m_pass)
+                    guids.push_back(m_slots[i].guid);
+
+            // erasing shifts slots back, so it can not be done while scanning
+            for (size_t i = first; i < guids.size(); ++i)
+                erase(guids[i]);
+        }
+
+    private:
+        // not copyable, the visibility notifiers work on the set of the player itself
+        ClientGUIDSet(ClientGUIDSet const&);
+        ClientGUIDSet& operator=(ClientGUIDSet const&);
+
+        struct Slot
+        {
+            uint64 guid;                                    // 0 for an empty slot
+            uint32 pass;                                    // last pass the guid was seen in
+        };
+
+        // guids of a type share the high part and mostly differ in the low bits, spread them
+        uint32 HomeIndex(uint64 guid) const { return uint32((guid * UI64LIT(0x9E3779B97F4A7C15)) >> 32) & (m_capacity - 1); }
+
+        uint32 FindIndex(uint64 guid) const
+        {
+            if (!m_size)
+                return m_capacity;
+
+            uint32 index = HomeIndex(guid);
+            while (m_slots[index].guid)
+            {
+                if (m_slots[index].guid == guid)
+                    return index;
+                index = (index + 1) & (m_capacity - 1);
+            }
+            return m_capacity;
+        }
+
+        uint32 NextIndex(uint32 index) const
+        {
+            while (index < m_capacity && !m_slots[index].guid)
+                ++index;
+            return index;
+        }
+
+        // backward shift deletion, no tombstones are left behind
+        void EraseIndex(uint32 hole)
+        {
+            uint32 mask = m_capacity - 1;
+            for (uint32 index = (hole + 1) & mask; m_slots[index].guid; index = (index + 1) & mask)
+            {
+                // an entry can fill the hole if the hole lies between its home slot and it
+                uint32 home = HomeIndex(m_slots[index].guid);
+                if (((index - home) & mask) >= ((index - hole) & mask))
+                {
+                    m_slots[hole] = m_slots[index];
+                    hole = index;
+                }
+            }
+
+            m_slots[hole].guid = 0;
+            m_slots[hole].pass = 0;
+            --m_size;
+        }
+
+        void Rehash(uint32 capacity)
+        {
+            Slot* slots = m_slots;
+            uint32 oldCapacity = m_capacity;
+
+            m_slots = (Slot*)calloc(capacity, sizeof(Slot));
+            ASSERT(m_slots);
+            m_capacity = capacity;
+
+            for (uint32 i = 0; i < oldCapacity; ++i)
+            {
+                if (!slots[i].guid)
+                    continue;
+
+                uint32 index = HomeIndex(slots[i].guid);
+                while (m_slots[index].guid)
+                    index = (index + 1) & (capacity - 1);
+                m_slots[index] = slots[i];
+            }
+
+            free(slots);
+        }
+
+        Slot* m_slots;
+        uint32 m_capacity;                                  // power of two, at most half of the slots are used
+        uint32 m_size;
+        uint32 m_pass;
+};
+
+#endif
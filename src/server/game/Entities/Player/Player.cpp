@@ -4765,6 +4765,8 @@ void Player::DeleteFromDB(uint64 playerguid, uint32 accountId, bool updateRealmC
 
     uint32 guid = GUID_LOPART(playerguid);
 
+    sObjectMgr->RemoveCharacterNameCache(guid);
+
     // convert corpse to bones if exist (to prevent exiting Corpse in World without DB entry)
     // bones will be deleted by corpse/bones deleting thread shortly
     sObjectAccessor->ConvertCorpseForPlayer(playerguid);
@@ -17076,7 +17078,7 @@ bool Player::LoadFromDB(uint32 guid, SQLQueryHolder *holder)
     // must be before inventory (some items required reputation check)
     m_reputationMgr.LoadFromDB(holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOADREPUTATION));
 
-    _LoadInventory(holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOADINVENTORY), time_diff);
+    _LoadInventory(holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOADINVENTORY), holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOADITEMREFUNDS), holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOADITEMBOPTRADE), time_diff);
 
     // update items with duration and realtime
     UpdateItemDuration(time_diff, true);
@@ -17382,7 +17384,7 @@ void Player::LoadCorpse()
     }
 }
 
-void Player::_LoadInventory(PreparedQueryResult result, uint32 timeDiff)
+void Player::_LoadInventory(PreparedQueryResult result, PreparedQueryResult resultRefunds, PreparedQueryResult resultBopTrade, uint32 timeDiff)
 {
     //QueryResult *result = CharacterDatabase.PQuery("SELECT data, text, bag, slot, item, item_template FROM character_inventory JOIN item_instance ON character_inventory.item = item_instance.guid WHERE character_inventory.guid = '%u' ORDER BY bag, slot", GetGUIDLow());
     //NOTE: the "order by `bag`" is important because it makes sure
@@ -17398,12 +17400,36 @@ void Player::_LoadInventory(PreparedQueryResult result, uint32 timeDiff)
         std::list<Item*> problematicItems;
         SQLTransaction trans = CharacterDatabase.BeginTransaction();
 
+        // refund and trade data of the inventory items, loaded along with them
+        ItemRefundDataMap refunds;
+        if (resultRefunds)
+        {
+            do
+            {
+                Field* fields = resultRefunds->Fetch();
+                ItemRefundData& refund = refunds[fields[0].GetUInt32()];
+                refund.recipient = fields[1].GetUInt32();
+                refund.paidMoney = fields[2].GetUInt32();
+                refund.paidExtendedCost = fields[3].GetUInt16();
+            } while (resultRefunds->NextRow());
+        }
+
+        ItemBopTradeDataMap bopTrades;
+        if (resultBopTrade)
+        {
+            do
+            {
+                Field* fields = resultBopTrade->Fetch();
+                bopTrades[fields[0].GetUInt32()] = fields[1].GetString();
+            } while (resultBopTrade->NextRow());
+        }
+
         // Prevent items from being added to the queue while loading
         m_itemUpdateQueueBlocked = true;
         do
         {
             Field* fields = result->Fetch();
-            if (Item* item = _LoadItem(trans, zoneId, timeDiff, fields))
+            if (Item* item = _LoadItem(trans, zoneId, timeDiff, fields, refunds, bopTrades))
             {
                 uint32 bagGuid  = fields[11].GetUInt32();
                 uint8  slot     = fields[12].GetUInt8();
@@ -17491,7 +17517,7 @@ void Player::_LoadInventory(PreparedQueryResult result, uint32 timeDiff)
     _ApplyAllItemMods();
 }
 
-Item* Player::_LoadItem(SQLTransaction& trans, uint32 zoneId, uint32 timeDiff, Field* fields)
+Item* Player::_LoadItem(SQLTransaction& trans, uint32 zoneId, uint32 timeDiff, Field* fields, ItemRefundDataMap const& refunds, ItemBopTradeDataMap const& bopTrades)
 {
     Item* item = NULL;
     uint32 itemGuid  = fields[13].GetUInt32();
@@ -17527,14 +17553,12 @@ Item* Player::_LoadItem(SQLTransaction& trans, uint32 zoneId, uint32 timeDiff, F
                 }
                 else
                 {
-                    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_LOAD_ITEM_REFUNDS);
-                    stmt->setUInt32(0, item->GetGUIDLow());
-                    stmt->setUInt32(1, GetGUIDLow());
-                    if (PreparedQueryResult result = CharacterDatabase.Query(stmt))
+                    ItemRefundDataMap::const_iterator refund = refunds.find(item->GetGUIDLow());
+                    if (refund != refunds.end())
                     {
-                        item->SetRefundRecipient((*result)[0].GetUInt32());
-                        item->SetPaidMoney((*result)[1].GetUInt32());
-                        item->SetPaidExtendedCost((*result)[2].GetUInt16());
+                        item->SetRefundRecipient(refund->second.recipient);
+                        item->SetPaidMoney(refund->second.paidMoney);
+                        item->SetPaidExtendedCost(refund->second.paidExtendedCost);
                         AddRefundReference(item->GetGUIDLow());
                     }
                     else
@@ -17547,12 +17571,10 @@ Item* Player::_LoadItem(SQLTransaction& trans, uint32 zoneId, uint32 timeDiff, F
             }
             else if (item->HasFlag(ITEM_FIELD_FLAGS, ITEM_FLAG_BOP_TRADEABLE))
             {
-                PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_LOAD_ITEM_BOP_TRADE);
-                stmt->setUInt32(0, item->GetGUIDLow());
-                if (PreparedQueryResult result = CharacterDatabase.Query(stmt))
+                ItemBopTradeDataMap::const_iterator bopTrade = bopTrades.find(item->GetGUIDLow());
+                if (bopTrade != bopTrades.end())
                 {
-                    std::string strGUID = (*result)[0].GetString();
-                    Tokens GUIDlist(strGUID, ' ');
+                    Tokens GUIDlist(bopTrade->second, ' ');
                     AllowedLooterSet looters;
                     for (Tokens::iterator itr = GUIDlist.begin(); itr != GUIDlist.end(); ++itr)
                         looters.insert(atol(*itr));
@@ -17712,14 +17734,14 @@ void Player::_LoadMail()
     m_mailsLoaded = true;
 }
 
-void Player::LoadPet()
+void Player::LoadPet(SQLQueryHolder* holder)
 {
     //fixme: the pet should still be loaded if the player is not in world
     // just not added to the map
     if (IsInWorld())
     {
         Pet *pet = new Pet(this);
-        if (!pet->LoadPetFromDB(this, 0, 0, true))
+        if (!pet->LoadPetFromDB(this, 0, 0, true, holder))
             delete pet;
     }
 }
@@ -18553,13 +18575,10 @@ void Player::SaveToDB()
     if (m_session->isLogingOut() || !sWorld->getBoolConfig(CONFIG_STATS_SAVE_ONLY_ON_LOGOUT))
         _SaveStats(trans);
 
-    CharacterDatabase.CommitTransaction(trans);
-
     // we save the data here to prevent spamming
-    sAnticheatMgr->SavePlayerData(this);
+    sAnticheatMgr->SavePlayerData(this, trans);
 
-    // in this way we prevent to spam the db by each report made!
-    // sAnticheatMgr->SavePlayerData(this);
+    CharacterDatabase.CommitTransaction(trans);
 
     /* World of Warcraft Armory */
     // Place this code AFTER CharacterDatabase.CommitTransaction(); to avoid some character saving errors.
@@ -21258,30 +21277,30 @@ bool Player::IsVisibleGloballyFor(Player* u) const
 }
 
 template<class T>
-inline void UpdateVisibilityOf_helper(std::set<uint64>& s64, T* target, std::set<Unit*>& /*v*/)
+inline void UpdateVisibilityOf_helper(ClientGUIDSet& guids, T* target, std::vector<Unit*>& /*v*/)
 {
-    s64.insert(target->GetGUID());
+    guids.insert(target->GetGUID());
 }
 
 template<>
-inline void UpdateVisibilityOf_helper(std::set<uint64>& s64, GameObject* target, std::set<Unit*>& /*v*/)
+inline void UpdateVisibilityOf_helper(ClientGUIDSet& guids, GameObject* target, std::vector<Unit*>& /*v*/)
 {
     if (!target->IsTransport())
-        s64.insert(target->GetGUID());
+        guids.insert(target->GetGUID());
 }
 
 template<>
-inline void UpdateVisibilityOf_helper(std::set<uint64>& s64, Creature* target, std::set<Unit*>& v)
+inline void UpdateVisibilityOf_helper(ClientGUIDSet& guids, Creature* target, std::vector<Unit*>& v)
 {
-    s64.insert(target->GetGUID());
-    v.insert(target);
+    guids.insert(target->GetGUID());
+    v.push_back(target);
 }
 
 template<>
-inline void UpdateVisibilityOf_helper(std::set<uint64>& s64, Player* target, std::set<Unit*>& v)
+inline void UpdateVisibilityOf_helper(ClientGUIDSet& guids, Player* target, std::vector<Unit*>& v)
 {
-    s64.insert(target->GetGUID());
-    v.insert(target);
+    guids.insert(target->GetGUID());
+    v.push_back(target);
 }
 
 template<class T>
@@ -21370,7 +21389,7 @@ void Player::SendInitialVisiblePackets(Unit* target)
 }
 
 template<class T>
-void Player::UpdateVisibilityOf(T* target, UpdateData& data, std::set<Unit*>& visibleNow)
+void Player::UpdateVisibilityOf(T* target, UpdateData& data, std::vector<Unit*>& visibleNow)
 {
     if (HaveAtClient(target))
     {
@@ -21403,11 +21422,11 @@ void Player::UpdateVisibilityOf(T* target, UpdateData& data, std::set<Unit*>& vi
     }
 }
 
-template void Player::UpdateVisibilityOf(Player*        target, UpdateData& data, std::set<Unit*>& visibleNow);
-template void Player::UpdateVisibilityOf(Creature*      target, UpdateData& data, std::set<Unit*>& visibleNow);
-template void Player::UpdateVisibilityOf(Corpse*        target, UpdateData& data, std::set<Unit*>& visibleNow);
-template void Player::UpdateVisibilityOf(GameObject*    target, UpdateData& data, std::set<Unit*>& visibleNow);
-template void Player::UpdateVisibilityOf(DynamicObject* target, UpdateData& data, std::set<Unit*>& visibleNow);
+template void Player::UpdateVisibilityOf(Player*        target, UpdateData& data, std::vector<Unit*>& visibleNow);
+template void Player::UpdateVisibilityOf(Creature*      target, UpdateData& data, std::vector<Unit*>& visibleNow);
+template void Player::UpdateVisibilityOf(Corpse*        target, UpdateData& data, std::vector<Unit*>& visibleNow);
+template void Player::UpdateVisibilityOf(GameObject*    target, UpdateData& data, std::vector<Unit*>& visibleNow);
+template void Player::UpdateVisibilityOf(DynamicObject* target, UpdateData& data, std::vector<Unit*>& visibleNow);
 
 void Player::UpdateObjectVisibility(bool forced)
 {
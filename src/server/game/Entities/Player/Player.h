@@ -22,6 +22,7 @@
 #include "AchievementMgr.h"
 #include "Battleground.h"
 #include "Bag.h"
+#include "ClientGUIDSet.h"
 #include "Common.h"
 #include "DatabaseEnv.h"
 #include "DBCEnums.h"
@@ -827,6 +828,13 @@ enum PlayerLoginQueryIndex
     PLAYER_LOGIN_QUERY_LOADQUESTSTATUSREW       = 29,
     PLAYER_LOGIN_QUERY_LOADINSTANCELOCKTIMES    = 30,
     PLAYER_LOGIN_QUERY_LOADXPRATE               = 31,
+    PLAYER_LOGIN_QUERY_LOADITEMREFUNDS          = 32,
+    PLAYER_LOGIN_QUERY_LOADITEMBOPTRADE         = 33,
+    PLAYER_LOGIN_QUERY_LOADPET                  = 34,
+    PLAYER_LOGIN_QUERY_LOADPETAURAS             = 35,
+    PLAYER_LOGIN_QUERY_LOADPETSPELLS            = 36,
+    PLAYER_LOGIN_QUERY_LOADPETSPELLCOOLDOWNS    = 37,
+    PLAYER_LOGIN_QUERY_LOADPETDECLINEDNAMES     = 38,
     MAX_PLAYER_LOGIN_QUERY,
 };
 
@@ -1399,7 +1407,7 @@ class Player : public Unit, public GridObject<Player>
         void RemoveItemDurations(Item *item);
         void SendItemDurations();
         void LoadCorpse();
-        void LoadPet();
+        void LoadPet(SQLQueryHolder* holder = NULL);
 
         bool AddItem(uint32 itemId, uint32 count);
 
@@ -2357,10 +2365,10 @@ class Player : public Unit, public GridObject<Player>
         WorldLocation GetStartPosition() const;
 
         // currently visible objects at player client
-        typedef std::set<uint64> ClientGUIDs;
+        typedef ClientGUIDSet ClientGUIDs;
         ClientGUIDs m_clientGUIDs;
 
-        bool HaveAtClient(WorldObject const* u) const { return u == this || m_clientGUIDs.find(u->GetGUID()) != m_clientGUIDs.end(); }
+        bool HaveAtClient(WorldObject const* u) const { return u == this || m_clientGUIDs.count(u->GetGUID()); }
 
         bool isValid() const;
 
@@ -2373,7 +2381,7 @@ class Player : public Unit, public GridObject<Player>
         void UpdateTriggerVisibility();
 
         template<class T>
-            void UpdateVisibilityOf(T* target, UpdateData& data, std::set<Unit*>& visibleNow);
+            void UpdateVisibilityOf(T* target, UpdateData& data, std::vector<Unit*>& visibleNow);
 
         uint8 m_forced_speed_changes[MAX_MOVE_TYPE];
 
@@ -2573,7 +2581,7 @@ class Player : public Unit, public GridObject<Player>
         void _LoadAuras(PreparedQueryResult result, uint32 timediff);
         void _LoadGlyphAuras();
         void _LoadBoundInstances(PreparedQueryResult result);
-        void _LoadInventory(PreparedQueryResult result, uint32 timeDiff);
+        void _LoadInventory(PreparedQueryResult result, PreparedQueryResult resultRefunds, PreparedQueryResult resultBopTrade, uint32 timeDiff);
         void _LoadMailInit(PreparedQueryResult resultUnread, PreparedQueryResult resultDelivery);
         void _LoadMail();
         void _LoadMailedItems(Mail *mail);
@@ -2792,7 +2800,16 @@ class Player : public Unit, public GridObject<Player>
         InventoryResult _CanStoreItem_InBag(uint8 bag, ItemPosCountVec& dest, ItemTemplate const *pProto, uint32& count, bool merge, bool non_specialized, Item *pSrcItem, uint8 skip_bag, uint8 skip_slot) const;
         InventoryResult _CanStoreItem_InInventorySlots(uint8 slot_begin, uint8 slot_end, ItemPosCountVec& dest, ItemTemplate const *pProto, uint32& count, bool merge, Item *pSrcItem, uint8 skip_bag, uint8 skip_slot) const;
         Item* _StoreItem(uint16 pos, Item *pItem, uint32 count, bool clone, bool update);
-        Item* _LoadItem(SQLTransaction& trans, uint32 zoneId, uint32 timeDiff, Field* fields);
+        struct ItemRefundData
+        {
+            uint32 recipient;
+            uint32 paidMoney;
+            uint16 paidExtendedCost;
+        };
+        typedef UNORDERED_MAP<uint32, ItemRefundData> ItemRefundDataMap;     // by item guid
+        typedef UNORDERED_MAP<uint32, std::string> ItemBopTradeDataMap;      // allowed looters by item guid
+
+        Item* _LoadItem(SQLTransaction& trans, uint32 zoneId, uint32 timeDiff, Field* fields, ItemRefundDataMap const& refunds, ItemBopTradeDataMap const& bopTrades);
 
         std::set<uint32> m_refundableItems;
         void SendRefundInfo(Item* item);
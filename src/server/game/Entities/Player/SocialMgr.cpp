@@ -163,6 +163,13 @@ bool PlayerSocial::HasIgnore(uint32 ignore_guid)
     return false;
 }
 
+void PlayerSocial::GetIgnores(std::vector<uint32>& ignores) const
+{
+    for (PlayerSocialMap::const_iterator itr = m_playerSocialMap.begin(); itr != m_playerSocialMap.end(); ++itr)
+        if (itr->second.Flags & SOCIAL_FLAG_IGNORED)
+            ignores.push_back(itr->first);
+}
+
 SocialMgr::SocialMgr()
 {
 }
@@ -187,6 +187,8 @@ m_vehicleKit(NULL), m_unitTypeMask(UNIT_MASK_NONE), m_HostileRefManager(this)
     m_auraUpdateIterator = m_ownedAuras.end();
 
     m_interruptMask = 0;
+    m_procAurasGeneration = sSpellMgr->GetProcDataGeneration();
+    m_auraApplySequence = 0;
     m_transform = 0;
     m_canModifyStats = false;
 
@@ -2882,6 +2884,11 @@ void Unit::_DeleteRemovedAuras()
         delete m_removedAuras.front();
         m_removedAuras.pop_front();
     }
+
+    // no aura effect list is iterated here
+    for (std::vector<AuraType>::const_iterator itr = m_modAurasToCompact.begin(); itr != m_modAurasToCompact.end(); ++itr)
+        m_modAuras[*itr].Compact();
+    m_modAurasToCompact.clear();
 }
 
 void Unit::_UpdateSpells(uint32 time)
@@ -3303,6 +3310,7 @@ AuraApplication * Unit::_CreateAuraApplication(Aura* aura, uint8 effMask)
     Unit* caster = aura->GetCaster();
 
     AuraApplication * aurApp = new AuraApplication(this, caster, aura, effMask);
+    aurApp->m_applySequence = ++m_auraApplySequence;
     m_appliedAuras.insert(AuraApplicationMap::value_type(aurId, aurApp));
 
     if (aurSpellInfo->AuraInterruptFlags)
@@ -3314,6 +3322,8 @@ AuraApplication * Unit::_CreateAuraApplication(Aura* aura, uint8 effMask)
     if (AuraStateType aState = aura->GetSpellInfo()->GetAuraState())
         m_auraStateAuras.insert(AuraStateAurasMap::value_type(aState, aurApp));
 
+    _RegisterProcAura(aurApp);
+
     aura->_ApplyForTarget(this, caster, aurApp);
     return aurApp;
 }
@@ -3389,6 +3399,8 @@ void Unit::_UnapplyAura(AuraApplicationMap::iterator &i, AuraRemoveMode removeMo
     // Remove all pointers from lists here to prevent possible pointer invalidation on spellcast/auraapply/auraremove
     m_appliedAuras.erase(i);
 
+    _UnregisterProcAura(aurApp);
+
     if (aura->GetSpellInfo()->AuraInterruptFlags)
     {
         m_interruptableAuras.remove(aurApp);
@@ -3464,6 +3476,41 @@ void Unit::_UnapplyAura(AuraApplication * aurApp, AuraRemoveMode removeMode)
     ASSERT(false);
 }
 
+void Unit::_RegisterProcAura(AuraApplication* aurApp)
+{
+    // stale index, rebuilt before its next use
+    if (m_procAurasGeneration != sSpellMgr->GetProcDataGeneration())
+        return;
+
+    uint32 procFlags = sSpellMgr->GetSpellProcFlags(aurApp->GetBase()->GetSpellInfo());
+    for (uint8 bit = 0; bit < 32; ++bit)
+        if (procFlags & (1u << bit))
+            m_procAuras.insert(ProcAurasMap::value_type(bit, aurApp));
+}
+
+void Unit::_UnregisterProcAura(AuraApplication* aurApp)
+{
+    // stale index, rebuilt before its next use
+    if (m_procAurasGeneration != sSpellMgr->GetProcDataGeneration())
+        return;
+
+    uint32 procFlags = sSpellMgr->GetSpellProcFlags(aurApp->GetBase()->GetSpellInfo());
+    for (uint8 bit = 0; bit < 32; ++bit)
+    {
+        if (!(procFlags & (1u << bit)))
+            continue;
+
+        for (ProcAurasMap::iterator itr = m_procAuras.lower_bound(bit); itr != m_procAuras.upper_bound(bit); ++itr)
+        {
+            if (itr->second == aurApp)
+            {
+                m_procAuras.erase(itr);
+                break;
+            }
+        }
+    }
+}
+
 void Unit::_RemoveNoStackAurasDueToAura(Aura* aura)
 {
     SpellInfo const* spellProto = aura->GetSpellInfo();
@@ -3496,7 +3543,10 @@ void Unit::_RegisterAuraEffect(AuraEffect* aurEff, bool apply)
     if (apply)
         m_modAuras[aurEff->GetAuraType()].push_back(aurEff);
     else
-        m_modAuras[aurEff->GetAuraType()].remove(aurEff);
+    {
+        if (m_modAuras[aurEff->GetAuraType()].remove(aurEff))
+            m_modAurasToCompact.push_back(aurEff->GetAuraType());
+    }
 }
 
 // All aura base removes should go threw this function!
@@ -14400,19 +14450,24 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* pTarget, uint32 procFlag,
         }
     }
 
+    // Only auras with one of the proc flags can be triggered
+    std::vector<AuraApplication*> procAuras;
+    GetProcAurasFor(procFlag, procAuras);
+
     ProcTriggeredList procTriggered;
     // Fill procTriggered list
-    for (AuraApplicationMap::const_iterator itr = GetAppliedAuras().begin(); itr!= GetAppliedAuras().end(); ++itr)
+    for (std::vector<AuraApplication*>::const_iterator itr = procAuras.begin(); itr != procAuras.end(); ++itr)
     {
+        AuraApplication* aurApp = *itr;
         // Do not allow auras to proc from effect triggered by itself
-        if (procAura && procAura->Id == itr->first)
+        if (procAura && procAura->Id == aurApp->GetBase()->GetId())
             continue;
-        ProcTriggeredData triggerData(itr->second->GetBase());
+        ProcTriggeredData triggerData(aurApp->GetBase());
         // Defensive procs are active on absorbs (so absorption effects are not a hindrance)
         bool active = damage || (procExtra & PROC_EX_BLOCK && isVictim);
         if (isVictim)
             procExtra &= ~PROC_EX_INTERNAL_REQ_FAMILY;
-        SpellInfo const* spellProto = itr->second->GetBase()->GetSpellInfo();
+        SpellInfo const* spellProto = aurApp->GetBase()->GetSpellInfo();
         if (!IsTriggeredAtSpellProcEvent(pTarget, triggerData.aura, procSpell, procFlag, procExtra, attType, isVictim, active, triggerData.spellProcEvent))
             continue;
 
@@ -14422,9 +14477,9 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* pTarget, uint32 procFlag,
 
         for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
         {
-            if (itr->second->HasEffect(i))
+            if (aurApp->HasEffect(i))
             {
-                AuraEffect* aurEff = itr->second->GetBase()->GetEffect(i);
+                AuraEffect* aurEff = aurApp->GetBase()->GetEffect(i);
                 // Skip this auras
                 if (isNonTriggerAura[aurEff->GetAuraType()])
                     continue;
@@ -15283,6 +15338,42 @@ bool Unit::InitTamedPet(Pet * pet, uint8 level, uint32 spell_id)
     return true;
 }
 
+// order of the auras in m_appliedAuras, applications of the same spell in the order they were applied
+static bool ProcAuraOrder(AuraApplication* left, AuraApplication* right)
+{
+    if (left->GetBase()->GetId() != right->GetBase()->GetId())
+        return left->GetBase()->GetId() < right->GetBase()->GetId();
+    return left->GetApplySequence() < right->GetApplySequence();
+}
+
+void Unit::GetProcAurasFor(uint32 procFlag, std::vector<AuraApplication*>& procAuras)
+{
+    // proc data was reloaded, index the applied auras again
+    if (m_procAurasGeneration != sSpellMgr->GetProcDataGeneration())
+    {
+        m_procAuras.clear();
+        m_procAurasGeneration = sSpellMgr->GetProcDataGeneration();
+        for (AuraApplicationMap::const_iterator itr = m_appliedAuras.begin(); itr != m_appliedAuras.end(); ++itr)
+            _RegisterProcAura(itr->second);
+    }
+
+    if (m_procAuras.empty())
+        return;
+
+    for (uint8 bit = 0; bit < 32; ++bit)
+    {
+        if (!(procFlag & (1u << bit)))
+            continue;
+
+        for (ProcAurasMap::const_iterator itr = m_procAuras.lower_bound(bit); itr != m_procAuras.upper_bound(bit); ++itr)
+            procAuras.push_back(itr->second);
+    }
+
+    // an aura with several of the flags was found once per flag
+    std::sort(procAuras.begin(), procAuras.end(), ProcAuraOrder);
+    procAuras.erase(std::unique(procAuras.begin(), procAuras.end()), procAuras.end());
+}
+
 bool Unit::IsTriggeredAtSpellProcEvent(Unit* victim, Aura* aura, SpellInfo const* procSpell, uint32 procFlag, uint32 procExtra, WeaponAttackType attType, bool isVictim, bool active, SpellProcEventEntry const* & spellProcEvent)
 {
     SpellInfo const* spellProto = aura->GetSpellInfo();
@@ -23,6 +23,7 @@
 #include "Object.h"
 #include "Opcodes.h"
 #include "SpellAuraDefines.h"
+#include "AuraEffectArray.h"
 #include "UpdateFields.h"
 #include "SharedDefines.h"
 #include "ThreatManager.h"
@@ -1229,7 +1230,8 @@ class Unit : public WorldObject
         typedef std::multimap<uint32,  Aura*> AuraMap;
         typedef std::multimap<uint32,  AuraApplication*> AuraApplicationMap;
         typedef std::multimap<AuraStateType,  AuraApplication*> AuraStateAurasMap;
-        typedef std::list<AuraEffect *> AuraEffectList;
+        typedef std::multimap<uint8,  AuraApplication*> ProcAurasMap;
+        typedef AuraEffectArray AuraEffectList;
         typedef std::list<Aura *> AuraList;
         typedef std::list<AuraApplication *> AuraApplicationList;
         typedef std::list<DiminishingReturn> Diminishing;
@@ -2244,9 +2246,13 @@ class Unit : public WorldObject
         uint32 m_removedAurasCount;
 
         AuraEffectList m_modAuras[TOTAL_AURAS];
+        std::vector<AuraType> m_modAurasToCompact;  // types with removed effects, compacted in _DeleteRemovedAuras
         AuraList m_scAuras;                        // casted singlecast auras
         AuraApplicationList m_interruptableAuras;             // auras which have interrupt mask applied on unit
         AuraStateAurasMap m_auraStateAuras;        // Used for improve performance of aura state checks on aura apply/remove
+        ProcAurasMap m_procAuras;                  // applied auras by each bit of their proc flags, see SpellMgr::GetSpellProcFlags
+        uint32 m_procAurasGeneration;              // SpellMgr proc data generation m_procAuras was built with
+        uint32 m_auraApplySequence;                // last AuraApplication::GetApplySequence() given out
         uint32 m_interruptMask;
 
         float m_auraModifiersGroup[UNIT_MOD_END][MODIFIER_TYPE_END];
@@ -2280,6 +2286,9 @@ class Unit : public WorldObject
 
         bool isAlwaysDetectableFor(WorldObject const* seer) const;
     private:
+        void _RegisterProcAura(AuraApplication* aurApp);
+        void _UnregisterProcAura(AuraApplication* aurApp);
+        void GetProcAurasFor(uint32 procFlag, std::vector<AuraApplication*>& procAuras);
         bool IsTriggeredAtSpellProcEvent(Unit *pVictim, Aura * aura, SpellInfo const* procSpell, uint32 procFlag, uint32 procExtra, WeaponAttackType attType, bool isVictim, bool active, SpellProcEventEntry const *& spellProcEvent);
         bool HandleDummyAuraProc(Unit *pVictim, uint32 damage, AuraEffect* triggeredByAura, SpellInfo const *procSpell, uint32 procFlag, uint32 procEx, uint32 cooldown);
         bool HandleHasteAuraProc(Unit *pVictim, uint32 damage, AuraEffect* triggeredByAura, SpellInfo const *procSpell, uint32 procFlag, uint32 procEx, uint32 cooldown);
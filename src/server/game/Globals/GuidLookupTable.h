@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_GUIDLOOKUPTABLE_H
+#define TRINITY_GUIDLOOKUPTABLE_H
+
+#include "Common.h"
+#include "Errors.h"
+
+/*
+ * Guid to object table that is read without any lock (HashMapHolder::Find).
+ *
+ * Writers must be serialized by the caller. The table is open addressed
+ * with linear probing, and a slot keeps its guid once it got one: removing
+ * an object only clears the object pointer, and adding the same guid again
+ * reuses the slot. A reader therefore never sees a guid move, and the slot
+ * of a guid being added can not lie on the probe sequence of a guid that
+ * is already in, so a lookup needs no more than plain loads.
+ *
+ * When the used slots, removed ones included, reach half of the table, a
+ * new table is built from the objects alone and published. The old one is
+ * kept for the readers that may still probe it, until ReleaseRetired() is
+ * called at a point where no thread can be in Find().
+ */
+template <class T>
+class GuidLookupTable
+{
+    public:
+        GuidLookupTable() : m_table(CreateTable(MIN_CAPACITY)) { }
+
+        ~GuidLookupTable()
+        {
+            ReleaseRetired();
+            DestroyTable(m_table);
+        }
+
+        T* Find(uint64 guid) const
+        {
+            Table const* table = m_table;
+            uint32 mask = table->capacity - 1;
+            for (uint32 index = HomeIndex(guid, mask); ; index = (index + 1) & mask)
+            {
+                uint64 slotGuid = table->slots[index].guid;
+                if (slotGuid == guid)
+                    return table->slots[index].object;
+
+                if (!slotGuid)
+                    return NULL;
+            }
+        }
+
+        void Insert(uint64 guid, T* object)
+        {
+            ASSERT(guid && object);
+            if ((m_table->used + 1) * 2 > m_table->capacity)
+                Rebuild();
+
+            Slot& slot = m_table->slots[Claim(m_table, guid)];
+            if (!slot.object)
+                ++m_table->size;
+
+            // the object must be complete for the readers finding it
+            StoreBarrier();
+            slot.object = object;
+        }
+
+        void Remove(uint64 guid)
+        {
+            Table* table = m_table;
+            uint32 mask = table->capacity - 1;
+            for (uint32 index = HomeIndex(guid, mask); table->slots[index].guid; index = (index + 1) & mask)
+            {
+                if (table->slots[index].guid != guid)
+                    continue;
+
+                if (table->slots[index].object)
+                {
+                    table->slots[index].object = NULL;
+                    --table->size;
+                }
+                return;
+            }
+        }
+
+        // frees the tables replaced since the last call, no thread may be in Find() meanwhile
+        void ReleaseRetired()
+        {
+            for (typename std::vector<Table*>::const_iterator itr = m_retired.begin(); itr != m_retired.end(); ++itr)
+                DestroyTable(*itr);
+            m_retired.clear();
+        }
+
+    private:
+        enum { MIN_CAPACITY = 256 };
+
+        struct Slot
+        {
+            uint64 volatile guid;                           // 0 for a slot never used
+            T* volatile object;                             // NULL once removed
+        };
+
+        struct Table
+        {
+            uint32 capacity;                                // power of two
+            uint32 used;                                    // slots with a guid
+            uint32 size;                                    // slots with an object
+            Slot* slots;
+        };
+
+        GuidLookupTable(GuidLookupTable const&);
+        GuidLookupTable& operator=(GuidLookupTable const&);
+
+        static void StoreBarrier()
+        {
+#if COMPILER == COMPILER_MICROSOFT
+            MemoryBarrier();
+#else
+            __sync_synchronize();
+#endif
+        }
+
+        static uint32 HomeIndex(uint64 guid, uint32 mask) { return uint32((guid * UI64LIT(0x9E3779B97F4A7C15)) >> 32) & mask; }
+
+        static Table* CreateTable(uint32 capacity)
+        {
+            Table* table = new Table;
+            table->capacity = capacity;
+            table->used = 0;
+            table->size = 0;
+            table->slots = (Slot*)calloc(capacity, sizeof(Slot));
+            ASSERT(table->slots);
+            return table;
+        }
+
+        static void DestroyTable(Table* table)
+        {
+            free(table->slots);
+            delete table;
+        }
+
+        // returns the slot of the guid, giving it an unused one if it has none
+        static uint32 Claim(Table* table, uint64 guid)
+        {
+            uint32 mask = table->capacity - 1;
+            uint32 index = HomeIndex(guid, mask);
+            while (table->slots[index].guid)
+            {
+                if (table->slots[index].guid == guid)
+                    return index;
+                index = (index + 1) & mask;
+            }
+
+            table->slots[index].guid = guid;
+            ++table->used;
+            return index;
+        }
+
+        void Rebuild()
+        {
+            // a quarter filled at most, so that removed slots are not rebuilt again right away
+            uint32 capacity = MIN_CAPACITY;
+            while (capacity < (m_table->size + 1) * 4)
+                capacity *= 2;
+
+            Table* table = CreateTable(capacity);
+            for (uint32 i = 0; i < m_table->capacity; ++i)
+            {
+                if (T* object = m_table->slots[i].object)
+                {
+                    table->slots[Claim(table, m_table->slots[i].guid)].object = object;
+                    ++table->size;
+                }
+            }
+
+            Table* old = m_table;
+            StoreBarrier();
+            m_table = table;
+            m_retired.push_back(old);
+        }
+
+        Table* volatile m_table;
+        std::vector<Table*> m_retired;                      // replaced tables readers may still probe
+};
+
+#endif
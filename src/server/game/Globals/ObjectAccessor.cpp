@@ -165,15 +165,44 @@ Unit* ObjectAccessor::FindUnit(uint64 guid)
 
 Player* ObjectAccessor::FindPlayerByName(const char* name)
 {
-    ACE_GUARD_RETURN(LockType, g, *HashMapHolder<Player>::GetLock(), NULL);
-    HashMapHolder<Player>::MapType& m = HashMapHolder<Player>::GetContainer();
-    for (HashMapHolder<Player>::MapType::iterator iter = m.begin(); iter != m.end(); ++iter)
-        if (iter->second->IsInWorld() && strcmp(name, iter->second->GetName()) == 0)
-            return iter->second;
+    std::string key = name;
+    if (!normalizePlayerName(key))
+        return NULL;
+
+    ACE_GUARD_RETURN(LockType, g, i_playerNameGuard, NULL);
+    PlayerNameMapType::const_iterator itr = i_playersByName.find(key);
+    if (itr != i_playersByName.end() && itr->second->IsInWorld())
+        return itr->second;
 
     return NULL;
 }
 
+void ObjectAccessor::AddObject(Player* player)
+{
+    HashMapHolder<Player>::Insert(player);
+
+    std::string key = player->GetName();
+    if (!normalizePlayerName(key))
+        return;
+
+    ACE_GUARD(LockType, g, i_playerNameGuard);
+    i_playersByName[key] = player;
+}
+
+void ObjectAccessor::RemoveObject(Player* pl)
+{
+    HashMapHolder<Player>::Remove(pl);
+
+    std::string key = pl->GetName();
+    if (!normalizePlayerName(key))
+        return;
+
+    ACE_GUARD(LockType, g, i_playerNameGuard);
+    PlayerNameMapType::iterator itr = i_playersByName.find(key);
+    if (itr != i_playersByName.end() && itr->second == pl)
+        i_playersByName.erase(itr);
+}
+
 void ObjectAccessor::SaveAllPlayers()
 {
     ACE_GUARD(LockType, g, *HashMapHolder<Player>::GetLock());
@@ -182,6 +211,16 @@ void ObjectAccessor::SaveAllPlayers()
         itr->second->SaveToDB();
 }
 
+void ObjectAccessor::ReleaseRetiredLookupTables()
+{
+    HashMapHolder<Player>::ReleaseRetiredTables();
+    HashMapHolder<Pet>::ReleaseRetiredTables();
+    HashMapHolder<GameObject>::ReleaseRetiredTables();
+    HashMapHolder<DynamicObject>::ReleaseRetiredTables();
+    HashMapHolder<Creature>::ReleaseRetiredTables();
+    HashMapHolder<Corpse>::ReleaseRetiredTables();
+}
+
 Corpse* ObjectAccessor::GetCorpseForPlayerGUID(uint64 guid)
 {
     ACE_GUARD_RETURN(LockType, guard, i_corpseGuard, NULL);
@@ -342,32 +381,6 @@ void ObjectAccessor::RemoveOldCorpses()
     }
 }
 
-void ObjectAccessor::Update(uint32 /*diff*/)
-{
-    UpdateDataMapType update_players;
-
-    // Critical section
-    {
-        ACE_GUARD(LockType, g, i_updateGuard);
-
-        while (!i_objects.empty())
-        {
-            Object* obj = *i_objects.begin();
-            ASSERT(obj && obj->IsInWorld());
-            i_objects.erase(i_objects.begin());
-            obj->BuildUpdate(update_players);
-        }
-    }
-
-    WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
-    for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
-    {
-        iter->second.BuildPacket(&packet);
-        iter->first->GetSession()->SendPacket(&packet);
-        packet.clear();                                     // clean the string
-    }
-}
-
 void ObjectAccessor::UnloadAll()
 {
     for (Player2CorpsesMapType::const_iterator itr = i_player2corpse.begin(); itr != i_player2corpse.end(); ++itr)
@@ -381,6 +394,7 @@ void ObjectAccessor::UnloadAll()
 
 template <class T> UNORDERED_MAP< uint64, T* > HashMapHolder<T>::m_objectMap;
 template <class T> ACE_Thread_Mutex HashMapHolder<T>::i_lock;
+template <class T> GuidLookupTable<T> HashMapHolder<T>::m_lookupTable;
 
 /// Global definitions for the hashmap storage
 
@@ -25,6 +25,7 @@
 #include "UnorderedMap.h"
 
 #include "UpdateData.h"
+#include "GuidLookupTable.h"
 
 #include "GridDefines.h"
 #include "Object.h"
@@ -42,6 +43,7 @@ class Vehicle;
 class Map;
 class WorldRunnable;
 
+// the lock guards the object map and the writers of the lookup table, Find takes none
 template <class T>
 class HashMapHolder
 {
@@ -54,19 +56,26 @@ class HashMapHolder
         {
             ACE_GUARD(LockType, Guard, i_lock);
             m_objectMap[o->GetGUID()] = o;
+            m_lookupTable.Insert(o->GetGUID(), o);
         }
 
         static void Remove(T* o)
         {
             ACE_GUARD(LockType, Guard, i_lock);
             m_objectMap.erase(o->GetGUID());
+            m_lookupTable.Remove(o->GetGUID());
         }
 
         static T* Find(uint64 guid)
         {
-            ACE_GUARD_RETURN(LockType, Guard, i_lock, NULL);
-            typename MapType::iterator itr = m_objectMap.find(guid);
-            return (itr != m_objectMap.end()) ? itr->second : NULL;
+            return m_lookupTable.Find(guid);
+        }
+
+        // must only be called while no other thread may look up objects
+        static void ReleaseRetiredTables()
+        {
+            ACE_GUARD(LockType, Guard, i_lock);
+            m_lookupTable.ReleaseRetired();
         }
 
         static MapType& GetContainer() { return m_objectMap; }
@@ -80,6 +89,7 @@ class HashMapHolder
 
         static LockType i_lock;
         static MapType  m_objectMap;
+        static GuidLookupTable<T> m_lookupTable;
 };
 
 class ObjectAccessor
@@ -225,27 +235,14 @@ class ObjectAccessor
             HashMapHolder<T>::Remove(object);
         }
 
-        void RemoveObject(Player* pl)
-        {
-            HashMapHolder<Player>::Remove(pl);
-            RemoveUpdateObject((Object*)pl);
-        }
+        // players are also indexed by name
+        void AddObject(Player* player);
+        void RemoveObject(Player* pl);
 
         void SaveAllPlayers();
 
-        void AddUpdateObject(Object* obj)
-        {
-            ACE_GUARD(LockType, Guard, i_updateGuard);
-            i_objects.insert(obj);
-        }
-
-        void RemoveUpdateObject(Object* obj)
-        {
-            ACE_GUARD(LockType, Guard, i_updateGuard);
-            i_objects.erase(obj);
-        }
-
-        void Update(uint32 diff);
+        // frees the lookup tables the holders replaced, called while the maps are not updated
+        void ReleaseRetiredLookupTables();
 
         Corpse* GetCorpseForPlayerGUID(uint64 guid);
         void RemoveCorpse(Corpse* corpse);
@@ -263,14 +260,11 @@ class ObjectAccessor
 
         Player2CorpsesMapType i_player2corpse;
 
-        static void _buildChangeObjectForPlayer(WorldObject*, UpdateDataMapType&);
-        static void _buildPacket(Player*, Object*, UpdateDataMapType&);
-        void _update();
-
-        std::set<Object*> i_objects;
-
-        LockType i_updateGuard;
         LockType i_corpseGuard;
+
+        typedef UNORDERED_MAP<std::string, Player*> PlayerNameMapType;
+        PlayerNameMapType i_playersByName;                  // by normalized name
+        LockType i_playerNameGuard;
 };
 
 #define sObjectAccessor ACE_Singleton<ObjectAccessor, ACE_Thread_Mutex>::instance()
@@ -674,6 +674,9 @@ class ObjectMgr
         uint32 GetPlayerTeamByGUID(uint64 guid) const;
         uint32 GetPlayerAccountIdByGUID(uint64 guid) const;
         uint32 GetPlayerAccountIdByPlayerName(const std::string& name) const;
+        // to be called when the name of a character changes in the DB or the character is deleted
+        void UpdateCharacterNameCache(uint32 guidLow, std::string const& newName);
+        void RemoveCharacterNameCache(uint32 guidLow);
 
         uint32 GetNearestTaxiNode(float x, float y, float z, uint32 mapid, uint32 team);
         void GetTaxiPath(uint32 source, uint32 destination, uint32 &path, uint32 &cost);
@@ -1329,6 +1332,14 @@ class ObjectMgr
         RespawnTimes mGORespawnTimes;
         ACE_Thread_Mutex m_GORespawnTimesMtx;
 
+        // names of the characters already looked up in the DB, by normalized name and by low guid
+        void AddCharacterNameCache(uint32 guidLow, std::string const& name) const;
+        typedef UNORDERED_MAP<std::string, uint32> CharacterGuidByNameMap;
+        typedef UNORDERED_MAP<uint32, std::string> CharacterNameByGuidMap;
+        mutable CharacterGuidByNameMap m_characterGuidsByName;
+        mutable CharacterNameByGuidMap m_characterNamesByGuid;
+        mutable ACE_Thread_Mutex m_characterNamesMtx;
+
         CacheVendorItemMap m_mCacheVendorItemMap;
         CacheTrainerSpellMap m_mCacheTrainerSpellMap;
 
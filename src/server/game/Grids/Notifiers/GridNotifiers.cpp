@@ -33,15 +33,13 @@ using namespace Trinity;
 void
 VisibleNotifier::SendToSelf()
 {
-    // at this moment i_clientGUIDs have guids that not iterate at grid level checks
+    // at this moment the guids at client not marked were not iterated at grid level checks
     // but exist one case when this possible and object not out of range: transports
     if (Transport* transport = i_player.GetTransport())
         for (Transport::PlayerSet::const_iterator itr = transport->GetPassengers().begin();itr != transport->GetPassengers().end();++itr)
         {
-            if (vis_guids.find((*itr)->GetGUID()) != vis_guids.end())
+            if (i_player.m_clientGUIDs.Mark((*itr)->GetGUID()))
             {
-                vis_guids.erase((*itr)->GetGUID());
-
                 i_player.UpdateVisibilityOf((*itr), i_data, i_visibleNow);
 
                 if (!(*itr)->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
@@ -49,9 +47,11 @@ VisibleNotifier::SendToSelf()
             }
         }
 
-    for (Player::ClientGUIDs::const_iterator it = vis_guids.begin();it != vis_guids.end(); ++it)
+    std::vector<uint64> outOfRange;
+    i_player.m_clientGUIDs.TakeUnmarked(outOfRange);
+
+    for (std::vector<uint64>::const_iterator it = outOfRange.begin(); it != outOfRange.end(); ++it)
     {
-        i_player.m_clientGUIDs.erase(*it);
         i_data.AddOutOfRangeGUID(*it);
 
         if (IS_PLAYER_GUID(*it))
@@ -69,7 +69,7 @@ VisibleNotifier::SendToSelf()
     i_data.BuildPacket(&packet);
     i_player.GetSession()->SendPacket(&packet);
 
-    for (std::set<Unit*>::const_iterator it = i_visibleNow.begin(); it != i_visibleNow.end(); ++it)
+    for (std::vector<Unit*>::const_iterator it = i_visibleNow.begin(); it != i_visibleNow.end(); ++it)
         i_player.SendInitialVisiblePackets(*it);
 }
 
@@ -128,7 +128,7 @@ void PlayerRelocationNotifier::Visit(PlayerMapType &m)
     {
         Player* plr = iter->getSource();
 
-        vis_guids.erase(plr->GetGUID());
+        i_player.m_clientGUIDs.Mark(plr->GetGUID());
 
         i_player.UpdateVisibilityOf(plr, i_data, i_visibleNow);
 
@@ -147,7 +147,7 @@ void PlayerRelocationNotifier::Visit(CreatureMapType &m)
     {
         Creature* c = iter->getSource();
 
-        vis_guids.erase(c->GetGUID());
+        i_player.m_clientGUIDs.Mark(c->GetGUID());
 
         i_player.UpdateVisibilityOf(c, i_data, i_visibleNow);
 
@@ -326,11 +326,29 @@ ObjectUpdater::Visit(GridRefManager<T> &m)
 {
     for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
-        if (iter->getSource()->IsInWorld())
+        if (iter->getSource()->IsInWorld() && !UpdateSerially(iter->getSource()))
             iter->getSource()->Update(i_timeDiff);
     }
 }
 
+bool ObjectUpdater::UpdateSerially(WorldObject* obj)
+{
+    if (!i_serialObjects || !obj->GetZoneScript())
+        return false;
+
+    i_serialObjects->push_back(obj);
+    return true;
+}
+
+bool ObjectUpdater::UpdateSerially(Creature* obj)
+{
+    if (!i_serialObjects || (!obj->GetZoneScript() && !obj->GetFormation()))
+        return false;
+
+    i_serialObjects->push_back(obj);
+    return true;
+}
+
 bool AnyDeadUnitObjectInRangeCheck::operator()(Player* u)
 {
     return !u->isAlive() && !u->HasAuraType(SPELL_AURA_GHOST) && i_searchObj->IsWithinDistInMap(u, i_range);
@@ -21,6 +21,7 @@
 
 #include "ObjectGridLoader.h"
 #include "UpdateData.h"
+#include "SharedWorldPacket.h"
 #include <iostream>
 
 #include "Corpse.h"
@@ -40,10 +41,10 @@ namespace Trinity
     {
         Player &i_player;
         UpdateData i_data;
-        std::set<Unit*> i_visibleNow;
-        Player::ClientGUIDs vis_guids;
+        std::vector<Unit*> i_visibleNow;
 
-        VisibleNotifier(Player &player) : i_player(player), vis_guids(player.m_clientGUIDs) {}
+        // guids at client not marked by the grid visit are out of range in SendToSelf
+        VisibleNotifier(Player &player) : i_player(player) { i_player.m_clientGUIDs.BeginPass(); }
         template<class T> void Visit(GridRefManager<T> &m);
         void SendToSelf(void);
     };
@@ -121,13 +122,13 @@ namespace Trinity
     struct MessageDistDeliverer
     {
         WorldObject *i_source;
-        WorldPacket *i_message;
+        SharedWorldPacket i_message;                        // serialized once for all receivers
         uint32 i_phaseMask;
         float i_distSq;
         uint32 team;
         Player const* skipped_receiver;
         MessageDistDeliverer(WorldObject *src, WorldPacket *msg, float dist, bool own_team_only = false, Player const* skipped = NULL)
-            : i_source(src), i_message(msg), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
+            : i_source(src), i_message(*msg), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
             , team((own_team_only && src->GetTypeId() == TYPEID_PLAYER) ? ((Player*)src)->GetTeam() : 0)
             , skipped_receiver(skipped)
         {
@@ -154,11 +155,16 @@ namespace Trinity
     struct ObjectUpdater
     {
         uint32 i_timeDiff;
-        explicit ObjectUpdater(const uint32 diff) : i_timeDiff(diff) {}
+        std::vector<WorldObject*>* i_serialObjects;         // region update: objects left to the serial part of the map update
+        explicit ObjectUpdater(const uint32 diff, std::vector<WorldObject*>* serialObjects = NULL) : i_timeDiff(diff), i_serialObjects(serialObjects) {}
         template<class T> void Visit(GridRefManager<T> &m);
         void Visit(PlayerMapType &) {}
         void Visit(CorpseMapType &) {}
         void Visit(CreatureMapType &);
+
+        // objects whose zone script (outdoor pvp) or formation is shared beyond their region
+        bool UpdateSerially(WorldObject* obj);
+        bool UpdateSerially(Creature* obj);
     };
 
     // SEARCHERS & LIST SEARCHERS & WORKERS
@@ -184,14 +190,14 @@ namespace Trinity
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) {}
     };
 
-    template<class Check>
+    template<class Check, class Container = std::list<WorldObject*> >
     struct WorldObjectListSearcher
     {
         uint32 i_phaseMask;
-        std::list<WorldObject*> &i_objects;
+        Container &i_objects;
         Check& i_check;
 
-        WorldObjectListSearcher(WorldObject const* searcher, std::list<WorldObject*> &objects, Check & check)
+        WorldObjectListSearcher(WorldObject const* searcher, Container &objects, Check & check)
             : i_phaseMask(searcher->GetPhaseMask()), i_objects(objects), i_check(check) {}
 
         void Visit(PlayerMapType &m);
@@ -19,6 +19,7 @@
 #include "Common.h"
 #include "Opcodes.h"
 #include "WorldPacket.h"
+#include "SharedWorldPacket.h"
 #include "WorldSession.h"
 #include "Player.h"
 #include "World.h"
@@ -1258,6 +1259,7 @@ void Group::UpdatePlayerOutOfRange(Player* pPlayer)
 
 void Group::BroadcastPacket(WorldPacket* packet, bool ignorePlayersInBGRaid, int group, uint64 ignore)
 {
+    SharedWorldPacket shared(*packet);
     for (GroupReference *itr = GetFirstMember(); itr != NULL; itr = itr->next())
     {
         Player *pl = itr->getSource();
@@ -1265,7 +1267,7 @@ void Group::BroadcastPacket(WorldPacket* packet, bool ignorePlayersInBGRaid, int
             continue;
 
         if (pl->GetSession() && (group == -1 || itr->getSubGroup() == group))
-            pl->GetSession()->SendPacket(packet);
+            pl->GetSession()->SendPacket(shared);
     }
 }
 
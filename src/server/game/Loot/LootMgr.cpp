@@ -36,18 +36,18 @@ static Rates const qualityToRate[MAX_ITEM_QUALITY] = {
     RATE_DROP_ITEM_ARTIFACT,                                // ITEM_QUALITY_ARTIFACT
 };
 
-LootStore LootTemplates_Creature("creature_loot_template",           "creature entry",                  true);
-LootStore LootTemplates_Disenchant("disenchant_loot_template",       "item disenchant id",              true);
-LootStore LootTemplates_Fishing("fishing_loot_template",             "area id",                         true);
-LootStore LootTemplates_Gameobject("gameobject_loot_template",       "gameobject entry",                true);
-LootStore LootTemplates_Item("item_loot_template",                   "item entry",                      true);
-LootStore LootTemplates_Mail("mail_loot_template",                   "mail template id",                false);
-LootStore LootTemplates_Milling("milling_loot_template",             "item entry (herb)",               true);
-LootStore LootTemplates_Pickpocketing("pickpocketing_loot_template", "creature pickpocket lootid",      true);
-LootStore LootTemplates_Prospecting("prospecting_loot_template",     "item entry (ore)",                true);
-LootStore LootTemplates_Reference("reference_loot_template",         "reference id",                    false);
-LootStore LootTemplates_Skinning("skinning_loot_template",           "creature skinning id",            true);
-LootStore LootTemplates_Spell("spell_loot_template",                 "spell id (random item creating)", false);
+LootStore LootTemplates_Creature("creature_loot_template",           "creature entry",                  true, WORLD_LOAD_CREATURE_LOOT_TEMPLATES);
+LootStore LootTemplates_Disenchant("disenchant_loot_template",       "item disenchant id",              true, WORLD_LOAD_DISENCHANT_LOOT_TEMPLATES);
+LootStore LootTemplates_Fishing("fishing_loot_template",             "area id",                         true, WORLD_LOAD_FISHING_LOOT_TEMPLATES);
+LootStore LootTemplates_Gameobject("gameobject_loot_template",       "gameobject entry",                true, WORLD_LOAD_GAMEOBJECT_LOOT_TEMPLATES);
+LootStore LootTemplates_Item("item_loot_template",                   "item entry",                      true, WORLD_LOAD_ITEM_LOOT_TEMPLATES);
+LootStore LootTemplates_Mail("mail_loot_template",                   "mail template id",                false, WORLD_LOAD_MAIL_LOOT_TEMPLATES);
+LootStore LootTemplates_Milling("milling_loot_template",             "item entry (herb)",               true, WORLD_LOAD_MILLING_LOOT_TEMPLATES);
+LootStore LootTemplates_Pickpocketing("pickpocketing_loot_template", "creature pickpocket lootid",      true, WORLD_LOAD_PICKPOCKETING_LOOT_TEMPLATES);
+LootStore LootTemplates_Prospecting("prospecting_loot_template",     "item entry (ore)",                true, WORLD_LOAD_PROSPECTING_LOOT_TEMPLATES);
+LootStore LootTemplates_Reference("reference_loot_template",         "reference id",                    false, WORLD_LOAD_REFERENCE_LOOT_TEMPLATES);
+LootStore LootTemplates_Skinning("skinning_loot_template",           "creature skinning id",            true, WORLD_LOAD_SKINNING_LOOT_TEMPLATES);
+LootStore LootTemplates_Spell("spell_loot_template",                 "spell id (random item creating)", false, WORLD_LOAD_SPELL_LOOT_TEMPLATES);
 
 class LootTemplate::LootGroup                               // A set of loot definitions for items (refs are not allowed)
 {
@@ -98,8 +98,8 @@ uint32 LootStore::LoadLootTable()
     // Clearing store (for reloading case)
     Clear();
 
-    //                                                  0     1            2               3         4         5             6
-    QueryResult result = WorldDatabase.PQuery("SELECT entry, item, ChanceOrQuestChance, lootmode, groupid, mincountOrRef, maxcount FROM %s", GetName());
+    PreparedStatement* stmt = WorldDatabase.GetPreparedStatement(m_loadStatement);
+    PreparedQueryResult result = WorldDatabase.Query(stmt);
 
     if (!result)
     {
@@ -178,8 +178,8 @@ typedef std::set<uint32> LootIdSet;
 class LootStore
 {
     public:
-        explicit LootStore(char const* name, char const* entryName, bool ratesAllowed)
-            : m_name(name), m_entryName(entryName), m_ratesAllowed(ratesAllowed) {}
+        explicit LootStore(char const* name, char const* entryName, bool ratesAllowed, uint32 loadStatement)
+            : m_name(name), m_entryName(entryName), m_ratesAllowed(ratesAllowed), m_loadStatement(loadStatement) {}
 
         virtual ~LootStore() { Clear(); }
 
@@ -209,6 +209,7 @@ class LootStore
         char const* m_name;
         char const* m_entryName;
         bool m_ratesAllowed;
+        uint32 m_loadStatement;                             // WorldDatabaseStatements, loads the table
 };
 
 class LootTemplate
@@ -30,6 +30,10 @@
 #include "MapManager.h"
 #include "ObjectMgr.h"
 #include "Group.h"
+#include "SharedWorldPacket.h"
+#include "PoolMgr.h"
+
+#include <ace/Mem_Map.h>
 
 
 union u_map_magic
@@ -55,6 +59,7 @@ Map::~Map()
     sScriptMgr->OnDestroyMap(this);
 
     UnloadAll();
+    UnloadPreloadedGridMaps(true);
 
     while (!i_worldObjects.empty())
     {
@@ -179,10 +184,225 @@ void Map::LoadMap(int gx, int gy, bool reload)
     sScriptMgr->OnLoadGridMap(this, GridMaps[gx][gy], gx, gy);
 }
 
+class GridMapPreloadRequest : public ACE_Method_Request
+{
+    private:
+
+        Map& m_map;
+        uint32 m_gx;
+        uint32 m_gy;
+        uint32 m_request;
+        std::string m_filename;
+
+    public:
+
+        GridMapPreloadRequest(Map& map, uint32 gx, uint32 gy, uint32 request, std::string const& filename)
+            : m_map(map), m_gx(gx), m_gy(gy), m_request(request), m_filename(filename)
+        {
+        }
+
+        virtual int call()
+        {
+            GridMap* gmap = new GridMap();
+            if (!gmap->loadData(m_filename.c_str()))
+            {
+                // leave it to LoadMap, which reports the error
+                delete gmap;
+                gmap = NULL;
+            }
+
+            if (m_map.SetPreloadedGridMap(m_gx, m_gy, m_request, gmap))
+                m_map.PreloadVMap(m_gx, m_gy, m_request);
+            return 0;
+        }
+};
+
+bool Map::CanPreloadGridMaps() const
+{
+    // instances share the grid maps of their base map
+    return !Instanceable() && sMapMgr->GetGridPreloader()->activated();
+}
+
+void Map::PreloadGridMapsAhead(Player* player)
+{
+    if (!player->isMoving() && !player->isInFlight())
+        return;
+
+    float speed = player->GetSpeed(player->IsFlying() || player->isInFlight() ? MOVE_FLIGHT : MOVE_RUN);
+    float distance = speed * sWorld->getIntConfig(CONFIG_GRID_PRELOAD_LOOKAHEAD);
+    float range = GetVisibilityRange();
+    float step = SIZE_OF_GRIDS / 2;
+
+    // grids in visibility range of the way the player will have gone in the look ahead time
+    for (float travelled = step; travelled < distance + step; travelled += step)
+    {
+        float d = std::min(travelled, distance);
+        float x = player->GetPositionX() + d * cos(player->GetOrientation());
+        float y = player->GetPositionY() + d * sin(player->GetOrientation());
+
+        float lowX = x - range, lowY = y - range, highX = x + range, highY = y + range;
+        Trinity::NormalizeMapCoord(lowX);
+        Trinity::NormalizeMapCoord(lowY);
+        Trinity::NormalizeMapCoord(highX);
+        Trinity::NormalizeMapCoord(highY);
+
+        GridPair low = Trinity::ComputeGridPair(lowX, lowY);
+        GridPair high = Trinity::ComputeGridPair(highX, highY);
+        for (uint32 x_coord = low.x_coord; x_coord <= high.x_coord; ++x_coord)
+            for (uint32 y_coord = low.y_coord; y_coord <= high.y_coord; ++y_coord)
+                PreloadGridMap(63 - x_coord, 63 - y_coord);
+    }
+}
+
+void Map::PreloadGridMap(uint32 gx, uint32 gy)
+{
+    uint32 request;
+
+    {
+        // instances create the grids of their base map from their own threads
+        ACE_GUARD(ACE_Thread_Mutex, GridGuard, Lock);
+        if (GridMaps[gx][gy])
+            return;
+
+        ACE_GUARD(ACE_Thread_Mutex, Guard, i_preloadLock);
+
+        PreloadedGridMap& entry = i_preloadedGridMaps[gx * MAX_NUMBER_OF_GRIDS + gy];
+        if (entry.request)
+            return;                                         // loaded or being loaded
+
+        entry.request = request = ++i_preloadRequests;
+        entry.gridMap = NULL;
+        entry.vmapLoading = false;
+        entry.vmapLoaded = false;
+        entry.loaded = false;
+        entry.loadTime = sWorld->GetGameTime();
+    }
+
+    int len = sWorld->GetDataPath().length()+strlen("maps/%03u%02u%02u.map")+1;
+    char* tmp = new char[len];
+    snprintf(tmp, len, (char *)(sWorld->GetDataPath()+"maps/%03u%02u%02u.map").c_str(), GetId(), gx, gy);
+    sMapMgr->GetGridPreloader()->execute(new GridMapPreloadRequest(*this, gx, gy, request, tmp));
+    delete [] tmp;
+}
+
+bool Map::SetPreloadedGridMap(uint32 gx, uint32 gy, uint32 request, GridMap* gmap)
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, Guard, i_preloadLock, false);
+
+    // the grid was created while its terrain was being loaded, and possibly
+    // unloaded and preloaded again since, or the slot is already filled
+    PreloadedGridMapMap::iterator itr = i_preloadedGridMaps.find(gx * MAX_NUMBER_OF_GRIDS + gy);
+    if (itr == i_preloadedGridMaps.end() || itr->second.request != request || itr->second.gridMap)
+    {
+        delete gmap;
+        return false;
+    }
+
+    // a terrain that could not be read is left to LoadMap, the vmap tile still goes on
+    itr->second.gridMap = gmap;
+    itr->second.vmapLoading = true;
+    return true;
+}
+
+void Map::PreloadVMap(uint32 gx, uint32 gy, uint32 request)
+{
+    // held while the tile loads, so that a grid created meanwhile waits for it instead of loading it twice
+    ACE_GUARD(ACE_Thread_Mutex, VMapGuard, i_vmapPreloadLock);
+
+    {
+        ACE_GUARD(ACE_Thread_Mutex, Guard, i_preloadLock);
+
+        PreloadedGridMapMap::iterator itr = i_preloadedGridMaps.find(gx * MAX_NUMBER_OF_GRIDS + gy);
+        if (itr == i_preloadedGridMaps.end() || itr->second.request != request)
+            return;
+    }
+
+    // VMapManager2 loads tiles while the map threads query it
+    bool vmapLoaded = VMAP::VMapFactory::createOrGetVMapManager()->isMapLoadingEnabled();
+    if (vmapLoaded)
+        LoadVMap(gx, gy);
+
+    ACE_GUARD(ACE_Thread_Mutex, Guard, i_preloadLock);
+
+    PreloadedGridMapMap::iterator itr = i_preloadedGridMaps.find(gx * MAX_NUMBER_OF_GRIDS + gy);
+    ASSERT(itr != i_preloadedGridMaps.end() && itr->second.request == request);
+    itr->second.vmapLoading = false;
+    itr->second.vmapLoaded = vmapLoaded;
+    itr->second.loaded = true;
+    itr->second.loadTime = sWorld->GetGameTime();
+}
+
+GridMap* Map::TakePreloadedGridMap(uint32 gx, uint32 gy, bool& vmapLoaded)
+{
+    vmapLoaded = false;
+
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, Guard, i_preloadLock, NULL);
+
+        PreloadedGridMapMap::iterator itr = i_preloadedGridMaps.find(gx * MAX_NUMBER_OF_GRIDS + gy);
+        if (itr == i_preloadedGridMaps.end())
+            return NULL;
+
+        // a terrain load still in progress is discarded when it finishes
+        if (!itr->second.vmapLoading)
+        {
+            GridMap* gmap = itr->second.gridMap;
+            vmapLoaded = itr->second.vmapLoaded;
+            i_preloadedGridMaps.erase(itr);
+            return gmap;
+        }
+    }
+
+    // the vmap tile of the grid is being loaded, wait for it
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, VMapGuard, i_vmapPreloadLock, NULL);
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, Guard, i_preloadLock, NULL);
+
+    // or the request did not get to it yet, then it finds the entry gone
+    PreloadedGridMapMap::iterator itr = i_preloadedGridMaps.find(gx * MAX_NUMBER_OF_GRIDS + gy);
+    ASSERT(itr != i_preloadedGridMaps.end());
+    GridMap* gmap = itr->second.gridMap;
+    vmapLoaded = itr->second.vmapLoaded;
+    i_preloadedGridMaps.erase(itr);
+    return gmap;
+}
+
+void Map::UnloadPreloadedGridMaps(bool all)
+{
+    ACE_GUARD(ACE_Thread_Mutex, Guard, i_preloadLock);
+
+    time_t expireTime = sWorld->GetGameTime() - i_gridExpiry / IN_MILLISECONDS;
+    for (PreloadedGridMapMap::iterator itr = i_preloadedGridMaps.begin(); itr != i_preloadedGridMaps.end();)
+    {
+        // the players did not come after all
+        if (all || (itr->second.loaded && itr->second.loadTime < expireTime))
+        {
+            delete itr->second.gridMap;
+            if (itr->second.vmapLoaded)
+                VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(GetId(), itr->first / MAX_NUMBER_OF_GRIDS, itr->first % MAX_NUMBER_OF_GRIDS);
+            i_preloadedGridMaps.erase(itr++);
+        }
+        else
+            ++itr;
+    }
+}
+
 void Map::LoadMapAndVMap(int gx, int gy)
 {
+    bool vmapLoaded = false;
+
+    // terrain and vmap tile already read by the grid preloader
+    if (i_InstanceId == 0 && !GridMaps[gx][gy])
+    {
+        if (GridMap* gmap = TakePreloadedGridMap(gx, gy, vmapLoaded))
+        {
+            sLog->outDetail("Using preloaded map %u grid [%u,%u]", GetId(), gx, gy);
+            GridMaps[gx][gy] = gmap;
+            sScriptMgr->OnLoadGridMap(this, gmap, gx, gy);
+        }
+    }
+
     LoadMap(gx, gy);
-    if (i_InstanceId == 0)
+    if (i_InstanceId == 0 && !vmapLoaded)
         LoadVMap(gx, gy);                                   // Only load the data for the base map
 }
 
@@ -206,7 +426,8 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode, Map* _par
 i_mapEntry (sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode), i_InstanceId(InstanceId),
 m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
 m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
-m_activeNonPlayersIter(m_activeNonPlayers.end()), i_gridExpiry(expiry), i_scriptLock(false)
+m_activeNonPlayersIter(m_activeNonPlayers.end()), m_lastUpdateTime(0), m_maxUpdateTime(0),
+i_gridExpiry(expiry), i_preloadRequests(0), i_scriptLock(false), i_regionUpdate(false)
 {
     m_parentMap = (_parent ? _parent : this);
     for (unsigned int idx=0; idx < MAX_NUMBER_OF_GRIDS; ++idx)
@@ -400,6 +621,14 @@ bool Map::EnsureGridLoaded(const Cell &cell)
 void Map::LoadGrid(float x, float y)
 {
     CellPair pair = Trinity::ComputeCellPair(x, y);
+
+    if (i_regionUpdate)
+    {
+        ACE_GUARD(ACE_Thread_Mutex, Guard, i_regionLock);
+        i_cellsToLoad.push_back(pair);
+        return;
+    }
+
     Cell cell(pair);
     EnsureGridLoaded(cell);
 }
@@ -453,6 +682,10 @@ Map::Add(T *obj)
         return;
     }
 
+    // grids are not created nor loaded by the parallel region updates
+    if (!loaded(GridPair(cell.GridX(), cell.GridY())) && QueueRegionAdd(obj))
+        return;
+
     if (obj->isActiveObject())
         EnsureGridLoadedAtEnter(cell);
     else
@@ -515,6 +748,251 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::Obj
     }
 }
 
+class MapRegionUpdateRequest : public MapUpdaterTask
+{
+    public:
+
+        MapRegionUpdateRequest(Map& map, uint32 diff) : m_map(map), m_diff(diff) {}
+
+        void call() { m_map.UpdateCells(m_cells, m_diff, true); }
+
+        ACE_UINT32 GetWeight() const { return ACE_UINT32(m_cells.size()); }
+
+        std::vector<uint32> m_cells;
+
+    private:
+
+        Map& m_map;
+        uint32 m_diff;
+};
+
+bool Map::CanUpdateRegions() const
+{
+    // only for continents, and only when there are map update threads to help
+    return sWorld->getBoolConfig(CONFIG_MAP_UPDATE_REGIONS) && !Instanceable() && sMapMgr->GetMapUpdater()->activated();
+}
+
+void Map::MarkNearbyCellsOf(WorldObject* obj, std::vector<uint32>& cells)
+{
+    CellPair standing_cell(Trinity::ComputeCellPair(obj->GetPositionX(), obj->GetPositionY()));
+
+    if (standing_cell.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || standing_cell.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
+        return;
+
+    CellPair begin_cell(standing_cell), end_cell(standing_cell);
+    CellArea area = Cell::CalculateCellArea(*obj, obj->GetGridActivationRange());
+    area.ResizeBorders(begin_cell, end_cell);
+
+    for (uint32 x = begin_cell.x_coord; x <= end_cell.x_coord; ++x)
+    {
+        for (uint32 y = begin_cell.y_coord; y <= end_cell.y_coord; ++y)
+        {
+            uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
+            if (isCellMarked(cell_id))
+                continue;
+
+            markCell(cell_id);
+            cells.push_back(cell_id);
+
+            // grids are loaded here, never from the parallel region updates
+            EnsureGridLoaded(Cell(CellPair(x, y)));
+        }
+    }
+}
+
+void Map::UpdateRegions(std::vector<uint32> const& cells, const uint32 t_diff)
+{
+    // A region is a grid with marked cells. Regions closer than this many grids
+    // may interact (visitors reach up to one grid far) and are updated together.
+    static const int32 REGION_MERGE_DISTANCE = 2;
+
+    int32 regionOf[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+    memset(regionOf, -1, sizeof(regionOf));
+
+    std::vector<GridPair> grids;
+    for (std::vector<uint32>::const_iterator itr = cells.begin(); itr != cells.end(); ++itr)
+    {
+        uint32 gx = (*itr % TOTAL_NUMBER_OF_CELLS_PER_MAP) / MAX_NUMBER_OF_CELLS;
+        uint32 gy = (*itr / TOTAL_NUMBER_OF_CELLS_PER_MAP) / MAX_NUMBER_OF_CELLS;
+        if (regionOf[gx][gy] == -1)
+        {
+            regionOf[gx][gy] = -2;                          // active, not yet assigned
+            grids.push_back(GridPair(gx, gy));
+        }
+    }
+
+    // connected components of the active grids
+    int32 regionCount = 0;
+    std::vector<GridPair> open;
+    for (std::vector<GridPair>::const_iterator itr = grids.begin(); itr != grids.end(); ++itr)
+    {
+        if (regionOf[itr->x_coord][itr->y_coord] != -2)
+            continue;
+
+        regionOf[itr->x_coord][itr->y_coord] = regionCount;
+        open.push_back(*itr);
+        while (!open.empty())
+        {
+            GridPair grid = open.back();
+            open.pop_back();
+
+            int32 minX = std::max(int32(grid.x_coord) - REGION_MERGE_DISTANCE, 0);
+            int32 maxX = std::min(int32(grid.x_coord) + REGION_MERGE_DISTANCE, int32(MAX_NUMBER_OF_GRIDS) - 1);
+            int32 minY = std::max(int32(grid.y_coord) - REGION_MERGE_DISTANCE, 0);
+            int32 maxY = std::min(int32(grid.y_coord) + REGION_MERGE_DISTANCE, int32(MAX_NUMBER_OF_GRIDS) - 1);
+            for (int32 x = minX; x <= maxX; ++x)
+            {
+                for (int32 y = minY; y <= maxY; ++y)
+                {
+                    if (regionOf[x][y] != -2)
+                        continue;
+
+                    regionOf[x][y] = regionCount;
+                    open.push_back(GridPair(x, y));
+                }
+            }
+        }
+        ++regionCount;
+    }
+
+    if (regionCount <= 1)
+    {
+        UpdateCells(cells, t_diff);
+        return;
+    }
+
+    std::vector<MapRegionUpdateRequest*> regions(regionCount);
+    for (int32 i = 0; i < regionCount; ++i)
+        regions[i] = new MapRegionUpdateRequest(*this, t_diff);
+
+    for (std::vector<uint32>::const_iterator itr = cells.begin(); itr != cells.end(); ++itr)
+    {
+        uint32 gx = (*itr % TOTAL_NUMBER_OF_CELLS_PER_MAP) / MAX_NUMBER_OF_CELLS;
+        uint32 gy = (*itr / TOTAL_NUMBER_OF_CELLS_PER_MAP) / MAX_NUMBER_OF_CELLS;
+        regions[regionOf[gx][gy]]->m_cells.push_back(*itr);
+    }
+
+    std::vector<MapUpdaterTask*> tasks(regions.begin(), regions.end());
+
+    // scripts started from the regions are run in the serial part of the update
+    bool scriptLock = i_scriptLock;
+    i_scriptLock = true;
+    i_regionUpdate = true;
+    sMapMgr->GetMapUpdater()->run_tasks(tasks);
+    i_regionUpdate = false;
+    i_scriptLock = scriptLock;
+
+    ProcessRegionQueues(t_diff);
+}
+
+void Map::ProcessRegionQueues(const uint32 t_diff)
+{
+    // the pool updates of the regions, spawning outside of them is safe again
+    std::vector<PoolUpdate> poolUpdates;
+    poolUpdates.swap(i_poolUpdates);
+    for (std::vector<PoolUpdate>::const_iterator itr = poolUpdates.begin(); itr != poolUpdates.end(); ++itr)
+    {
+        if (itr->creature)
+            UpdatePool<Creature>(itr->poolId, itr->dbGuid);
+        else
+            UpdatePool<GameObject>(itr->poolId, itr->dbGuid);
+    }
+
+    std::vector<CellPair> cellsToLoad;
+    cellsToLoad.swap(i_cellsToLoad);
+    for (std::vector<CellPair>::const_iterator itr = cellsToLoad.begin(); itr != cellsToLoad.end(); ++itr)
+        EnsureGridLoaded(Cell(*itr));
+
+    std::vector<WorldObject*> objectsToAdd;
+    objectsToAdd.swap(i_objectsToAdd);
+    for (std::vector<WorldObject*>::const_iterator itr = objectsToAdd.begin(); itr != objectsToAdd.end(); ++itr)
+    {
+        switch ((*itr)->GetTypeId())
+        {
+            case TYPEID_UNIT:
+                Add((*itr)->ToCreature());
+                break;
+            case TYPEID_GAMEOBJECT:
+                Add((GameObject*)*itr);
+                break;
+            case TYPEID_DYNAMICOBJECT:
+                Add((DynamicObject*)*itr);
+                break;
+            case TYPEID_CORPSE:
+                Add((Corpse*)*itr);
+                break;
+            default:
+                break;
+        }
+    }
+
+    // objects sharing state with other regions, through their zone script or formation
+    std::vector<WorldObject*> serialObjects;
+    serialObjects.swap(i_serialObjects);
+    for (std::vector<WorldObject*>::const_iterator itr = serialObjects.begin(); itr != serialObjects.end(); ++itr)
+        if ((*itr)->IsInWorld())
+            (*itr)->Update(t_diff);
+}
+
+template<class T>
+bool Map::QueueRegionAdd(T* obj)
+{
+    if (!i_regionUpdate)
+        return false;
+
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, Guard, i_regionLock, false);
+    i_objectsToAdd.push_back(obj);
+    return true;
+}
+
+bool Map::QueuePoolUpdate(bool creature, uint32 poolId, uint32 dbGuid)
+{
+    if (!i_regionUpdate)
+        return false;
+
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, Guard, i_regionLock, false);
+    PoolUpdate update = { creature, poolId, dbGuid };
+    i_poolUpdates.push_back(update);
+    return true;
+}
+
+template<>
+void Map::UpdatePool<Creature>(uint32 poolId, uint32 dbGuid)
+{
+    if (!QueuePoolUpdate(true, poolId, dbGuid))
+        sPoolMgr->UpdatePool<Creature>(poolId, dbGuid);
+}
+
+template<>
+void Map::UpdatePool<GameObject>(uint32 poolId, uint32 dbGuid)
+{
+    if (!QueuePoolUpdate(false, poolId, dbGuid))
+        sPoolMgr->UpdatePool<GameObject>(poolId, dbGuid);
+}
+
+void Map::UpdateCells(std::vector<uint32> const& cells, const uint32 t_diff, bool region)
+{
+    std::vector<WorldObject*> serialObjects;
+    Trinity::ObjectUpdater updater(t_diff, region ? &serialObjects : NULL);
+    TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
+    TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
+
+    for (std::vector<uint32>::const_iterator itr = cells.begin(); itr != cells.end(); ++itr)
+    {
+        CellPair pair(*itr % TOTAL_NUMBER_OF_CELLS_PER_MAP, *itr / TOTAL_NUMBER_OF_CELLS_PER_MAP);
+        Cell cell(pair);
+        cell.data.Part.reserved = CENTER_DISTRICT;
+        cell.Visit(pair, grid_object_update,  *this);
+        cell.Visit(pair, world_object_update, *this);
+    }
+
+    if (!serialObjects.empty())
+    {
+        ACE_GUARD(ACE_Thread_Mutex, Guard, i_regionLock);
+        i_serialObjects.insert(i_serialObjects.end(), serialObjects.begin(), serialObjects.end());
+    }
+}
+
 void Map::Update(const uint32 t_diff)
 {
     /// update worldsessions for existing players
@@ -529,6 +1007,19 @@ void Map::Update(const uint32 t_diff)
             pSession->Update(t_diff, updater);
         }
     }
+    // start reading the terrain of the grids the players are heading to
+    if (CanPreloadGridMaps())
+    {
+        UnloadPreloadedGridMaps(false);
+
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+        {
+            Player* plr = m_mapRefIter->getSource();
+            if (plr && plr->IsInWorld())
+                PreloadGridMapsAhead(plr);
+        }
+    }
+
     /// update active cells around players and active objects
     resetMarkedCells();
 
@@ -538,31 +1029,65 @@ void Map::Update(const uint32 t_diff)
     // for pets
     TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
 
-    // the player iterator is stored in the map object
-    // to make sure calls to Map::Remove don't invalidate it
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+    if (CanUpdateRegions())
     {
-        Player* plr = m_mapRefIter->getSource();
+        // players and the cells to update around them are handled here, the objects
+        // in these cells are updated per region, in parallel where regions are apart
+        std::vector<uint32> cells;
 
-        if (!plr || !plr->IsInWorld())
-            continue;
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+        {
+            Player* plr = m_mapRefIter->getSource();
+
+            if (!plr || !plr->IsInWorld())
+                continue;
 
-        // update players at tick
-        plr->Update(t_diff);
+            plr->Update(t_diff);
 
-        VisitNearbyCellsOf(plr, grid_object_update, world_object_update);
-    }
+            MarkNearbyCellsOf(plr, cells);
+        }
+
+        for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
+        {
+            WorldObject* obj = *m_activeNonPlayersIter;
+            ++m_activeNonPlayersIter;
 
-    // non-player active objects, increasing iterator in the loop in case of object removal
-    for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
+            if (!obj || !obj->IsInWorld())
+                continue;
+
+            MarkNearbyCellsOf(obj, cells);
+        }
+
+        UpdateRegions(cells, t_diff);
+    }
+    else
     {
-        WorldObject* obj = *m_activeNonPlayersIter;
-        ++m_activeNonPlayersIter;
+        // the player iterator is stored in the map object
+        // to make sure calls to Map::Remove don't invalidate it
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+        {
+            Player* plr = m_mapRefIter->getSource();
 
-        if (!obj || !obj->IsInWorld())
-            continue;
+            if (!plr || !plr->IsInWorld())
+                continue;
 
-        VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
+            // update players at tick
+            plr->Update(t_diff);
+
+            VisitNearbyCellsOf(plr, grid_object_update, world_object_update);
+        }
+
+        // non-player active objects, increasing iterator in the loop in case of object removal
+        for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
+        {
+            WorldObject* obj = *m_activeNonPlayersIter;
+            ++m_activeNonPlayersIter;
+
+            if (!obj || !obj->IsInWorld())
+                continue;
+
+            VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
+        }
     }
 
     ///- Process necessary scripts
@@ -579,6 +1104,34 @@ void Map::Update(const uint32 t_diff)
         ProcessRelocationNotifies(t_diff);
 
     sScriptMgr->OnMapUpdate(this, t_diff);
+
+    SendObjectUpdates();
+}
+
+void Map::SendObjectUpdates()
+{
+    UpdateDataMapType update_players;
+
+    // Critical section
+    {
+        ACE_GUARD(ACE_Thread_Mutex, Guard, i_objectsToUpdateLock);
+
+        while (!i_objectsToUpdate.empty())
+        {
+            Object* obj = *i_objectsToUpdate.begin();
+            ASSERT(obj && obj->IsInWorld());
+            i_objectsToUpdate.erase(i_objectsToUpdate.begin());
+            obj->BuildUpdate(update_players);
+        }
+    }
+
+    WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
+    for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
+    {
+        iter->second.BuildPacket(&packet);
+        iter->first->GetSession()->SendPacket(&packet);
+        packet.clear();                                     // clean the string
+    }
 }
 
 struct ResetNotifier
@@ -704,6 +1257,13 @@ template<class T>
 void
 Map::Remove(T *obj, bool remove)
 {
+    if (i_regionUpdate)
+    {
+        ACE_GUARD(ACE_Thread_Mutex, Guard, i_regionLock);
+        i_objectsToAdd.erase(std::remove(i_objectsToAdd.begin(), i_objectsToAdd.end(), obj), i_objectsToAdd.end());
+        i_serialObjects.erase(std::remove(i_serialObjects.begin(), i_serialObjects.end(), obj), i_serialObjects.end());
+    }
+
     obj->RemoveFromWorld();
     if (obj->isActiveObject())
         RemoveFromActive(obj);
@@ -802,6 +1362,7 @@ void Map::AddCreatureToMoveList(Creature *c, float x, float y, float z, float an
     if (!c)
         return;
 
+    ACE_GUARD(ACE_Thread_Mutex, Guard, i_regionLock);
     i_creaturesToMove[c] = CreatureMover(x, y, z, ang);
 }
 
@@ -1045,6 +1606,7 @@ GridMap::GridMap()
     m_liquidLevel = INVALID_HEIGHT;
     m_liquid_type = NULL;
     m_liquid_map  = NULL;
+    m_mapping = NULL;
 }
 
 GridMap::~GridMap()
@@ -1052,11 +1614,14 @@ GridMap::~GridMap()
     unloadData();
 }
 
-bool GridMap::loadData(char *filename)
+bool GridMap::loadData(char const* filename)
 {
     // Unload old data if exist
     unloadData();
 
+    if (sWorld->getBoolConfig(CONFIG_GRID_MAP_MEMORY_MAPPED) && mapData(filename))
+        return true;
+
     map_fileheader header;
     // Not return error if file not found
     FILE *in = fopen(filename, "rb");
@@ -1102,11 +1667,19 @@ bool GridMap::loadData(char *filename)
 
 void GridMap::unloadData()
 {
-    delete[] m_area_map;
-    delete[] m_V9;
-    delete[] m_V8;
-    delete[] m_liquid_type;
-    delete[] m_liquid_map;
+    if (m_mapping)
+    {
+        delete m_mapping;
+        m_mapping = NULL;
+    }
+    else
+    {
+        delete[] m_area_map;
+        delete[] m_V9;
+        delete[] m_V8;
+        delete[] m_liquid_type;
+        delete[] m_liquid_map;
+    }
     m_area_map = NULL;
     m_V9 = NULL;
     m_V8 = NULL;
@@ -1209,6 +1782,139 @@ bool  GridMap::loadLiquidData(FILE *in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
+// alignment T requires, the padding in front of a T that follows a char
+template<class T>
+struct MappedAlignment
+{
+    struct Probe { char c; T t; };
+    enum { value = sizeof(Probe) - sizeof(T) };
+};
+
+// pointer to count elements of T at offset inside the mapping, NULL if they are not usable in place
+template<class T>
+static T* GetMappedArray(uint8 *data, size_t size, size_t offset, size_t count)
+{
+    if (offset > size || count * sizeof(T) > size - offset || (size_t(data + offset) % MappedAlignment<T>::value) != 0)
+        return NULL;
+
+    return reinterpret_cast<T*>(data + offset);
+}
+
+bool GridMap::mapData(char const* filename)
+{
+    ACE_Mem_Map* mapping = new ACE_Mem_Map();
+    if (mapping->map(filename, static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ, ACE_MAP_SHARED) == -1)
+    {
+        // missing files are handled by the regular load
+        delete mapping;
+        return false;
+    }
+
+    // the mapping stays valid without the file handle
+    mapping->close_handle();
+    m_mapping = mapping;
+
+    uint8* data = static_cast<uint8*>(mapping->addr());
+    size_t size = mapping->size();
+
+    map_fileheader const* header = GetMappedArray<map_fileheader>(data, size, 0, 1);
+    if (header && header->mapMagic == MapMagic.asUInt && header->versionMagic == MapVersionMagic.asUInt &&
+        (!header->areaMapOffset || mapAreaData(data, size, header->areaMapOffset)) &&
+        (!header->heightMapOffset || mapHeightData(data, size, header->heightMapOffset)) &&
+        (!header->liquidMapOffset || mapLiquidData(data, size, header->liquidMapOffset)))
+        return true;
+
+    // let the regular load copy the data or report the error
+    sLog->outString("Map file '%s' can not be used in place, it is copied into memory instead.", filename);
+    unloadData();
+    return false;
+}
+
+bool GridMap::mapAreaData(uint8 *data, size_t size, uint32 offset)
+{
+    map_areaHeader const* header = GetMappedArray<map_areaHeader>(data, size, offset, 1);
+    if (!header || header->fourcc != MapAreaMagic.asUInt)
+        return false;
+
+    m_gridArea = header->gridArea;
+    if (!(header->flags & MAP_AREA_NO_AREA))
+    {
+        m_area_map = GetMappedArray<uint16>(data, size, offset + sizeof(map_areaHeader), 16*16);
+        if (!m_area_map)
+            return false;
+    }
+    return true;
+}
+
+bool GridMap::mapHeightData(uint8 *data, size_t size, uint32 offset)
+{
+    map_heightHeader const* header = GetMappedArray<map_heightHeader>(data, size, offset, 1);
+    if (!header || header->fourcc != MapHeightMagic.asUInt)
+        return false;
+
+    m_gridHeight = header->gridHeight;
+    if (!(header->flags & MAP_HEIGHT_NO_HEIGHT))
+    {
+        size_t start = offset + sizeof(map_heightHeader);
+        if ((header->flags & MAP_HEIGHT_AS_INT16))
+        {
+            m_uint16_V9 = GetMappedArray<uint16>(data, size, start, 129*129);
+            m_uint16_V8 = GetMappedArray<uint16>(data, size, start + 129*129*sizeof(uint16), 128*128);
+            m_gridIntHeightMultiplier = (header->gridMaxHeight - header->gridHeight) / 65535;
+            m_gridGetHeight = &GridMap::getHeightFromUint16;
+        }
+        else if ((header->flags & MAP_HEIGHT_AS_INT8))
+        {
+            m_uint8_V9 = GetMappedArray<uint8>(data, size, start, 129*129);
+            m_uint8_V8 = GetMappedArray<uint8>(data, size, start + 129*129*sizeof(uint8), 128*128);
+            m_gridIntHeightMultiplier = (header->gridMaxHeight - header->gridHeight) / 255;
+            m_gridGetHeight = &GridMap::getHeightFromUint8;
+        }
+        else
+        {
+            m_V9 = GetMappedArray<float>(data, size, start, 129*129);
+            m_V8 = GetMappedArray<float>(data, size, start + 129*129*sizeof(float), 128*128);
+            m_gridGetHeight = &GridMap::getHeightFromFloat;
+        }
+
+        if (!m_V9 || !m_V8)
+            return false;
+    }
+    else
+        m_gridGetHeight = &GridMap::getHeightFromFlat;
+    return true;
+}
+
+bool GridMap::mapLiquidData(uint8 *data, size_t size, uint32 offset)
+{
+    map_liquidHeader const* header = GetMappedArray<map_liquidHeader>(data, size, offset, 1);
+    if (!header || header->fourcc != MapLiquidMagic.asUInt)
+        return false;
+
+    m_liquidType   = header->liquidType;
+    m_liquid_offX  = header->offsetX;
+    m_liquid_offY  = header->offsetY;
+    m_liquid_width = header->width;
+    m_liquid_height= header->height;
+    m_liquidLevel  = header->liquidLevel;
+
+    size_t start = offset + sizeof(map_liquidHeader);
+    if (!(header->flags & MAP_LIQUID_NO_TYPE))
+    {
+        m_liquid_type = GetMappedArray<uint8>(data, size, start, 16*16);
+        if (!m_liquid_type)
+            return false;
+        start += 16*16*sizeof(uint8);
+    }
+    if (!(header->flags & MAP_LIQUID_NO_HEIGHT))
+    {
+        m_liquid_map = GetMappedArray<float>(data, size, start, m_liquid_width*m_liquid_height);
+        if (!m_liquid_map)
+            return false;
+    }
+    return true;
+}
+
 uint16 GridMap::getArea(float x, float y)
 {
     if (!m_area_map)
@@ -1542,8 +2248,9 @@ inline GridMap *Map::GetGrid(float x, float y)
     int gx=(int)(32-x/SIZE_OF_GRIDS);                       //grid x
     int gy=(int)(32-y/SIZE_OF_GRIDS);                       //grid y
 
-    // ensure GridMap is loaded
-    EnsureGridCreated(GridPair(63-gx, 63-gy));
+    // ensure GridMap is loaded, unless grids can't be created now
+    if (!i_regionUpdate)
+        EnsureGridCreated(GridPair(63-gx, 63-gy));
 
     return GridMaps[gx][gy];
 }
@@ -1993,6 +2700,7 @@ void Map::AddObjectToRemoveList(WorldObject *obj)
 
     obj->CleanupsBeforeDelete(false);                            // remove or simplify at least cross referenced links
 
+    ACE_GUARD(ACE_Thread_Mutex, Guard, i_regionLock);
     i_objectsToRemove.insert(obj);
     //sLog->outDebug(LOG_FILTER_MAPS, "Object (GUID: %u TypeId: %u) added to removing list.", obj->GetGUIDLow(), obj->GetTypeId());
 }
@@ -2001,6 +2709,7 @@ void Map::AddObjectToSwitchList(WorldObject *obj, bool on)
 {
     ASSERT(obj->GetMapId() == GetId() && obj->GetInstanceId() == GetInstanceId());
 
+    ACE_GUARD(ACE_Thread_Mutex, Guard, i_regionLock);
     std::map<WorldObject*, bool>::iterator itr = i_objectsToSwitch.find(obj);
     if (itr == i_objectsToSwitch.end())
         i_objectsToSwitch.insert(itr, std::make_pair(obj, on));
@@ -2081,8 +2790,9 @@ uint32 Map::GetPlayersCountExceptGMs() const
 
 void Map::SendToPlayers(WorldPacket const* data) const
 {
+    SharedWorldPacket shared(*data);
     for (MapRefManager::const_iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
-        itr->getSource()->GetSession()->SendPacket(data);
+        itr->getSource()->GetSession()->SendPacket(shared);
 }
 
 bool Map::ActiveObjectsNearGrid(uint32 x, uint32 y) const
@@ -34,6 +34,7 @@
 #include <bitset>
 #include <list>
 
+class ACE_Mem_Map;
 class Unit;
 class WorldPacket;
 class InstanceScript;
@@ -168,10 +169,18 @@ class GridMap
     uint8  *m_liquid_type;
     float  *m_liquid_map;
 
+    // file mapping the data points into, NULL when the data was copied
+    ACE_Mem_Map *m_mapping;
+
     bool  loadAreaData(FILE *in, uint32 offset, uint32 size);
     bool  loadHeihgtData(FILE *in, uint32 offset, uint32 size);
     bool  loadLiquidData(FILE *in, uint32 offset, uint32 size);
 
+    bool  mapData(char const* filename);
+    bool  mapAreaData(uint8 *data, size_t size, uint32 offset);
+    bool  mapHeightData(uint8 *data, size_t size, uint32 offset);
+    bool  mapLiquidData(uint8 *data, size_t size, uint32 offset);
+
     // Get height functions and pointers
     typedef float (GridMap::*pGetHeightPtr) (float x, float y) const;
     pGetHeightPtr m_gridGetHeight;
@@ -183,7 +192,7 @@ class GridMap
 public:
     GridMap();
     ~GridMap();
-    bool  loadData(char *filaname);
+    bool  loadData(char const* filename);
     void  unloadData();
 
     uint16 getArea(float x, float y);
@@ -239,6 +248,7 @@ typedef std::map<uint32/*leaderDBGUID*/, CreatureGroup*>        CreatureGroupHol
 class Map : public GridRefManager<NGridType>
 {
     friend class MapReference;
+    friend class MapRegionUpdateRequest;
     public:
         Map(uint32 id, time_t, uint32 InstanceId, uint8 SpawnMode, Map* _parent = NULL);
         virtual ~Map();
@@ -262,6 +272,16 @@ class Map : public GridRefManager<NGridType>
         void VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer> &worldVisitor);
         virtual void Update(const uint32);
 
+        // duration of the Update() calls done by the map updater, in milliseconds
+        uint32 GetLastUpdateTime() const { return m_lastUpdateTime; }
+        uint32 GetMaxUpdateTime() const { return m_maxUpdateTime; }
+        void SetLastUpdateTime(uint32 time)
+        {
+            m_lastUpdateTime = time;
+            if (time > m_maxUpdateTime)
+                m_maxUpdateTime = time;
+        }
+
         float GetVisibilityRange() const { return m_VisibleDistance; }
         //function for setting up visibility distance for maps on per-type/per-Id basis
         virtual void InitVisibilityDistance();
@@ -378,6 +398,8 @@ class Map : public GridRefManager<NGridType>
         void AddObjectToRemoveList(WorldObject *obj);
         void AddObjectToSwitchList(WorldObject *obj, bool on);
         virtual void DelayedUpdate(const uint32 diff);
+        // update blocks of the objects changed after Map::Update, by DelayedUpdate or transports
+        virtual void SendDelayedObjectUpdates() { SendObjectUpdates(); }
 
         void UpdateObjectVisibility(WorldObject* obj, Cell cell, CellPair cellpair);
         void UpdateObjectsVisibilityFor(Player* player, Cell cell, CellPair cellpair);
@@ -390,8 +412,30 @@ class Map : public GridRefManager<NGridType>
         uint32 GetPlayersCountExceptGMs() const;
         bool ActiveObjectsNearGrid(uint32 x, uint32 y) const;
 
-        void AddWorldObject(WorldObject *obj) { i_worldObjects.insert(obj); }
-        void RemoveWorldObject(WorldObject *obj) { i_worldObjects.erase(obj); }
+        void AddWorldObject(WorldObject *obj)
+        {
+            ACE_GUARD(ACE_Thread_Mutex, Guard, i_regionLock);
+            i_worldObjects.insert(obj);
+        }
+
+        void RemoveWorldObject(WorldObject *obj)
+        {
+            ACE_GUARD(ACE_Thread_Mutex, Guard, i_regionLock);
+            i_worldObjects.erase(obj);
+        }
+
+        // objects with changed fields, their update blocks are sent at the end of Map::Update
+        void AddUpdateObject(Object* obj)
+        {
+            ACE_GUARD(ACE_Thread_Mutex, Guard, i_objectsToUpdateLock);
+            i_objectsToUpdate.insert(obj);
+        }
+
+        void RemoveUpdateObject(Object* obj)
+        {
+            ACE_GUARD(ACE_Thread_Mutex, Guard, i_objectsToUpdateLock);
+            i_objectsToUpdate.erase(obj);
+        }
 
         void SendToPlayers(WorldPacket const* data) const;
 
@@ -402,6 +446,11 @@ class Map : public GridRefManager<NGridType>
         void ScriptsStart(std::map<uint32, std::multimap<uint32, ScriptInfo> > const& scripts, uint32 id, Object* source, Object* target);
         void ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* source, Object* target);
 
+        // a pool update can spawn and despawn objects anywhere on the map, and so load any grid:
+        // while regions are updated in parallel it is queued and run after them
+        template<class T>
+        void UpdatePool(uint32 poolId, uint32 dbGuid);
+
         // must called with AddToWorld
         template<class T>
         void AddToActive(T* obj) { AddToActiveHelper(obj); }
@@ -495,6 +544,9 @@ class Map : public GridRefManager<NGridType>
         ActiveNonPlayers m_activeNonPlayers;
         ActiveNonPlayers::iterator m_activeNonPlayersIter;
 
+        uint32 m_lastUpdateTime;
+        uint32 m_maxUpdateTime;
+
     private:
         Player* _GetScriptPlayerSourceOrTarget(Object* source, Object* target, const ScriptInfo* scriptInfo) const;
         Creature* _GetScriptCreatureSourceOrTarget(Object* source, Object* target, const ScriptInfo* scriptInfo, bool bReverse = false) const;
@@ -519,11 +571,71 @@ class Map : public GridRefManager<NGridType>
         //visibility calculations. Highly optimized for massive calculations
         void ProcessRelocationNotifies(const uint32 diff);
 
+        // region update mode, see MapUpdate.Regions
+        bool CanUpdateRegions() const;
+        void MarkNearbyCellsOf(WorldObject* obj, std::vector<uint32>& cells);
+        void UpdateRegions(std::vector<uint32> const& cells, const uint32 t_diff);
+        void UpdateCells(std::vector<uint32> const& cells, const uint32 t_diff, bool region = false);
+        void ProcessRegionQueues(const uint32 t_diff);
+
+        void SendObjectUpdates();
+
+        // terrain of the grids players are heading to, loaded by MapManager's grid preloader
+        friend class GridMapPreloadRequest;
+
+        struct PreloadedGridMap
+        {
+            PreloadedGridMap() : request(0), gridMap(NULL), vmapLoading(false), vmapLoaded(false), loaded(false), loadTime(0) {}
+
+            uint32 request;                                 // the request loading it, stale ones are ignored
+            GridMap* gridMap;                               // NULL while it is being loaded, or if it could not be
+            bool vmapLoading;
+            bool vmapLoaded;                                // the vmap tile is loaded, the grid takes it over
+            bool loaded;                                    // the request is done
+            time_t loadTime;
+        };
+        typedef std::map<uint32, PreloadedGridMap> PreloadedGridMapMap;
+
+        bool CanPreloadGridMaps() const;
+        void PreloadGridMapsAhead(Player* player);
+        void PreloadGridMap(uint32 gx, uint32 gy);
+        bool SetPreloadedGridMap(uint32 gx, uint32 gy, uint32 request, GridMap* gmap);
+        void PreloadVMap(uint32 gx, uint32 gy, uint32 request);
+        GridMap* TakePreloadedGridMap(uint32 gx, uint32 gy, bool& vmapLoaded);
+        void UnloadPreloadedGridMaps(bool all);
+
+        PreloadedGridMapMap i_preloadedGridMaps;
+        uint32 i_preloadRequests;
+        ACE_Thread_Mutex i_preloadLock;                     // taken after Lock
+        ACE_Thread_Mutex i_vmapPreloadLock;                 // taken before i_preloadLock
+
         bool i_scriptLock;
         std::set<WorldObject *> i_objectsToRemove;
         std::map<WorldObject*, bool> i_objectsToSwitch;
         std::set<WorldObject*> i_worldObjects;
 
+        std::set<Object*> i_objectsToUpdate;
+        ACE_Thread_Mutex i_objectsToUpdateLock;
+
+        // guards the containers above that regions may modify while they are updated in parallel
+        ACE_Thread_Mutex i_regionLock;
+        bool i_regionUpdate;                                // regions are being updated in parallel
+
+        struct PoolUpdate
+        {
+            bool creature;                                  // else a gameobject pool
+            uint32 poolId;
+            uint32 dbGuid;
+        };
+        std::vector<PoolUpdate> i_poolUpdates;              // queued while i_regionUpdate, guarded by i_regionLock
+        bool QueuePoolUpdate(bool creature, uint32 poolId, uint32 dbGuid);
+
+        // also queued while i_regionUpdate, guarded by i_regionLock
+        std::vector<WorldObject*> i_objectsToAdd;           // entering grids that are not loaded
+        std::vector<CellPair> i_cellsToLoad;                // LoadGrid
+        std::vector<WorldObject*> i_serialObjects;          // updated after the regions, see Trinity::ObjectUpdater
+        template<class T> bool QueueRegionAdd(T* obj);
+
         typedef std::multimap<time_t, ScriptAction> ScriptScheduleMap;
         ScriptScheduleMap m_scriptSchedule;
 
@@ -540,12 +652,15 @@ class Map : public GridRefManager<NGridType>
         template<class T>
         void AddToActiveHelper(T* obj)
         {
+            ACE_GUARD(ACE_Thread_Mutex, Guard, i_regionLock);
             m_activeNonPlayers.insert(obj);
         }
 
         template<class T>
         void RemoveFromActiveHelper(T* obj)
         {
+            ACE_GUARD(ACE_Thread_Mutex, Guard, i_regionLock);
+
             // Map::Update for active object in proccess
             if (m_activeNonPlayersIter != m_activeNonPlayers.end())
             {
@@ -561,6 +676,9 @@ class Map : public GridRefManager<NGridType>
         }
 };
 
+template<> void Map::UpdatePool<Creature>(uint32 poolId, uint32 dbGuid);
+template<> void Map::UpdatePool<GameObject>(uint32 poolId, uint32 dbGuid);
+
 enum InstanceResetMethod
 {
     INSTANCE_RESET_ALL,
@@ -629,7 +747,8 @@ Map::Visit(const Cell& cell, TypeContainerVisitor<T, CONTAINER> &visitor)
     const uint32 cell_x = cell.CellX();
     const uint32 cell_y = cell.CellY();
 
-    if (!cell.NoCreate() || loaded(GridPair(x, y)))
+    // grids not loaded yet are out of reach of the parallel region updates
+    if (loaded(GridPair(x, y)) || (!cell.NoCreate() && !i_regionUpdate))
     {
         EnsureGridLoaded(cell);
         getNGrid(x, y)->Visit(cell_x, cell_y, visitor);
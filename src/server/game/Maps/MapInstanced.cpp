@@ -24,6 +24,7 @@
 #include "InstanceSaveMgr.h"
 #include "World.h"
 #include "Group.h"
+#include "MapUpdater.h"
 
 MapInstanced::MapInstanced(uint32 id, time_t expiry) : Map(id, expiry, 0, DUNGEON_DIFFICULTY_NORMAL)
 {
@@ -49,6 +50,10 @@ void MapInstanced::Update(const uint32 t)
     // take care of loaded GridMaps (when unused, unload it!)
     Map::Update(t);
 
+    // with an active map updater the instances are scheduled by MapManager, see ScheduleInstanceUpdates
+    if (sMapMgr->GetMapUpdater()->activated())
+        return;
+
     // update the instanced maps
     InstancedMaps::iterator i = m_InstancedMaps.begin();
 
@@ -63,11 +68,29 @@ void MapInstanced::Update(const uint32 t)
         }
         else
         {
-            // update only here, because it may schedule some bad things before delete
-            if (sMapMgr->GetMapUpdater()->activated())
-                sMapMgr->GetMapUpdater()->schedule_update(*i->second, t);
-            else
-                i->second->Update(t);
+            i->second->Update(t);
+            ++i;
+        }
+    }
+}
+
+void MapInstanced::ScheduleInstanceUpdates(MapUpdater& updater, const uint32 t)
+{
+    // unload unused instances before any of them is updated, the map updater is idle here
+    InstancedMaps::iterator i = m_InstancedMaps.begin();
+
+    while (i != m_InstancedMaps.end())
+    {
+        if (i->second->CanUnload(t))
+        {
+            if (!DestroyInstance(i))                             // iterator incremented
+            {
+                //m_unloadTimer
+            }
+        }
+        else
+        {
+            updater.schedule_update(*i->second, t);
             ++i;
         }
     }
@@ -81,6 +104,14 @@ void MapInstanced::DelayedUpdate(const uint32 diff)
     Map::DelayedUpdate(diff); // this may be removed
 }
 
+void MapInstanced::SendDelayedObjectUpdates()
+{
+    for (InstancedMaps::iterator i = m_InstancedMaps.begin(); i != m_InstancedMaps.end(); ++i)
+        i->second->SendDelayedObjectUpdates();
+
+    Map::SendDelayedObjectUpdates();
+}
+
 /*
 void MapInstanced::RelocationNotify()
 {
@@ -23,6 +23,8 @@
 #include "InstanceSaveMgr.h"
 #include "DBCEnums.h"
 
+class MapUpdater;
+
 class MapInstanced : public Map
 {
     friend class MapManager;
@@ -34,7 +36,9 @@ class MapInstanced : public Map
 
         // functions overwrite Map versions
         void Update(const uint32);
+        void ScheduleInstanceUpdates(MapUpdater& updater, const uint32 t);
         void DelayedUpdate(const uint32 diff);
+        void SendDelayedObjectUpdates();
         //void RelocationNotify();
         void UnloadAll();
         bool CanEnter(Player* player);
@@ -62,6 +62,10 @@ void MapManager::Initialize()
     // Start mtmaps if needed.
     if (num_threads > 0 && m_updater.activate(num_threads) == -1)
         abort();
+
+    int preload_threads(sWorld->getIntConfig(CONFIG_GRID_PRELOAD_THREADS));
+    if (preload_threads > 0 && m_gridPreloader.activate(preload_threads) == -1)
+        abort();
 }
 
 void MapManager::InitializeVisibilityDistanceInfo()
@@ -267,7 +271,12 @@ void MapManager::Update(uint32 diff)
     for (; iter != i_maps.end(); ++iter)
     {
         if (m_updater.activated())
+        {
+            // instances are scheduled next to their parent map instead of after its update
             m_updater.schedule_update(*iter->second, uint32(i_timer.GetCurrent()));
+            if (MapInstanced* instanced = iter->second->ToMapInstanced())
+                instanced->ScheduleInstanceUpdates(m_updater, uint32(i_timer.GetCurrent()));
+        }
         else
             iter->second->Update(uint32(i_timer.GetCurrent()));
     }
@@ -277,10 +286,12 @@ void MapManager::Update(uint32 diff)
     for (iter = i_maps.begin(); iter != i_maps.end(); ++iter)
         iter->second->DelayedUpdate(uint32(i_timer.GetCurrent()));
 
-    sObjectAccessor->Update(uint32(i_timer.GetCurrent()));
     for (TransportSet::iterator iter = m_Transports.begin(); iter != m_Transports.end(); ++iter)
         (*iter)->Update(uint32(i_timer.GetCurrent()));
 
+    for (iter = i_maps.begin(); iter != i_maps.end(); ++iter)
+        iter->second->SendDelayedObjectUpdates();
+
     i_timer.SetCurrent(0);
 }
 
@@ -318,6 +329,10 @@ void MapManager::UnloadAll()
         delete *i;
     }
 
+    // preload requests reference the maps
+    if (m_gridPreloader.activated())
+        m_gridPreloader.deactivate();
+
     for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end();)
     {
         iter->second->UnloadAll();
@@ -366,6 +381,32 @@ uint32 MapManager::GetNumPlayersInInstances()
     return ret;
 }
 
+struct MapUpdateTimeOrder
+{
+    bool operator()(Map const* left, Map const* right) const
+    {
+        return left->GetLastUpdateTime() > right->GetLastUpdateTime();
+    }
+};
+
+void MapManager::GetMapsByUpdateTime(std::vector<Map*>& maps)
+{
+    ACE_GUARD(ACE_Thread_Mutex, Guard, Lock);
+
+    for (MapMapType::iterator itr = i_maps.begin(); itr != i_maps.end(); ++itr)
+    {
+        Map *map = itr->second;
+        maps.push_back(map);
+        if (!map->Instanceable())
+            continue;
+        MapInstanced::InstancedMaps &instances = ((MapInstanced *)map)->GetInstancedMaps();
+        for (MapInstanced::InstancedMaps::iterator mitr = instances.begin(); mitr != instances.end(); ++mitr)
+            maps.push_back(mitr->second);
+    }
+
+    std::sort(maps.begin(), maps.end(), MapUpdateTimeOrder());
+}
+
 void MapManager::InitInstanceIds()
 {
     _nextInstanceId = 1;
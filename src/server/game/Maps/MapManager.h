@@ -26,6 +26,7 @@
 #include "Map.h"
 #include "GridStates.h"
 #include "MapUpdater.h"
+#include "DelayExecutor.h"
 
 class Transport;
 struct TransportCreatureProto;
@@ -136,6 +137,7 @@ class MapManager
         /* statistics */
         uint32 GetNumInstances();
         uint32 GetNumPlayersInInstances();
+        void GetMapsByUpdateTime(std::vector<Map*>& maps);
 
         // Instance ID management
         void InitInstanceIds();
@@ -147,6 +149,7 @@ class MapManager
         void SetNextInstanceId(uint32 nextInstanceId) { _nextInstanceId = nextInstanceId; };
 
         MapUpdater * GetMapUpdater() { return &m_updater; }
+        DelayExecutor * GetGridPreloader() { return &m_gridPreloader; }
 
     private:
         typedef UNORDERED_MAP<uint32, Map*> MapMapType;
@@ -178,6 +181,7 @@ class MapManager
         InstanceIds _instanceIds;
         uint32 _nextInstanceId;
         MapUpdater m_updater;
+        DelayExecutor m_gridPreloader;                      // loads grid terrain ahead of moving players
 };
 #define sMapMgr ACE_Singleton<MapManager, ACE_Thread_Mutex>::instance()
 #endif
@@ -1,64 +1,48 @@
 #include "MapUpdater.h"
-#include "DelayExecutor.h"
 #include "Map.h"
-#include "DatabaseEnv.h"
+#include "Timer.h"
 
 #include <ace/Guard_T.h>
-#include <ace/Method_Request.h>
 
-class WDBThreadStartReq1 : public ACE_Method_Request
-{
-    public:
-
-        WDBThreadStartReq1()
-        {
-        }
-
-        virtual int call()
-        {
-            return 0;
-        }
-};
-
-class WDBThreadEndReq1 : public ACE_Method_Request
-{
-    public:
-
-        WDBThreadEndReq1()
-        {
-        }
+#include <algorithm>
 
-        virtual int call()
-        {
-            return 0;
-        }
-};
-
-class MapUpdateRequest : public ACE_Method_Request
+class MapUpdateRequest : public MapUpdaterTask
 {
     private:
 
         Map& m_map;
-        MapUpdater& m_updater;
         ACE_UINT32 m_diff;
+        ACE_UINT32 m_weight;
 
     public:
 
-        MapUpdateRequest(Map& m, MapUpdater& u, ACE_UINT32 d)
-            : m_map(m), m_updater(u), m_diff(d)
+        MapUpdateRequest(Map& m, ACE_UINT32 d)
+            : m_map(m), m_diff(d), m_weight(m.GetLastUpdateTime() + 1)
         {
         }
 
-        virtual int call()
+        // expected cost of the request, never 0 so that empty maps are still spread over the workers
+        ACE_UINT32 GetWeight() const { return m_weight; }
+
+        void call()
         {
-            m_map.Update (m_diff);
-            m_updater.update_finished ();
-            return 0;
+            uint32 startTime = getMSTime();
+            m_map.Update(m_diff);
+            m_map.SetLastUpdateTime(GetMSTimeDiffToNow(startTime));
         }
 };
 
+struct MapUpdaterTaskWeightOrder
+{
+    bool operator()(MapUpdaterTask const* left, MapUpdaterTask const* right) const
+    {
+        return left->GetWeight() > right->GetWeight();
+    }
+};
+
 MapUpdater::MapUpdater():
-m_executor(), m_mutex(), m_condition(m_mutex), pending_requests(0)
+m_mutex(), m_condition(m_mutex), m_workCondition(m_mutex), pending_requests(0),
+m_workerCount(0), m_startedWorkers(0), m_activated(false)
 {
 }
 
@@ -69,20 +53,46 @@ MapUpdater::~MapUpdater()
 
 int MapUpdater::activate(size_t num_threads)
 {
-    return m_executor.activate((int)num_threads, new WDBThreadStartReq1, new WDBThreadEndReq1);
+    if (m_activated || num_threads < 1)
+        return -1;
+
+    m_queues.assign(num_threads, RequestQueue());
+    m_queueCost.assign(num_threads, 0);
+    m_workerCount = num_threads;
+    m_startedWorkers = 0;
+    m_activated = true;
+
+    if (ACE_Task_Base::activate(THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED, int(num_threads)) == -1)
+    {
+        m_activated = false;
+        return -1;
+    }
+
+    return 0;
 }
 
 int MapUpdater::deactivate()
 {
+    if (!m_activated)
+        return -1;
+
     wait();
 
-    return m_executor.deactivate();
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+        m_activated = false;
+        m_workCondition.broadcast();
+    }
+
+    return ACE_Task_Base::wait();
 }
 
 int MapUpdater::wait()
 {
     ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
 
+    dispatch();
+
     while (pending_requests > 0)
         m_condition.wait();
 
@@ -93,14 +103,61 @@ int MapUpdater::schedule_update(Map& map, ACE_UINT32 diff)
 {
     ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
 
+    if (!m_activated)
+    {
+        ACE_DEBUG((LM_ERROR, ACE_TEXT("(%t) \n"), ACE_TEXT("Failed to schedule Map Update")));
+        return -1;
+    }
+
     ++pending_requests;
+    m_scheduled.push_back(new MapUpdateRequest(map, diff));
+
+    return 0;
+}
+
+int MapUpdater::run_tasks(std::vector<MapUpdaterTask*>& tasks)
+{
+    size_t remaining = tasks.size();
 
-    if (m_executor.execute(new MapUpdateRequest(map, *this, diff)) == -1)
+    std::stable_sort(tasks.begin(), tasks.end(), MapUpdaterTaskWeightOrder());
+
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+
+    for (std::vector<MapUpdaterTask*>::const_iterator itr = tasks.begin(); itr != tasks.end(); ++itr)
     {
-        ACE_DEBUG((LM_ERROR, ACE_TEXT("(%t) \n"), ACE_TEXT("Failed to schedule Map Update")));
+        (*itr)->m_batch = &remaining;
+        m_batchTasks.push_back(*itr);
+    }
+    tasks.clear();
 
-        --pending_requests;
-        return -1;
+    m_workCondition.broadcast();
+
+    while (remaining > 0)
+    {
+        // run what the workers did not take yet instead of waiting for them
+        MapUpdaterTask* task = NULL;
+        for (RequestQueue::iterator itr = m_batchTasks.begin(); itr != m_batchTasks.end(); ++itr)
+        {
+            if ((*itr)->m_batch == &remaining)
+            {
+                task = *itr;
+                m_batchTasks.erase(itr);
+                break;
+            }
+        }
+
+        if (!task)
+        {
+            m_condition.wait();
+            continue;
+        }
+
+        guard.release();
+        task->call();
+        delete task;
+        guard.acquire();
+
+        --remaining;
     }
 
     return 0;
@@ -108,20 +165,117 @@ int MapUpdater::schedule_update(Map& map, ACE_UINT32 diff)
 
 bool MapUpdater::activated()
 {
-    return m_executor.activated();
+    return m_activated;
 }
 
-void MapUpdater::update_finished()
+int MapUpdater::svc()
 {
-    ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+    size_t worker;
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+        worker = m_startedWorkers++;
+    }
 
-    if (pending_requests == 0)
+    for (;;)
     {
-        ACE_ERROR((LM_ERROR, ACE_TEXT("(%t)\n"), ACE_TEXT("MapUpdater::update_finished BUG, report to devs")));
+        MapUpdaterTask* request = NULL;
+        {
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+
+            while (m_activated && !(request = next_request(worker)))
+                m_workCondition.wait();
+        }
+
+        if (!request)
+            break;
+
+        request->call();
+        task_finished(request);
+        delete request;
+    }
+
+    return 0;
+}
+
+// must be called with m_mutex held
+void MapUpdater::dispatch()
+{
+    if (m_scheduled.empty())
         return;
+
+    // longest processing time first: every map goes to the least loaded worker
+    std::stable_sort(m_scheduled.begin(), m_scheduled.end(), MapUpdaterTaskWeightOrder());
+
+    for (std::vector<MapUpdaterTask*>::const_iterator itr = m_scheduled.begin(); itr != m_scheduled.end(); ++itr)
+    {
+        size_t target = std::min_element(m_queueCost.begin(), m_queueCost.end()) - m_queueCost.begin();
+        m_queues[target].push_back(*itr);
+        m_queueCost[target] += (*itr)->GetWeight();
     }
 
-    --pending_requests;
+    m_scheduled.clear();
+    m_workCondition.broadcast();
+}
+
+// must be called with m_mutex held
+MapUpdaterTask* MapUpdater::next_request(size_t worker)
+{
+    // tasks of a map that is in the middle of its update come first
+    if (!m_batchTasks.empty())
+    {
+        MapUpdaterTask* task = m_batchTasks.front();
+        m_batchTasks.pop_front();
+        return task;
+    }
+
+    size_t source = worker;
+
+    if (m_queues[worker].empty())
+    {
+        // nothing left of our own, steal from the worker with the most work left
+        ACE_UINT32 maxCost = 0;
+        for (size_t i = 0; i < m_workerCount; ++i)
+        {
+            if (i != worker && !m_queues[i].empty() && m_queueCost[i] > maxCost)
+            {
+                maxCost = m_queueCost[i];
+                source = i;
+            }
+        }
+
+        if (source == worker)
+            return NULL;
+    }
+
+    MapUpdaterTask* request;
+    if (source == worker)
+    {
+        request = m_queues[source].front();
+        m_queues[source].pop_front();
+    }
+    else
+    {
+        request = m_queues[source].back();
+        m_queues[source].pop_back();
+    }
+
+    m_queueCost[source] -= request->GetWeight();
+    return request;
+}
+
+void MapUpdater::task_finished(MapUpdaterTask* task)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+
+    if (task->m_batch)
+        --*task->m_batch;
+    else if (pending_requests == 0)
+    {
+        ACE_ERROR((LM_ERROR, ACE_TEXT("(%t)\n"), ACE_TEXT("MapUpdater::task_finished BUG, report to devs")));
+        return;
+    }
+    else
+        --pending_requests;
 
     m_condition.broadcast();
 }
@@ -1,24 +1,61 @@
 #ifndef _MAP_UPDATER_H_INCLUDED
 #define _MAP_UPDATER_H_INCLUDED
 
+#include <ace/Task.h>
 #include <ace/Thread_Mutex.h>
 #include <ace/Condition_Thread_Mutex.h>
 
-#include "DelayExecutor.h"
+#include <deque>
+#include <vector>
 
 class Map;
 
-class MapUpdater
+// a unit of work run by the map updater threads
+class MapUpdaterTask
+{
+    public:
+
+        MapUpdaterTask() : m_batch(NULL) {}
+        virtual ~MapUpdaterTask() {}
+
+        virtual void call() = 0;
+
+        // expected cost of the task, expensive tasks are started first
+        virtual ACE_UINT32 GetWeight() const = 0;
+
+    private:
+
+        friend class MapUpdater;
+
+        size_t* m_batch;                                    // tasks left in the run_tasks() call that queued it
+};
+
+/*
+ * Updates the maps scheduled for a tick on a pool of worker threads.
+ *
+ * Requests are collected by schedule_update() and dispatched by wait():
+ * the maps are ordered by the measured duration of their last update and
+ * distributed over the per-worker queues, most expensive first, to the
+ * worker with the lowest expected load. A worker runs its own queue from
+ * the front and, once it is empty, steals the cheapest request from the
+ * back of the most loaded queue of another worker.
+ *
+ * While updating, a map can split its own work with run_tasks(): idle
+ * workers pick up these tasks before anything else, and the calling
+ * thread runs the ones nobody took.
+ */
+class MapUpdater : protected ACE_Task_Base
 {
     public:
 
         MapUpdater();
         virtual ~MapUpdater();
 
-        friend class MapUpdateRequest;
-
         int schedule_update(Map& map, ACE_UINT32 diff);
 
+        // runs the tasks on the calling thread and idle workers, returns once all are done; takes ownership
+        int run_tasks(std::vector<MapUpdaterTask*>& tasks);
+
         int wait();
 
         int activate(size_t num_threads);
@@ -27,14 +64,28 @@ class MapUpdater
 
         bool activated();
 
+        virtual int svc();
+
     private:
 
-        DelayExecutor m_executor;
+        typedef std::deque<MapUpdaterTask*> RequestQueue;
+
         ACE_Thread_Mutex m_mutex;
-        ACE_Condition_Thread_Mutex m_condition;
+        ACE_Condition_Thread_Mutex m_condition;             // signaled when a request is finished
+        ACE_Condition_Thread_Mutex m_workCondition;         // signaled when requests are dispatched
         size_t pending_requests;
 
-        void update_finished();
+        std::vector<MapUpdaterTask*> m_scheduled;           // collected, not yet dispatched
+        std::vector<RequestQueue> m_queues;                 // one per worker thread
+        RequestQueue m_batchTasks;                          // queued by run_tasks()
+        std::vector<ACE_UINT32> m_queueCost;                // estimated cost left in each queue
+        size_t m_workerCount;
+        size_t m_startedWorkers;
+        bool m_activated;
+
+        void dispatch();
+        MapUpdaterTask* next_request(size_t worker);
+        void task_finished(MapUpdaterTask* task);
 };
 
 #endif //_MAP_UPDATER_H_INCLUDED
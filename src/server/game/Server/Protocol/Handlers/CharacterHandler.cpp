@@ -201,6 +201,40 @@ bool LoginQueryHolder::Initialize()
     stmt->setUInt32(0, lowGuid);
     res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOADXPRATE, stmt);
 
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_LOAD_PLAYER_ITEM_REFUNDS);
+    stmt->setUInt32(0, lowGuid);
+    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOADITEMREFUNDS, stmt);
+
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_LOAD_PLAYER_ITEM_BOP_TRADE);
+    stmt->setUInt32(0, lowGuid);
+    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOADITEMBOPTRADE, stmt);
+
+    // current pet (slot 0), see Pet::LoadPetFromDB
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_LOAD_PLAYER_PET);
+    stmt->setUInt32(0, lowGuid);
+    stmt->setUInt8(1, uint8(PET_SAVE_AS_CURRENT));
+    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOADPET, stmt);
+
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_LOAD_PLAYER_PET_AURAS);
+    stmt->setUInt32(0, lowGuid);
+    stmt->setUInt8(1, uint8(PET_SAVE_AS_CURRENT));
+    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOADPETAURAS, stmt);
+
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_LOAD_PLAYER_PET_SPELLS);
+    stmt->setUInt32(0, lowGuid);
+    stmt->setUInt8(1, uint8(PET_SAVE_AS_CURRENT));
+    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOADPETSPELLS, stmt);
+
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_LOAD_PLAYER_PET_SPELL_COOLDOWNS);
+    stmt->setUInt32(0, lowGuid);
+    stmt->setUInt8(1, uint8(PET_SAVE_AS_CURRENT));
+    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOADPETSPELLCOOLDOWNS, stmt);
+
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_LOAD_PLAYER_PET_DECLINEDNAMES);
+    stmt->setUInt32(0, lowGuid);
+    stmt->setUInt8(1, uint8(PET_SAVE_AS_CURRENT));
+    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOADPETDECLINEDNAMES, stmt);
+
     return res;
 }
 
@@ -987,12 +1021,13 @@ void WorldSession::HandlePlayerLogin(LoginQueryHolder * holder)
 
     pCurrChar->ContinueTaxiFlight();
 
-    // reset for all pets before pet loading
-    if (pCurrChar->HasAtLoginFlag(AT_LOGIN_RESET_PET_TALENTS))
-        Pet::resetTalentsForAllPetsOf(pCurrChar);
-
     // Load pet if any (if player not alive and in taxi flight or another then pet will remember as temporary unsummoned)
-    pCurrChar->LoadPet();
+    pCurrChar->LoadPet(holder);
+
+    // reset for all pets after pet loading: the spells of the current pet in the holder were read
+    // before any reset, so it is reset as the online pet and saved without its talents
+    if (pCurrChar->HasAtLoginFlag(AT_LOGIN_RESET_PET_TALENTS))
+        Pet::resetTalentsForAllPetsOf(pCurrChar, pCurrChar->GetPet());
 
     // Set FFA PvP for non GM in non-rest mode
     if (sWorld->IsFFAPvPRealm() && !pCurrChar->isGameMaster() && !pCurrChar->HasFlag(PLAYER_FLAGS, PLAYER_FLAGS_RESTING))
@@ -1209,6 +1244,7 @@ void WorldSession::HandleChangePlayerNameOpcodeCallBack(QueryResult result, std:
     std::string oldname = result->Fetch()[1].GetString();
 
     CharacterDatabase.PExecute("UPDATE characters set name = '%s', at_login = at_login & ~ %u WHERE guid ='%u'", newname.c_str(), uint32(AT_LOGIN_RENAME), guidLow);
+    sObjectMgr->UpdateCharacterNameCache(guidLow, newname);
     CharacterDatabase.PExecute("DELETE FROM character_declinedname WHERE guid ='%u'", guidLow);
 
     sLogMgr->WriteLn(CHAR_LOG, "Account: %d (IP: %s) Character:[%s] (guid:%u) Changed name to: %s",
@@ -1465,6 +1501,7 @@ void WorldSession::HandleCharCustomize(WorldPacket& recv_data)
     }
     Player::Customize(guid, gender, skin, face, hairStyle, hairColor, facialHair);
     CharacterDatabase.PExecute("UPDATE characters set name = '%s', at_login = at_login & ~ %u WHERE guid ='%u'", newname.c_str(), uint32(AT_LOGIN_CUSTOMIZE), GUID_LOPART(guid));
+    sObjectMgr->UpdateCharacterNameCache(GUID_LOPART(guid), newname);
     CharacterDatabase.PExecute("DELETE FROM character_declinedname WHERE guid ='%u'", GUID_LOPART(guid));
 
     WorldPacket data(SMSG_CHAR_CUSTOMIZE, 1+8+(newname.size()+1)+6);
@@ -1683,6 +1720,7 @@ void WorldSession::HandleCharFactionOrRaceChange(WorldPacket& recv_data)
     Player::Customize(guid, gender, skin, face, hairStyle, hairColor, facialHair);
     SQLTransaction trans = CharacterDatabase.BeginTransaction();
     trans->PAppend("UPDATE `characters` SET name='%s', race='%u', at_login=at_login & ~ %u WHERE guid='%u'", newname.c_str(), race, used_loginFlag, lowGuid);
+    sObjectMgr->UpdateCharacterNameCache(lowGuid, newname);
     trans->PAppend("DELETE FROM character_declinedname WHERE guid ='%u'", lowGuid);
 
     BattlegroundTeamId team = BG_TEAM_ALLIANCE;
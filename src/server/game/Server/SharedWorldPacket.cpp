@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ace/Message_Block.h>
+#include <ace/Lock_Adapter_T.h>
+#include <ace/Thread_Mutex.h>
+
+#include "SharedWorldPacket.h"
+#include "WorldPacket.h"
+
+// the references to a payload are released by the network threads
+static ACE_Lock_Adapter<ACE_Thread_Mutex> s_payloadRefLock;
+
+SharedWorldPacket::SharedWorldPacket(WorldPacket const& packet) : m_packet(packet), m_payload(NULL)
+{
+}
+
+SharedWorldPacket::SharedWorldPacket(SharedWorldPacket const& right) : m_packet(right.m_packet),
+m_payload(right.m_payload ? right.m_payload->duplicate() : NULL)
+{
+}
+
+SharedWorldPacket::~SharedWorldPacket()
+{
+    if (m_payload)
+        m_payload->release();
+}
+
+ACE_Message_Block* SharedWorldPacket::DuplicatePayload() const
+{
+    if (m_packet.empty())
+        return NULL;
+
+    if (!m_payload)
+    {
+        ACE_NEW_RETURN(m_payload, ACE_Message_Block(m_packet.size(), ACE_Message_Block::MB_DATA, NULL, NULL, NULL, &s_payloadRefLock), NULL);
+        m_payload->copy((const char*)m_packet.contents(), m_packet.size());
+    }
+
+    return m_payload->duplicate();
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup u2w User to World Communication
+ *  @{
+ *  \file SharedWorldPacket.h
+ */
+
+#ifndef _SHAREDWORLDPACKET_H
+#define _SHAREDWORLDPACKET_H
+
+#include "Common.h"
+
+class ACE_Message_Block;
+class WorldPacket;
+
+/**
+ * A packet broadcast to many sessions.
+ *
+ * The payload is serialized once, into a reference counted
+ * ACE_Message_Block, the first time a socket needs to queue it.
+ * Every socket then queues its own reference to that block, and only
+ * its per-connection encrypted header is built separately.
+ *
+ * The wrapped WorldPacket must stay unchanged and alive for as long as
+ * this object exists, which is the case for the usual broadcast done
+ * within a single call. The queued references outlive both.
+ */
+class SharedWorldPacket
+{
+    public:
+        explicit SharedWorldPacket(WorldPacket const& packet);
+        SharedWorldPacket(SharedWorldPacket const& right);
+        ~SharedWorldPacket();
+
+        WorldPacket const& GetPacket() const { return m_packet; }
+
+        /// New reference to the serialized payload, NULL for empty packets.
+        /// The caller must release() it.
+        ACE_Message_Block* DuplicatePayload() const;
+
+    private:
+        SharedWorldPacket& operator=(SharedWorldPacket const&);
+
+        WorldPacket const& m_packet;
+        mutable ACE_Message_Block* m_payload;
+};
+
+#endif  /* _SHAREDWORLDPACKET_H */
+
+/// @}
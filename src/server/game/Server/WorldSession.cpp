@@ -27,6 +27,7 @@
 #include "LogMgr.h"
 #include "Opcodes.h"
 #include "WorldPacket.h"
+#include "SharedWorldPacket.h"
 #include "WorldSession.h"
 #include "Player.h"
 #include "Vehicle.h"
@@ -153,14 +154,10 @@ uint32 WorldSession::GetGuidLow() const
     return GetPlayer() ? GetPlayer()->GetGUIDLow() : 0;
 }
 
-/// Send a packet to the client
-void WorldSession::SendPacket(WorldPacket const *packet)
-{
-    if (!m_Socket)
-        return;
-
 #ifdef TRINITY_DEBUG
-    // Code for network use statistic
+// Code for network use statistic
+static void CountSentPacket(WorldPacket const* packet)
+{
     static uint64 sendPacketCount = 0;
     static uint64 sendPacketBytes = 0;
 
@@ -191,12 +188,37 @@ void WorldSession::SendPacket(WorldPacket const *packet)
         sendLastPacketCount = 1;
         sendLastPacketBytes = packet->wpos();               // wpos is real written size
     }
+}
+#endif                                                      // !TRINITY_DEBUG
+
+/// Send a packet to the client
+void WorldSession::SendPacket(WorldPacket const *packet)
+{
+    if (!m_Socket)
+        return;
+
+#ifdef TRINITY_DEBUG
+    CountSentPacket(packet);
 #endif                                                      // !TRINITY_DEBUG
 
     if (m_Socket->SendPacket (*packet) == -1)
         m_Socket->CloseSocket ();
 }
 
+/// Send a packet whose payload is shared with the other recipients of a broadcast
+void WorldSession::SendPacket(SharedWorldPacket const& packet)
+{
+    if (!m_Socket)
+        return;
+
+#ifdef TRINITY_DEBUG
+    CountSentPacket(&packet.GetPacket());
+#endif                                                      // !TRINITY_DEBUG
+
+    if (m_Socket->SendPacket (packet) == -1)
+        m_Socket->CloseSocket ();
+}
+
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(WorldPacket *new_packet)
 {
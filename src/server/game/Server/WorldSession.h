@@ -44,6 +44,7 @@ class Unit;
 class GameObject;
 class Quest;
 class WorldPacket;
+class SharedWorldPacket;
 class WorldSocket;
 class LoginQueryHolder;
 class SpellCastTargets;
@@ -232,6 +233,7 @@ class WorldSession
         void WriteMovementInfo(WorldPacket *data, MovementInfo *mi);
 
         void SendPacket(WorldPacket const* packet);
+        void SendPacket(SharedWorldPacket const& packet);
         void SendNotification(const char *format, ...) ATTR_PRINTF(2, 3);
         void SendNotification(uint32 string_id, ...);
         void SendPetNameInvalid(uint32 error, const std::string& name, DeclinedName *declinedName);
@@ -19,6 +19,8 @@
 #include <ace/Message_Block.h>
 #include <ace/OS_NS_string.h>
 #include <ace/OS_NS_unistd.h>
+#include <ace/OS_NS_sys_socket.h>
+#include <ace/os_include/os_limits.h>
 #include <ace/os_include/arpa/os_inet.h>
 #include <ace/os_include/netinet/os_tcp.h>
 #include <ace/os_include/sys/os_types.h>
@@ -33,6 +35,7 @@
 #include "Util.h"
 #include "World.h"
 #include "WorldPacket.h"
+#include "SharedWorldPacket.h"
 #include "SharedDefines.h"
 #include "ByteBuffer.h"
 #include "Opcodes.h"
@@ -45,6 +48,12 @@
 #include "LogMgr.h"
 #include "ScriptMgr.h"
 
+// payloads of broadcast packets from this size on are never copied into the output buffer
+#define SHARED_PAYLOAD_MIN_SIZE 1024
+
+// buffers gathered by handle_output() into one send call
+#define WORLD_SOCKET_OUTPUT_IOV (ACE_IOV_MAX < 64 ? ACE_IOV_MAX : 64)
+
 #if defined(__GNUC__)
 #pragma pack(1)
 #else
@@ -101,7 +110,7 @@ struct ClientPktHeader
 WorldSocket::WorldSocket (void): WorldHandler(),
 m_LastPingTime(ACE_Time_Value::zero), m_OverSpeedPings(0), m_Session(0),
 m_RecvWPct(0), m_RecvPct(), m_Header(sizeof (ClientPktHeader)),
-m_OutBuffer(0), m_OutBufferSize(65536), m_OutActive(false),
+m_OutBuffer(0), m_OutBufferSize(65536), m_OutChunk(NULL), m_OutActive(false),
 m_Seed(static_cast<uint32> (rand32()))
 {
     reference_counting_policy().value (ACE_Event_Handler::Reference_Counting_Policy::ENABLED);
@@ -152,6 +161,16 @@ const std::string& WorldSocket::GetRemoteAddress (void) const
 }
 
 int WorldSocket::SendPacket (const WorldPacket& pct)
+{
+    return _SendPacket(pct, NULL);
+}
+
+int WorldSocket::SendPacket (const SharedWorldPacket& pct)
+{
+    return _SendPacket(pct.GetPacket(), &pct);
+}
+
+int WorldSocket::_SendPacket (const WorldPacket& pct, const SharedWorldPacket* shared)
 {
     ACE_GUARD_RETURN (LockType, Guard, m_OutBufferLock, -1);
 
@@ -161,13 +180,42 @@ int WorldSocket::SendPacket (const WorldPacket& pct)
     // Dump outgoing packet.
     _LogPacket(pct, true);
 
-    // Create a copy of the original packet; this is to avoid issues if a hook modifies it.
-    sScriptMgr->OnPacketSend(this, WorldPacket(pct));
+    sScriptMgr->OnPacketSend(this, pct);
 
     ServerPktHeader header(pct.size()+2, pct.GetOpcode());
     m_Crypt.EncryptSend ((uint8*)header.header, header.getHeaderLength());
 
-    if (m_OutBuffer->space() >= pct.size() + header.getHeaderLength() && msg_queue()->is_empty())
+    bool fitsInBuffer = m_OutBuffer->space() >= pct.size() + header.getHeaderLength() && msg_queue()->is_empty();
+
+    // A shared payload is queued by reference when it is large or would be copied into a block of its own anyway.
+    if (shared && !pct.empty() && (!fitsInBuffer || pct.size() >= SHARED_PAYLOAD_MIN_SIZE))
+    {
+        ACE_Message_Block* payload = shared->DuplicatePayload();
+        if (!payload)
+            return -1;
+
+        if (m_OutBuffer->space() >= header.getHeaderLength() && msg_queue()->is_empty())
+        {
+            if (m_OutBuffer->copy((char*) header.header, header.getHeaderLength()) == -1)
+                ACE_ASSERT (false);
+        }
+        else if (QueueOutput((char*) header.header, header.getHeaderLength()) == -1)
+        {
+            payload->release();
+            return -1;
+        }
+
+        if (msg_queue()->enqueue_tail(payload, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
+        {
+            sLog->outError("WorldSocket::SendPacket enqueue_tail failed");
+            payload->release();
+            return -1;
+        }
+
+        // the payload is not ours to append to
+        m_OutChunk = NULL;
+    }
+    else if (fitsInBuffer)
     {
         // Put the packet on the buffer.
         if (m_OutBuffer->copy((char*) header.header, header.getHeaderLength()) == -1)
@@ -180,21 +228,45 @@ int WorldSocket::SendPacket (const WorldPacket& pct)
     else
     {
         // Enqueue the packet.
-        ACE_Message_Block* mb;
-
-        ACE_NEW_RETURN(mb, ACE_Message_Block(pct.size() + header.getHeaderLength()), -1);
-
-        mb->copy((char*) header.header, header.getHeaderLength());
+        if (QueueOutput((char*) header.header, header.getHeaderLength()) == -1)
+            return -1;
 
         if (!pct.empty())
-            mb->copy((const char*)pct.contents(), pct.size());
+            if (QueueOutput((const char*) pct.contents(), pct.size()) == -1)
+                return -1;
+    }
+
+    return 0;
+}
 
-        if (msg_queue()->enqueue_tail(mb, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
+int WorldSocket::QueueOutput (const char* data, size_t len)
+{
+    while (len > 0)
+    {
+        if (!m_OutChunk || m_OutChunk->space() == 0)
         {
-            sLog->outError("WorldSocket::SendPacket enqueue_tail failed");
-            mb->release();
-            return -1;
+            ACE_Message_Block* chunk = sWorldSocketMgr->AcquireOutputChunk();
+            if (!chunk)
+                return -1;
+
+            if (msg_queue()->enqueue_tail(chunk, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
+            {
+                sLog->outError("WorldSocket::QueueOutput enqueue_tail failed");
+                sWorldSocketMgr->ReleaseOutputBlock(chunk);
+                return -1;
+            }
+
+            m_OutChunk = chunk;
         }
+
+        size_t n = std::min(len, m_OutChunk->space());
+        m_OutChunk->copy(data, n);
+
+        // the queue only counted the chunk as long as it was when enqueued
+        msg_queue()->message_length(msg_queue()->message_length() + n);
+
+        data += n;
+        len -= n;
     }
 
     return 0;
@@ -323,15 +395,40 @@ int WorldSocket::handle_output (ACE_HANDLE)
     if (closing_)
         return -1;
 
-    size_t send_len = m_OutBuffer->length();
+    // Gather the output buffer and the queued blocks, in order, into one send call.
+    iovec iov[WORLD_SOCKET_OUTPUT_IOV];
+    int iovcnt = 0;
+
+    if (m_OutBuffer->length() > 0)
+    {
+        iov[iovcnt].iov_base = m_OutBuffer->rd_ptr();
+        iov[iovcnt].iov_len = m_OutBuffer->length();
+        ++iovcnt;
+    }
+
+    ACE_Message_Block* mblk = NULL;
+    if (!msg_queue()->is_empty())
+        msg_queue()->peek_dequeue_head(mblk, (ACE_Time_Value*)&ACE_Time_Value::zero);
+
+    for (; mblk && iovcnt < WORLD_SOCKET_OUTPUT_IOV; mblk = mblk->next())
+    {
+        iov[iovcnt].iov_base = mblk->rd_ptr();
+        iov[iovcnt].iov_len = mblk->length();
+        ++iovcnt;
+    }
 
-    if (send_len == 0)
-        return handle_output_queue(Guard);
+    if (iovcnt == 0)
+        return cancel_wakeup_output(Guard);
 
 #ifdef MSG_NOSIGNAL
-    ssize_t n = peer().send (m_OutBuffer->rd_ptr(), send_len, MSG_NOSIGNAL);
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iovcnt;
+
+    ssize_t n = ACE_OS::sendmsg (get_handle(), &msg, MSG_NOSIGNAL);
 #else
-    ssize_t n = peer().send (m_OutBuffer->rd_ptr(), send_len);
+    ssize_t n = peer().sendv (iov, iovcnt);
 #endif // MSG_NOSIGNAL
 
     if (n == 0)
@@ -343,84 +440,60 @@ int WorldSocket::handle_output (ACE_HANDLE)
 
         return -1;
     }
-    else if (n < (ssize_t)send_len) //now n > 0
-    {
-        m_OutBuffer->rd_ptr (static_cast<size_t> (n));
 
-        // move the data to the base of the buffer
-        m_OutBuffer->crunch();
+    sWorldSocketMgr->CountSend(size_t(n));
 
-        return schedule_wakeup_output (Guard);
-    }
-    else //now n == send_len
-    {
-        m_OutBuffer->reset();
-
-        return handle_output_queue (Guard);
-    }
+    size_t sent = static_cast<size_t> (n);
 
-    ACE_NOTREACHED (return 0);
-}
-
-int WorldSocket::handle_output_queue (GuardType& g)
-{
-    if (msg_queue()->is_empty())
-        return cancel_wakeup_output(g);
-
-    ACE_Message_Block *mblk;
-
-    if (msg_queue()->dequeue_head(mblk, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
+    if (m_OutBuffer->length() > 0)
     {
-        sLog->outError("WorldSocket::handle_output_queue dequeue_head");
-        return -1;
-    }
-
-    const size_t send_len = mblk->length();
+        if (sent < m_OutBuffer->length())
+        {
+            m_OutBuffer->rd_ptr (sent);
 
-#ifdef MSG_NOSIGNAL
-    ssize_t n = peer().send (mblk->rd_ptr(), send_len, MSG_NOSIGNAL);
-#else
-    ssize_t n = peer().send (mblk->rd_ptr(), send_len);
-#endif // MSG_NOSIGNAL
+            // move the data to the base of the buffer
+            m_OutBuffer->crunch();
 
-    if (n == 0)
-    {
-        mblk->release();
+            return schedule_wakeup_output (Guard);
+        }
 
-        return -1;
+        sent -= m_OutBuffer->length();
+        m_OutBuffer->reset();
     }
-    else if (n == -1)
+
+    while (sent > 0)
     {
-        if (errno == EWOULDBLOCK || errno == EAGAIN)
+        if (msg_queue()->dequeue_head(mblk, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
         {
-            msg_queue()->enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero);
-            return schedule_wakeup_output (g);
+            sLog->outError("WorldSocket::handle_output dequeue_head");
+            return -1;
         }
 
-        mblk->release();
-        return -1;
-    }
-    else if (n < (ssize_t)send_len) //now n > 0
-    {
-        mblk->rd_ptr(static_cast<size_t> (n));
-
-        if (msg_queue()->enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero) == -1)
+        if (sent < mblk->length())
         {
-            sLog->outError("WorldSocket::handle_output_queue enqueue_head");
-            mblk->release();
-            return -1;
+            mblk->rd_ptr (sent);
+
+            if (msg_queue()->enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero) == -1)
+            {
+                sLog->outError("WorldSocket::handle_output enqueue_head");
+                if (mblk == m_OutChunk)
+                    m_OutChunk = NULL;
+                mblk->release();
+                return -1;
+            }
+
+            return schedule_wakeup_output (Guard);
         }
 
-        return schedule_wakeup_output (g);
-    }
-    else //now n == send_len
-    {
-        mblk->release();
+        sent -= mblk->length();
+
+        if (mblk == m_OutChunk)
+            m_OutChunk = NULL;
 
-        return msg_queue()->is_empty() ? cancel_wakeup_output(g) : ACE_Event_Handler::WRITE_MASK;
+        sWorldSocketMgr->ReleaseOutputBlock(mblk);
     }
 
-    ACE_NOTREACHED(return -1);
+    return msg_queue()->is_empty() ? cancel_wakeup_output(Guard) : ACE_Event_Handler::WRITE_MASK;
 }
 
 int WorldSocket::handle_close (ACE_HANDLE h, ACE_Reactor_Mask)
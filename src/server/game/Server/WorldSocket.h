@@ -43,8 +43,15 @@
 
 class ACE_Message_Block;
 class WorldPacket;
+class SharedWorldPacket;
 class WorldSession;
 
+/// Message type of the fixed size blocks of the output queue, recycled by WorldSocketMgr.
+#define WORLD_SOCKET_OUTPUT_CHUNK ACE_Message_Block::MB_USER
+#define WORLD_SOCKET_OUTPUT_CHUNK_SIZE 16384
+/// Free chunks kept by WorldSocketMgr for all sockets.
+#define WORLD_SOCKET_OUTPUT_CHUNK_POOL 1024
+
 /// Handler that can communicate over stream sockets.
 typedef ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH> WorldHandler;
 
@@ -57,8 +64,9 @@ typedef ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH> WorldHandler;
  * The class uses reference counting.
  *
  * For output the class uses one buffer (64K usually) and
- * a queue where it stores packet if there is no place on
- * the queue. The reason this is done, is because the server
+ * a queue of pooled fixed size chunks where it stores packets
+ * if there is no place in the buffer. handle_output() sends
+ * the buffer and the queued blocks with one vectored write. The reason this is done, is because the server
  * does really a lot of small-size writes to it, and it doesn't
  * scale well to allocate memory for every. When something is
  * written to the output buffer the socket is not immediately
@@ -68,6 +76,8 @@ typedef ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH> WorldHandler;
  * uses 200ms celling. As result overhead generated by
  * sending packets from "producer" threads is minimal,
  * and doing a lot of writes with small size is tolerated.
+ * Large broadcast packets (SharedWorldPacket) are not copied:
+ * the queue holds a reference to their shared payload instead.
  *
  * The calls to Update() method are managed by WorldSocketMgr
  * and ReactorRunnable.
@@ -110,6 +120,11 @@ class WorldSocket : public WorldHandler
         /// @return -1 of failure
         int SendPacket (const WorldPacket& pct);
 
+        /// Send a broadcast packet, queuing a reference to its shared payload where that avoids a copy.
+        /// @param pct packet to send
+        /// @return -1 of failure
+        int SendPacket (const SharedWorldPacket& pct);
+
         /// Add reference to this object.
         long AddReference (void);
 
@@ -148,8 +163,9 @@ class WorldSocket : public WorldHandler
         int cancel_wakeup_output (GuardType& g);
         int schedule_wakeup_output (GuardType& g);
 
-        /// Drain the queue if its not empty.
-        int handle_output_queue (GuardType& g);
+        /// Append to the last chunk of the output queue, queuing new chunks as needed.
+        /// Must be called with m_OutBufferLock held.
+        int QueueOutput (const char* data, size_t len);
 
         /// process one incoming packet.
         /// @param new_pct received packet , note that you need to delete it.
@@ -161,6 +177,9 @@ class WorldSocket : public WorldHandler
         /// Called by ProcessIncoming() on CMSG_PING.
         int HandlePing (WorldPacket& recvPacket);
 
+        /// @param shared set when the payload of pct may be queued by reference
+        int _SendPacket (const WorldPacket& pct, const SharedWorldPacket* shared);
+
         void _LogPacket(const WorldPacket& pct, bool isServer) const;
     private:
         /// Time in which the last ping was received
@@ -201,6 +220,9 @@ class WorldSocket : public WorldHandler
         /// Size of the m_OutBuffer.
         size_t m_OutBufferSize;
 
+        /// Chunk at the tail of the output queue that is still filled, if any.
+        ACE_Message_Block *m_OutChunk;
+
         /// True if the socket is registered with the reactor for output
         bool m_OutActive;
 
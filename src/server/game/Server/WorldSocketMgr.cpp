@@ -31,6 +31,7 @@
 #include <ace/Dev_Poll_Reactor.h>
 #include <ace/Guard_T.h>
 #include <ace/Atomic_Op.h>
+#include <ace/Message_Block.h>
 #include <ace/os_include/arpa/os_inet.h>
 #include <ace/os_include/netinet/os_tcp.h>
 #include <ace/os_include/sys/os_types.h>
@@ -217,7 +218,9 @@ WorldSocketMgr::WorldSocketMgr() :
     m_SockOutKBuff(-1),
     m_SockOutUBuff(65536),
     m_UseNoDelay(true),
-    m_Acceptor (0)
+    m_Acceptor (0),
+    m_SendCalls(0),
+    m_SentBytes(0)
 {
 }
 
@@ -225,6 +228,9 @@ WorldSocketMgr::~WorldSocketMgr()
 {
     delete [] m_NetThreads;
     delete m_Acceptor;
+
+    for (std::vector<ACE_Message_Block*>::const_iterator itr = m_OutputChunks.begin(); itr != m_OutputChunks.end(); ++itr)
+        (*itr)->release();
 }
 
 int
@@ -360,3 +366,56 @@ WorldSocketMgr::OnSocketOpen (WorldSocket* sock)
 
     return m_NetThreads[min].AddSocket (sock);
 }
+
+
+ACE_Message_Block*
+WorldSocketMgr::AcquireOutputChunk ()
+{
+    {
+        ACE_GUARD_RETURN (ACE_Thread_Mutex, Guard, m_OutputChunksLock, NULL);
+
+        if (!m_OutputChunks.empty())
+        {
+            ACE_Message_Block* mb = m_OutputChunks.back();
+            m_OutputChunks.pop_back();
+            return mb;
+        }
+    }
+
+    ACE_Message_Block* mb;
+    ACE_NEW_RETURN (mb, ACE_Message_Block (WORLD_SOCKET_OUTPUT_CHUNK_SIZE, WORLD_SOCKET_OUTPUT_CHUNK), NULL);
+    return mb;
+}
+
+void
+WorldSocketMgr::ReleaseOutputBlock (ACE_Message_Block* mb)
+{
+    if (mb->msg_type() == WORLD_SOCKET_OUTPUT_CHUNK)
+    {
+        mb->reset();
+
+        ACE_GUARD (ACE_Thread_Mutex, Guard, m_OutputChunksLock);
+
+        if (m_OutputChunks.size() < WORLD_SOCKET_OUTPUT_CHUNK_POOL)
+        {
+            m_OutputChunks.push_back(mb);
+            return;
+        }
+    }
+
+    mb->release();
+}
+
+void
+WorldSocketMgr::CountSend (size_t bytes)
+{
+    ++m_SendCalls;
+    m_SentBytes += uint64(bytes);
+}
+
+void
+WorldSocketMgr::GetOutputStatistics (uint64& sendCalls, uint64& sentBytes) const
+{
+    sendCalls = m_SendCalls.value();
+    sentBytes = m_SentBytes.value();
+}
@@ -28,10 +28,16 @@
 #include <ace/Basic_Types.h>
 #include <ace/Singleton.h>
 #include <ace/Thread_Mutex.h>
+#include <ace/Atomic_Op.h>
+
+#include <vector>
+
+#include "Define.h"
 
 class WorldSocket;
 class ReactorRunnable;
 class ACE_Event_Handler;
+class ACE_Message_Block;
 
 /// Manages all sockets connected to peers and network threads
 class WorldSocketMgr
@@ -49,9 +55,20 @@ public:
     /// Wait untill all network threads have "joined" .
     void Wait();
 
+    /// Number of send calls done by the sockets and bytes written by them.
+    void GetOutputStatistics(uint64& sendCalls, uint64& sentBytes) const;
+
 private:
     int OnSocketOpen(WorldSocket* sock);
 
+    /// Fixed size block for the output queue of a socket, taken from the pool if possible.
+    ACE_Message_Block* AcquireOutputChunk();
+
+    /// Returns a block dequeued from the output queue of a socket, chunks go back to the pool.
+    void ReleaseOutputBlock(ACE_Message_Block* mb);
+
+    void CountSend(size_t bytes);
+
     int StartReactiveIO(ACE_UINT16 port, const char* address);
 
 private:
@@ -66,6 +83,12 @@ private:
     bool m_UseNoDelay;
 
     class WorldSocketAcceptor* m_Acceptor;
+
+    ACE_Thread_Mutex m_OutputChunksLock;
+    std::vector<ACE_Message_Block*> m_OutputChunks;     // free chunks
+
+    ACE_Atomic_Op<ACE_Thread_Mutex, uint64> m_SendCalls;
+    ACE_Atomic_Op<ACE_Thread_Mutex, uint64> m_SentBytes;
 };
 
 #define sWorldSocketMgr ACE_Singleton<WorldSocketMgr, ACE_Thread_Mutex>::instance()
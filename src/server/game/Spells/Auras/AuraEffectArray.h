@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_AURAEFFECTARRAY_H
+#define TRINITY_AURAEFFECTARRAY_H
+
+#include "Common.h"
+#include "Errors.h"
+
+#include <algorithm>
+#include <iterator>
+
+class AuraEffect;
+
+/*
+ * Contiguous list of aura effects, used for the auras of a unit by aura
+ * type (Unit::AuraEffectList).
+ *
+ * Iterators are an index into the array, so adding effects while
+ * iterating does not invalidate them, the way the std::list it replaces
+ * behaved. A removed effect stays in its slot, marked in the low bit of
+ * the pointer, and is skipped by iterators moving on. Removing any
+ * effect, the current one included, is therefore safe, and an iterator
+ * still on a removed effect keeps returning it. The slots are only
+ * reclaimed by Compact(), which must not be called while the list is
+ * iterated.
+ *
+ * An empty list allocates nothing and takes 16 bytes.
+ */
+class AuraEffectArray
+{
+    public:
+        class const_iterator
+        {
+            public:
+                typedef std::bidirectional_iterator_tag iterator_category;
+                typedef AuraEffect* value_type;
+                typedef ptrdiff_t difference_type;
+                typedef AuraEffect* const* pointer;
+                typedef AuraEffect* reference;
+
+                const_iterator() : m_array(NULL), m_index(0) { }
+
+                reference operator*() const { return Unmark(m_array->m_effects[m_index]); }
+
+                const_iterator& operator++()
+                {
+                    m_index = m_array->NextIndex(m_index + 1);
+                    return *this;
+                }
+
+                const_iterator operator++(int)
+                {
+                    const_iterator itr = *this;
+                    ++(*this);
+                    return itr;
+                }
+
+                const_iterator& operator--()
+                {
+                    do
+                        --m_index;
+                    while (IsRemoved(m_array->m_effects[m_index]));
+                    return *this;
+                }
+
+                const_iterator operator--(int)
+                {
+                    const_iterator itr = *this;
+                    --(*this);
+                    return itr;
+                }
+
+                bool operator==(const_iterator const& right) const { return m_index == right.m_index && m_array == right.m_array; }
+                bool operator!=(const_iterator const& right) const { return !(*this == right); }
+
+            private:
+                friend class AuraEffectArray;
+
+                const_iterator(AuraEffectArray const* array, uint32 index) : m_array(array), m_index(index) { }
+
+                AuraEffectArray const* m_array;
+                uint32 m_index;
+        };
+
+        typedef const_iterator iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+        typedef const_reverse_iterator reverse_iterator;
+
+        AuraEffectArray() : m_effects(NULL), m_size(0), m_capacity(0), m_removed(0) { }
+
+        AuraEffectArray(AuraEffectArray const& right) : m_effects(NULL), m_size(0), m_capacity(0), m_removed(0)
+        {
+            Reserve(right.size());
+            for (const_iterator itr = right.begin(); itr != right.end(); ++itr)
+                m_effects[m_size++] = *itr;
+        }
+
+        ~AuraEffectArray() { free(m_effects); }
+
+        AuraEffectArray& operator=(AuraEffectArray const& right)
+        {
+            AuraEffectArray copy(right);
+            std::swap(m_effects, copy.m_effects);
+            std::swap(m_size, copy.m_size);
+            std::swap(m_capacity, copy.m_capacity);
+            std::swap(m_removed, copy.m_removed);
+            return *this;
+        }
+
+        const_iterator begin() const { return const_iterator(this, NextIndex(0)); }
+        const_iterator end() const { return const_iterator(this, m_size); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+        bool empty() const { return m_size == m_removed; }
+        size_t size() const { return m_size - m_removed; }
+        AuraEffect* front() const { return *begin(); }
+        AuraEffect* back() const { return *rbegin(); }
+
+        void push_back(AuraEffect* aurEff)
+        {
+            ASSERT(aurEff);
+            if (m_size == m_capacity)
+                Reserve(m_capacity ? m_capacity * 2 : 4);
+
+            m_effects[m_size++] = aurEff;
+        }
+
+        // marks the slot removed, returns whether the list has to be compacted now
+        bool remove(AuraEffect* aurEff)
+        {
+            AuraEffect** effect = std::find(m_effects, m_effects + m_size, aurEff);
+            if (effect == m_effects + m_size)
+                return false;
+
+            *effect = Mark(*effect);
+            return ++m_removed == 1;
+        }
+
+        // reclaims the slots of the removed effects, keeping the order
+        void Compact()
+        {
+            if (!m_removed)
+                return;
+
+            m_size = uint16(std::remove_if(m_effects, m_effects + m_size, IsRemoved) - m_effects);
+            m_removed = 0;
+        }
+
+        // stable, like std::list::sort
+        template<class Predicate>
+        void sort(Predicate pred)
+        {
+            Compact();
+            std::stable_sort(m_effects, m_effects + m_size, pred);
+        }
+
+    private:
+        static AuraEffect* Mark(AuraEffect* aurEff) { return (AuraEffect*)(size_t(aurEff) | 1); }
+        static AuraEffect* Unmark(AuraEffect* aurEff) { return (AuraEffect*)(size_t(aurEff) & ~size_t(1)); }
+        static bool IsRemoved(AuraEffect* aurEff) { return size_t(aurEff) & 1; }
+
+        uint32 NextIndex(uint32 index) const
+        {
+            while (index < m_size && IsRemoved(m_effects[index]))
+                ++index;
+            return index;
+        }
+
+        void Reserve(size_t capacity)
+        {
+            if (capacity <= m_capacity)
+                return;
+
+            ASSERT(capacity <= 0xFFFF);
+            AuraEffect** effects = (AuraEffect**)realloc(m_effects, capacity * sizeof(AuraEffect*));
+            ASSERT(effects);
+            m_effects = effects;
+            m_capacity = uint16(capacity);
+        }
+
+        AuraEffect** m_effects;
+        uint16 m_size;                                      // used slots, including the empty ones
+        uint16 m_capacity;
+        uint16 m_removed;                                   // slots of removed effects
+};
+
+#endif
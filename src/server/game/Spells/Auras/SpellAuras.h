@@ -53,6 +53,7 @@ class AuraApplication
         uint8 m_effectsToApply;                         // Used only at spell hit to determine which effect should be applied
         AuraRemoveMode m_removeMode:8;                  // Store info for know remove aura reason
         bool m_needClientUpdate:1;
+        uint32 m_applySequence;                         // Order of application on the target, see Unit::_CreateAuraApplication
 
         explicit AuraApplication(Unit* target, Unit* caster, Aura * base, uint8 effMask);
         void _Remove();
@@ -71,6 +72,7 @@ class AuraApplication
         bool IsPositive() const { return m_flags & AFLAG_POSITIVE; }
         bool IsSelfcasted() const { return m_flags & AFLAG_CASTER; }
         uint8 GetEffectsToApply() const { return m_effectsToApply; }
+        uint32 GetApplySequence() const { return m_applySequence; }
 
         void SetRemoveMode(AuraRemoveMode mode) { m_removeMode = mode; }
         AuraRemoveMode GetRemoveMode() const {return m_removeMode;}
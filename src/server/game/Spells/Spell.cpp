@@ -950,7 +950,7 @@ void Spell::CleanupTargetList()
     m_delayMoment = 0;
 }
 
-void Spell::AddUnitTarget(Unit* pVictim, uint32 effIndex, bool checkIfValid /*=true*/)
+void Spell::AddUnitTarget(Unit* pVictim, uint32 effIndex, bool checkIfValid /*=true*/, bool checkLOS /*=true*/)
 {
     if (!m_spellInfo->Effects[effIndex].IsEffect())
         return;
@@ -958,7 +958,7 @@ void Spell::AddUnitTarget(Unit* pVictim, uint32 effIndex, bool checkIfValid /*=t
     if (checkIfValid)
         if (m_spellInfo->CheckTarget(m_caster, pVictim, true) != SPELL_CAST_OK)
             return;
-    if (!CheckEffectTarget(pVictim, effIndex))
+    if (!CheckEffectTarget(pVictim, effIndex, checkLOS))
         return;
 
     // Check for effect immune skip if immuned
@@ -2507,8 +2507,10 @@ void Spell::SelectEffectTargets(uint32 i, SpellImplicitTargetInfo const& cur)
 
             CallScriptAfterUnitTargetSelectHandlers(unitList, SpellEffIndex(i));
 
+            bool checkLOS = !RemoveTargetsNotInLOS(unitList, i);
+
             for (std::list<Unit*>::iterator itr = unitList.begin(); itr != unitList.end(); ++itr)
-                AddUnitTarget(*itr, i, false);
+                AddUnitTarget(*itr, i, false, checkLOS);
         }
         else
             AddUnitTarget(target, i, false);
@@ -2866,8 +2868,10 @@ void Spell::SelectEffectTargets(uint32 i, SpellImplicitTargetInfo const& cur)
 
             CallScriptAfterUnitTargetSelectHandlers(unitList, SpellEffIndex(i));
 
+            bool checkLOS = !RemoveTargetsNotInLOS(unitList, i);
+
             for (std::list<Unit*>::iterator itr = unitList.begin(); itr != unitList.end(); ++itr)
-                AddUnitTarget(*itr, i, false);
+                AddUnitTarget(*itr, i, false, checkLOS);
         }
 
         if (!gobjectList.empty())
@@ -6484,7 +6488,7 @@ CurrentSpellTypes Spell::GetCurrentContainer() const
         return(CURRENT_GENERIC_SPELL);
 }
 
-bool Spell::CheckEffectTarget(Unit const* target, uint32 eff) const
+bool Spell::CheckEffectTarget(Unit const* target, uint32 eff, bool checkLOS /*= true*/) const
 {
     switch(m_spellInfo->Effects[eff].ApplyAuraName)
     {
@@ -6506,7 +6510,7 @@ bool Spell::CheckEffectTarget(Unit const* target, uint32 eff) const
             break;
     }
 
-    if (m_spellInfo->AttributesEx2 & SPELL_ATTR2_CAN_TARGET_NOT_IN_LOS)
+    if (m_spellInfo->AttributesEx2 & SPELL_ATTR2_CAN_TARGET_NOT_IN_LOS || !checkLOS)
         return true;
 
     // todo: shit below shouldn't be here, but it's temporary
@@ -6534,13 +6538,7 @@ bool Spell::CheckEffectTarget(Unit const* target, uint32 eff) const
             // all ok by some way or another, skip normal check
             break;
         default:                                            // normal case
-            // Get GO cast coordinates if original caster -> GO
-            WorldObject *caster = NULL;
-            if (IS_GAMEOBJECT_GUID(m_originalCasterGUID))
-                caster = m_caster->GetMap()->GetGameObject(m_originalCasterGUID);
-            if (!caster)
-                caster = m_caster;
-            if (target != m_caster && !target->IsWithinLOSInMap(caster))
+            if (target != m_caster && !target->IsWithinLOSInMap(GetLOSCaster()))
                 return false;
             break;
     }
@@ -6548,6 +6546,78 @@ bool Spell::CheckEffectTarget(Unit const* target, uint32 eff) const
     return true;
 }
 
+WorldObject* Spell::GetLOSCaster() const
+{
+    // Get GO cast coordinates if original caster -> GO
+    WorldObject *caster = NULL;
+    if (IS_GAMEOBJECT_GUID(m_originalCasterGUID))
+        caster = m_caster->GetMap()->GetGameObject(m_originalCasterGUID);
+    if (!caster)
+        caster = m_caster;
+    return caster;
+}
+
+// does the line of sight part of CheckEffectTarget() for all area targets at once,
+// returns false if the spell effect does not use it
+bool Spell::RemoveTargetsNotInLOS(std::list<Unit*>& unitList, uint32 eff) const
+{
+    if (m_spellInfo->AttributesEx2 & SPELL_ATTR2_CAN_TARGET_NOT_IN_LOS)
+        return false;
+
+    // has its own checks
+    if (m_spellInfo->Effects[eff].Effect == SPELL_EFFECT_RESURRECT_NEW)
+        return false;
+
+    WorldObject* caster = GetLOSCaster();
+    float cx, cy, cz;
+    caster->GetPosition(cx, cy, cz);
+
+    std::vector<float> coords;
+    coords.reserve(unitList.size() * 6);
+    for (std::list<Unit*>::iterator itr = unitList.begin(); itr != unitList.end();)
+    {
+        if (*itr == m_caster)
+        {
+            ++itr;
+            continue;
+        }
+
+        if (!(*itr)->IsInMap(caster))
+        {
+            itr = unitList.erase(itr);
+            continue;
+        }
+
+        // same ray as WorldObject::IsWithinLOS()
+        coords.push_back((*itr)->GetPositionX());
+        coords.push_back((*itr)->GetPositionY());
+        coords.push_back((*itr)->GetPositionZ() + 2.0f);
+        coords.push_back(cx);
+        coords.push_back(cy);
+        coords.push_back(cz + 2.0f);
+        ++itr;
+    }
+
+    uint32 count = coords.size() / 6;
+    if (!count)
+        return true;
+
+    bool* inLOS = new bool[count];
+    VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(caster->GetMapId(), &coords[0], count, inLOS);
+
+    uint32 index = 0;
+    for (std::list<Unit*>::iterator itr = unitList.begin(); itr != unitList.end();)
+    {
+        if (*itr != m_caster && !inLOS[index++])
+            itr = unitList.erase(itr);
+        else
+            ++itr;
+    }
+
+    delete[] inLOS;
+    return true;
+}
+
 bool Spell::IsNextMeleeSwingSpell() const
 {
     return m_spellInfo->Attributes & SPELL_ATTR0_ON_NEXT_SWING;
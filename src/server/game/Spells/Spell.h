@@ -405,7 +405,9 @@ class Spell
 
         template<typename T> WorldObject* FindCorpseUsing();
 
-        bool CheckEffectTarget(Unit const* target, uint32 eff) const;
+        bool CheckEffectTarget(Unit const* target, uint32 eff, bool checkLOS = true) const;
+        WorldObject* GetLOSCaster() const;
+        bool RemoveTargetsNotInLOS(std::list<Unit*>& unitList, uint32 eff) const;
         bool CanAutoCast(Unit* target);
         void CheckSrc() { if (!m_targets.HasSrc()) m_targets.SetSrc(*m_caster); }
         void CheckDst() { if (!m_targets.HasDst()) m_targets.SetDst(*m_caster); }
@@ -588,7 +590,7 @@ class Spell
         };
         std::list<ItemTargetInfo> m_UniqueItemInfo;
 
-        void AddUnitTarget(Unit* target, uint32 effIndex, bool checkIfValid = true);
+        void AddUnitTarget(Unit* target, uint32 effIndex, bool checkIfValid = true, bool checkLOS = true);
         void AddGOTarget(GameObject* target, uint32 effIndex);
         void AddGOTarget(uint64 goGUID, uint32 effIndex);
         void AddItemTarget(Item* target, uint32 effIndex);
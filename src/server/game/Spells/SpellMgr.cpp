@@ -387,7 +387,7 @@ bool IsDiminishingReturnsGroupDurationLimited(DiminishingGroup group)
     }
 }
 
-SpellMgr::SpellMgr()
+SpellMgr::SpellMgr() : mProcDataGeneration(0)
 {
 }
 
@@ -793,6 +793,20 @@ SpellProcEventEntry const* SpellMgr::GetSpellProcEvent(uint32 spellId) const
     return NULL;
 }
 
+uint32 SpellMgr::GetSpellProcFlags(SpellInfo const* spellInfo) const
+{
+    // handled by new proc system
+    if (GetSpellProcEntry(spellInfo->Id))
+        return 0;
+
+    // custom spellProcEvent->procFlags if exist, else get from spell proto
+    SpellProcEventEntry const* spellProcEvent = GetSpellProcEvent(spellInfo->Id);
+    if (spellProcEvent && spellProcEvent->procFlags)
+        return spellProcEvent->procFlags;
+
+    return spellInfo->ProcFlags;
+}
+
 bool SpellMgr::IsSpellProcEventCanTriggeredBy(SpellProcEventEntry const* spellProcEvent, uint32 EventProcFlag, SpellInfo const* procSpell, uint32 procFlags, uint32 procExtra, bool active)
 {
     // No extra req need
@@ -1736,6 +1750,7 @@ void SpellMgr::LoadSpellProcEvents()
     uint32 oldMSTime = getMSTime();
 
     mSpellProcEventMap.clear();                             // need for reload case
+    ++mProcDataGeneration;                                  // proc aura indexes of units are rebuilt
 
     uint32 count = 0;
 
@@ -1801,6 +1816,7 @@ void SpellMgr::LoadSpellProcs()
     uint32 oldMSTime = getMSTime();
 
     mSpellProcMap.clear();                             // need for reload case
+    ++mProcDataGeneration;                             // proc aura indexes of units are rebuilt
 
     uint32 count = 0;
 
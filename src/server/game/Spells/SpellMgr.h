@@ -594,6 +594,10 @@ class SpellMgr
         // Spell proc event table
         SpellProcEventEntry const* GetSpellProcEvent(uint32 spellId) const;
         bool IsSpellProcEventCanTriggeredBy(SpellProcEventEntry const* spellProcEvent, uint32 EventProcFlag, SpellInfo const* procSpell, uint32 procFlags, uint32 procExtra, bool active);
+        // proc flags auras of the spell can be triggered by in Unit::ProcDamageAndSpellFor, 0 for auras of the new proc system
+        uint32 GetSpellProcFlags(SpellInfo const* spellInfo) const;
+        // changes whenever the proc tables are (re)loaded
+        uint32 GetProcDataGeneration() const { return mProcDataGeneration; }
 
         // Spell proc table
         SpellProcEntry const* GetSpellProcEntry(uint32 spellId) const;
@@ -670,6 +674,7 @@ class SpellMgr
         SpellGroupStackMap         mSpellGroupStack;
         SpellProcEventMap          mSpellProcEventMap;
         SpellProcMap               mSpellProcMap;
+        uint32                     mProcDataGeneration;
         SpellBonusMap              mSpellBonusMap;
         SpellThreatMap             mSpellThreatMap;
         SpellPetAuraMap            mSpellPetAuraMap;
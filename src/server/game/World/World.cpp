@@ -28,6 +28,7 @@
 #include "Opcodes.h"
 #include "WorldSession.h"
 #include "WorldPacket.h"
+#include "SharedWorldPacket.h"
 #include "Player.h"
 #include "Vehicle.h"
 #include "SkillExtraItems.h"
@@ -574,6 +575,8 @@ void World::LoadConfigSettings(bool reload)
         sLog->outError("Compression level (%i) must be in range 1..9. Using default compression level (1).", m_int_configs[CONFIG_COMPRESSION]);
         m_int_configs[CONFIG_COMPRESSION] = 1;
     }
+    m_int_configs[CONFIG_COMPRESSION_ADAPTIVE_MIN_SIZE] = sConfig->GetIntDefault("Compression.Adaptive.MinSize", 0);
+    m_int_configs[CONFIG_COMPRESSION_ADAPTIVE_MAX_DIFF] = sConfig->GetIntDefault("Compression.Adaptive.MaxUpdateDiff", 0);
     m_bool_configs[CONFIG_ADDON_CHANNEL] = sConfig->GetBoolDefault("AddonChannel", true);
     m_bool_configs[CONFIG_CLEAN_CHARACTER_DB] = sConfig->GetBoolDefault("CleanCharacterDB", false);
     m_int_configs[CONFIG_PERSISTENT_CHARACTER_CLEAN_FLAGS] = sConfig->GetIntDefault("PersistentCharacterCleanFlags", 0);
@@ -1172,6 +1175,10 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_INTERVAL_LOG_UPDATE] = sConfig->GetIntDefault("RecordUpdateTimeDiffInterval", 60000);
     m_int_configs[CONFIG_MIN_LOG_UPDATE] = sConfig->GetIntDefault("MinRecordUpdateTimeDiff", 100);
     m_int_configs[CONFIG_NUMTHREADS] = sConfig->GetIntDefault("MapUpdate.Threads", 1);
+    m_bool_configs[CONFIG_MAP_UPDATE_REGIONS] = sConfig->GetBoolDefault("MapUpdate.Regions", false);
+    m_int_configs[CONFIG_GRID_PRELOAD_THREADS] = sConfig->GetIntDefault("GridPreload.Threads", 0);
+    m_int_configs[CONFIG_GRID_PRELOAD_LOOKAHEAD] = sConfig->GetIntDefault("GridPreload.LookAhead", 10);
+    m_bool_configs[CONFIG_GRID_MAP_MEMORY_MAPPED] = sConfig->GetBoolDefault("GridMap.MemoryMapped", false);
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = sConfig->GetIntDefault("Command.LookupMaxResults", 0);
     
     // Warden
@@ -1183,6 +1190,7 @@ void World::LoadConfigSettings(bool reload)
     
     // Dungeon finder
     m_bool_configs[CONFIG_DUNGEON_FINDER_ENABLE] = sConfig->GetBoolDefault("DungeonFinder.Enable", false);
+    m_bool_configs[CONFIG_DUNGEON_FINDER_BACKGROUND_MATCHING] = sConfig->GetBoolDefault("DungeonFinder.BackgroundMatching", false);
 
     // DBC_ItemAttributes
     m_bool_configs[CONFIG_DBC_ENFORCE_ITEM_ATTRIBUTES] = sConfig->GetBoolDefault("DBC.EnforceItemAttributes", true);
@@ -1289,6 +1297,13 @@ void World::SetInitialWorldSettings()
     LoadDBCStores(m_dataPath);
     DetectDBCLang();
 
+    std::vector<uint32> mapIds;
+    for (uint32 mapId = 0; mapId < sMapStore.GetNumRows(); ++mapId)
+        if (sMapStore.LookupEntry(mapId))
+            mapIds.push_back(mapId);
+
+    VMAP::VMapFactory::createOrGetVMapManager()->initializeMaps((m_dataPath + "vmaps").c_str(), mapIds);
+
     sLog->outString("Loading spell dbc data corrections...");
     sSpellMgr->LoadDbcDataCorrections();
 
@@ -1982,6 +1997,9 @@ void World::Update(uint32 diff)
     ///- Update objects when the timer has passed (maps, transport, creatures, ...)
     sMapMgr->Update(diff);
 
+    // no map is updated until the next tick, nothing looks up objects from other threads
+    sObjectAccessor->ReleaseRetiredLookupTables();
+
     if (sWorld->getBoolConfig(CONFIG_AUTOBROADCAST))
     {
         if (m_timers[WUPDATE_AUTOBROADCAST].Passed())
@@ -2007,6 +2025,9 @@ void World::Update(uint32 diff)
     sLFGMgr->Update(diff);
     RecordTimeDiff("UpdateLFGMgr");
 
+    sAnticheatMgr->Update();
+    RecordTimeDiff("UpdateAnticheatMgr");
+
     // execute callbacks from sql queries that were queued recently
     ProcessQueryCallbacks();
     RecordTimeDiff("ProcessQueryCallbacks");
@@ -2057,6 +2078,7 @@ void World::ForceGameEventUpdate()
 /// Send a packet to all players (except self if mentioned)
 void World::SendGlobalMessage(WorldPacket* packet, WorldSession* self, uint32 team)
 {
+    SharedWorldPacket shared(*packet);
     SessionMap::const_iterator itr;
     for (itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
     {
@@ -2066,7 +2088,7 @@ void World::SendGlobalMessage(WorldPacket* packet, WorldSession* self, uint32 te
             itr->second != self &&
             (team == 0 || itr->second->GetPlayer()->GetTeam() == team))
         {
-            itr->second->SendPacket(packet);
+            itr->second->SendPacket(shared);
         }
     }
 }
@@ -2074,6 +2096,7 @@ void World::SendGlobalMessage(WorldPacket* packet, WorldSession* self, uint32 te
 /// Send a packet to all GMs (except self if mentioned)
 void World::SendGlobalGMMessage(WorldPacket* packet, WorldSession* self, uint32 team)
 {
+    SharedWorldPacket shared(*packet);
     SessionMap::iterator itr;
     for (itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
     {
@@ -2084,7 +2107,7 @@ void World::SendGlobalGMMessage(WorldPacket* packet, WorldSession* self, uint32
             itr->second->GetSecurity() > SEC_PLAYER &&
             (team == 0 || itr->second->GetPlayer()->GetTeam() == team))
         {
-            itr->second->SendPacket(packet);
+            itr->second->SendPacket(shared);
         }
     }
 }
@@ -2208,6 +2231,7 @@ void World::SendGlobalText(const char* text, WorldSession* self)
 /// Send a packet to all players (or players selected team) in the zone (except self if mentioned)
 void World::SendZoneMessage(uint32 zone, WorldPacket* packet, WorldSession* self, uint32 team)
 {
+    SharedWorldPacket shared(*packet);
     SessionMap::const_iterator itr;
     for (itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
     {
@@ -2218,7 +2242,7 @@ void World::SendZoneMessage(uint32 zone, WorldPacket* packet, WorldSession* self
             itr->second != self &&
             (team == 0 || itr->second->GetPlayer()->GetTeam() == team))
         {
-            itr->second->SendPacket(packet);
+            itr->second->SendPacket(shared);
         }
     }
 }
@@ -145,6 +145,7 @@ enum WorldBoolConfigs
     CONFIG_NO_RESET_TALENT_COST,
     CONFIG_SHOW_KICK_IN_WORLD,
     CONFIG_DUNGEON_FINDER_ENABLE,
+    CONFIG_DUNGEON_FINDER_BACKGROUND_MATCHING,
     CONFIG_AUTOBROADCAST,
     CONFIG_ALLOW_TICKETS,
     CONFIG_DBC_ENFORCE_ITEM_ATTRIBUTES,
@@ -155,6 +156,8 @@ enum WorldBoolConfigs
     CONFIG_OUTDOORPVP_WINTERGRASP_ENABLED,
     CONFIG_OUTDOORPVP_WINTERGRASP_CUSTOM_HONOR,
     CONFIG_CONFIG_OUTDOORPVP_WINTERGRASP_ANTIFARM_ENABLE,
+    CONFIG_MAP_UPDATE_REGIONS,
+    CONFIG_GRID_MAP_MEMORY_MAPPED,
     BOOL_CONFIG_VALUE_COUNT
 };
 
@@ -177,6 +180,8 @@ enum WorldFloatConfigs
 enum WorldIntConfigs
 {
     CONFIG_COMPRESSION = 0,
+    CONFIG_COMPRESSION_ADAPTIVE_MIN_SIZE,
+    CONFIG_COMPRESSION_ADAPTIVE_MAX_DIFF,
     CONFIG_INTERVAL_SAVE,
     CONFIG_INTERVAL_GRIDCLEAN,
     CONFIG_INTERVAL_MAPUPDATE,
@@ -287,6 +292,8 @@ enum WorldIntConfigs
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_PLAYER_ALLOW_COMMANDS,
     CONFIG_NUMTHREADS,
+    CONFIG_GRID_PRELOAD_THREADS,
+    CONFIG_GRID_PRELOAD_LOOKAHEAD,
     CONFIG_LOGDB_CLEARINTERVAL,
     CONFIG_LOGDB_CLEARTIME,
     CONFIG_CLIENTCACHE_VERSION,
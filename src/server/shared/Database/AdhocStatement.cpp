@@ -54,3 +54,13 @@ bool BasicStatementTask::Execute()
 
     return m_conn->Execute(m_sql);
 }
+
+bool BasicStatementTask::GetBatchElement(SQLElementData& element) const
+{
+    if (m_has_result)
+        return false;
+
+    element.type = SQL_ELEMENT_RAW;
+    element.element.query = m_sql;
+    return true;
+}
@@ -31,6 +31,7 @@ class BasicStatementTask : public SQLOperation
         ~BasicStatementTask();
 
         bool Execute();
+        bool GetBatchElement(SQLElementData& element) const;
 
     private:
         const char* m_sql;      //- Raw query to be executed
@@ -21,6 +21,8 @@
 #include "MySQLConnection.h"
 #include "MySQLThreading.h"
 
+#include <ace/OS_NS_sys_time.h>
+
 DatabaseWorker::DatabaseWorker(ACE_Activation_Queue* new_queue, MySQLConnection* con) :
 m_queue(new_queue),
 m_conn(con)
@@ -35,12 +37,49 @@ int DatabaseWorker::svc()
         return -1;
 
     SQLOperation *request = NULL;
+    SQLOperation *next = NULL;
+    std::vector<SQLOperation*> batch;
+    std::vector<SQLElementData> elements;
     while (1)
     {
-        request = (SQLOperation*)(m_queue->dequeue());
+        request = next ? next : (SQLOperation*)(m_queue->dequeue());
+        next = NULL;
         if (!request)
             break;
 
+        SQLElementData element;
+        if (request->GetBatchElement(element))
+        {
+            /// Take the one-way statements queued right behind this one, without waiting for more
+            batch.push_back(request);
+            elements.push_back(element);
+            while (batch.size() < MAX_BATCH_OPERATIONS)
+            {
+                ACE_Time_Value now = ACE_OS::gettimeofday();
+                next = (SQLOperation*)(m_queue->dequeue(&now));
+                if (!next || !next->GetBatchElement(element))
+                    break;
+
+                batch.push_back(next);
+                elements.push_back(element);
+                next = NULL;
+            }
+
+            if (batch.size() > 1)
+            {
+                m_conn->ExecuteBatch(elements);
+                for (size_t i = 0; i < batch.size(); ++i)
+                    delete batch[i];
+
+                batch.clear();
+                elements.clear();
+                continue;
+            }
+
+            batch.clear();
+            elements.clear();
+        }
+
         request->SetConnection(m_conn);
         request->call();
 
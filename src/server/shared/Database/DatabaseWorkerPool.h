@@ -19,6 +19,10 @@
 #define _DATABASEWORKERPOOL_H
 
 #include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+#include <ace/OS_NS_sys_time.h>
+
+#include <deque>
 
 #include "Common.h"
 #include "Callback.h"
@@ -47,13 +51,42 @@ class PingOperation : public SQLOperation
     }
 };
 
+//! Callers of synchronous operations that are not prepared statements, counted apart from the statement indexes
+enum DatabaseSynchCaller
+{
+    SYNCH_CALLER_ADHOC       = 0xFFFFFFFF,
+    SYNCH_CALLER_TRANSACTION = 0xFFFFFFFE,
+};
+
+//! Upper bounds, in microseconds, of the connection wait time histogram buckets; the last bucket is unbounded
+static const uint32 DatabaseWaitBucketBounds[] = { 1, 1000, 10000, 100000, 1000000 };
+#define DATABASE_WAIT_BUCKETS (sizeof(DatabaseWaitBucketBounds) / sizeof(DatabaseWaitBucketBounds[0]) + 1)
+
+struct DatabasePoolStatistics
+{
+    DatabasePoolStatistics() : activeConnections(0), idleConnections(0), waitingThreads(0), waitTimeouts(0)
+    {
+        memset(waitHistogram, 0, sizeof(waitHistogram));
+    }
+
+    uint32 activeConnections;
+    uint32 idleConnections;
+    uint32 waitingThreads;
+    uint64 waitHistogram[DATABASE_WAIT_BUCKETS];    //! Synchronous operations by time waited for a connection
+    uint64 waitTimeouts;                            //! Waits that exceeded the configured timeout
+    std::map<uint32, uint64> queriesByCaller;       //! By prepared statement index or DatabaseSynchCaller
+};
+
 template <class T>
 class DatabaseWorkerPool
 {
     public:
         /* Activity state */
         DatabaseWorkerPool() :
-        m_queue(new ACE_Activation_Queue(new ACE_Message_Queue<ACE_MT_SYNCH>))
+        m_queue(new ACE_Activation_Queue(new ACE_Message_Queue<ACE_MT_SYNCH>)),
+        m_escapeConnection(NULL),
+        m_retiringConnections(0),
+        m_waitTimeout(0)
         {
             memset(m_connectionCount, 0, sizeof(m_connectionCount));
             m_connections.resize(IDX_SIZE);
@@ -90,9 +123,14 @@ class DatabaseWorkerPool
                 T* t = new T(m_connectionInfo);
                 res &= t->Open();
                 m_connections[IDX_SYNCH][i] = t;
+                m_idleConnections.push_back(t);
                 ++m_connectionCount[IDX_SYNCH];
             }
 
+            // the first synchronous connection is never retired, escaping uses its handle without taking m_synchLock
+            if (synch_threads)
+                m_escapeConnection = m_connections[IDX_SYNCH][0];
+
             sLogMgr->WriteLn(SQLDRIVER_LOG, "Databasepool opened succesfuly. %u total connections running.", (m_connectionCount[IDX_SYNCH] + m_connectionCount[IDX_ASYNC]));
             return res;
         }
@@ -175,9 +213,9 @@ class DatabaseWorkerPool
             if (!sql)
                 return;
 
-            T* t = GetFreeConnection();
+            T* t = GetFreeConnection(SYNCH_CALLER_ADHOC);
             t->Execute(sql);
-            t->Unlock();
+            ReleaseConnection(t);
         }
 
         //! Directly executes a one-way SQL operation in string format -with variable args-, that will block the calling thread until finished.
@@ -198,9 +236,9 @@ class DatabaseWorkerPool
         //! Directly executes a one-way SQL operation in prepared statement format, that will block the calling thread until finished.
         void DirectExecute(PreparedStatement* stmt)
         {
-            T* t = GetFreeConnection();
+            T* t = GetFreeConnection(stmt->GetIndex());
             t->Execute(stmt);
-            t->Unlock();
+            ReleaseConnection(t);
         }
 
         /**
@@ -209,13 +247,13 @@ class DatabaseWorkerPool
 
         //! Directly executes an SQL query in string format that will block the calling thread until finished.
         //! Returns reference counted auto pointer, no need for manual memory management in upper level code.
-        QueryResult Query(const char* sql, MySQLConnection* conn = NULL)
+        QueryResult Query(const char* sql, T* conn = NULL)
         {
             if (!conn)
-                conn = GetFreeConnection();
+                conn = GetFreeConnection(SYNCH_CALLER_ADHOC);
 
             ResultSet* result = conn->Query(sql);
-            conn->Unlock();
+            ReleaseConnection(conn);
             if (!result || !result->GetRowCount())
                 return QueryResult(NULL);
 
@@ -225,7 +263,7 @@ class DatabaseWorkerPool
 
         //! Directly executes an SQL query in string format -with variable args- that will block the calling thread until finished.
         //! Returns reference counted auto pointer, no need for manual memory management in upper level code.
-        QueryResult PQuery(const char* sql, MySQLConnection* conn, ...)
+        QueryResult PQuery(const char* sql, T* conn, ...)
         {
             if (!sql)
                 return QueryResult(NULL);
@@ -259,9 +297,9 @@ class DatabaseWorkerPool
         //! Returns reference counted auto pointer, no need for manual memory management in upper level code.
         PreparedQueryResult Query(PreparedStatement* stmt)
         {
-            T* t = GetFreeConnection();
+            T* t = GetFreeConnection(stmt->GetIndex());
             PreparedResultSet* ret = t->Query(stmt);
-            t->Unlock();
+            ReleaseConnection(t);
 
             if (!ret || !ret->GetRowCount())
                 return PreparedQueryResult(NULL);
@@ -353,10 +391,10 @@ class DatabaseWorkerPool
         //! were appended to the transaction will be respected during execution.
         void DirectCommitTransaction(SQLTransaction& transaction)
         {
-            MySQLConnection* con = GetFreeConnection();
+            T* con = GetFreeConnection(SYNCH_CALLER_TRANSACTION);
             if (con->ExecuteTransaction(transaction))
             {
-                con->Unlock();      // OK, operation succesful
+                ReleaseConnection(con);     // OK, operation succesful
                 return;
             }
 
@@ -373,7 +411,7 @@ class DatabaseWorkerPool
             // Clean up now.
             transaction->Cleanup();
 
-            con->Unlock();
+            ReleaseConnection(con);
         }
 
         //! Method used to execute prepared statements in a diverse context.
@@ -422,15 +460,18 @@ class DatabaseWorkerPool
         //! Keeps all our MySQL connections alive, prevent the server from disconnecting us.
         void KeepAlive()
         {
-            /// Ping synchronous connections
-            for (uint8 i = 0; i < m_connectionCount[IDX_SYNCH]; ++i)
+            /// Ping idle synchronous connections, the others are in use anyway
+            std::vector<T*> idle;
             {
-                T* t = m_connections[IDX_SYNCH][i];
-                if (t->LockIfReady())
-                {
-                    t->Ping();
-                    t->Unlock();
-                }
+                ACE_GUARD(ACE_Thread_Mutex, guard, m_synchLock);
+                idle.swap(m_idleConnections);
+            }
+
+            for (size_t i = 0; i < idle.size(); ++i)
+            {
+                idle[i]->LockIfReady();
+                idle[i]->Ping();
+                ReleaseConnection(idle[i]);
             }
 
             /// Assuming all worker threads are free, every worker thread will receive 1 ping operation request
@@ -440,13 +481,102 @@ class DatabaseWorkerPool
                 Enqueue(new PingOperation);
         }
 
+        /**
+            Synchronous connection management.
+        */
+
+        //! Time in milliseconds after which a thread still waiting for a synchronous connection is reported
+        //! in the SQL driver log. The thread keeps its place in line, as callers can't do without a connection. 0 disables.
+        void SetConnectionWaitTimeout(uint32 timeout)
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, m_synchLock);
+            m_waitTimeout = timeout;
+        }
+
+        //! Opens one more synchronous connection and hands it out right away.
+        bool AddSynchConnection()
+        {
+            {
+                ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_synchLock, false);
+                /// Keep a connection that was to be closed instead
+                if (m_retiringConnections)
+                {
+                    --m_retiringConnections;
+                    return true;
+                }
+            }
+
+            T* t = new T(m_connectionInfo);
+            if (!t->Open())
+                return false;   /// A connection without MySQL context can't be destroyed, see ~MySQLConnection
+
+            {
+                ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_synchLock, false);
+                m_connections[IDX_SYNCH].push_back(t);
+                ++m_connectionCount[IDX_SYNCH];
+            }
+
+            t->LockIfReady();
+            ReleaseConnection(t);
+            sLogMgr->WriteLn(SQLDRIVER_LOG, "Added synchronous connection to databasepool '%s'.", m_connectionInfo.database.c_str());
+            return true;
+        }
+
+        //! Closes one synchronous connection, right away if one is idle, otherwise as soon as one is released.
+        //! The first connection, used for escaping strings, and the last one are never closed.
+        bool RemoveSynchConnection()
+        {
+            T* t = NULL;
+            {
+                ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_synchLock, false);
+                if (m_connectionCount[IDX_SYNCH] - m_retiringConnections <= 1)
+                    return false;
+
+                for (size_t i = 0; i < m_idleConnections.size(); ++i)
+                {
+                    if (m_idleConnections[i] != m_connections[IDX_SYNCH][0])
+                    {
+                        t = m_idleConnections[i];
+                        m_idleConnections.erase(m_idleConnections.begin() + i);
+                        ForgetSynchConnection(t);
+                        break;
+                    }
+                }
+
+                if (!t)
+                    ++m_retiringConnections;
+            }
+
+            if (t)
+                CloseSynchConnection(t);
+
+            return true;
+        }
+
+        uint32 GetSynchConnectionCount()
+        {
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_synchLock, 0);
+            return m_connectionCount[IDX_SYNCH] - m_retiringConnections;
+        }
+
+        void GetStatistics(DatabasePoolStatistics& statistics)
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, m_synchLock);
+            statistics = m_statistics;
+            statistics.idleConnections = m_idleConnections.size();
+            statistics.activeConnections = m_connectionCount[IDX_SYNCH] - statistics.idleConnections;
+            statistics.waitingThreads = m_waiters.size();
+        }
+
+        const std::string& GetDatabaseName() const { return m_connectionInfo.database; }
+
     private:
         unsigned long EscapeString(char *to, const char *from, unsigned long length)
         {
             if (!to || !from || !length)
                 return 0;
 
-            return mysql_real_escape_string(m_connections[IDX_SYNCH][0]->GetHandle(), to, from, length);
+            return mysql_real_escape_string(m_escapeConnection->GetHandle(), to, from, length);
         }
 
         void Enqueue(SQLOperation* op)
@@ -454,19 +584,97 @@ class DatabaseWorkerPool
             m_queue->enqueue(op);
         }
 
-        T* GetFreeConnection()
+        //! Hands out an idle synchronous connection or blocks until one is released. Waiting threads are
+        //! served first come first served. Must be matched with ReleaseConnection() or you will get deadlocks.
+        T* GetFreeConnection(uint32 caller)
+        {
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_synchLock, NULL);
+
+            T* t = NULL;
+            uint64 waited = 0;
+            if (m_waiters.empty() && !m_idleConnections.empty())
+            {
+                t = m_idleConnections.back();
+                m_idleConnections.pop_back();
+            }
+            else
+            {
+                ConnectionWaiter waiter(m_synchLock);
+                m_waiters.push_back(&waiter);
+
+                ACE_Time_Value start = ACE_OS::gettimeofday();
+                while (!waiter.connection)
+                {
+                    if (!m_waitTimeout)
+                    {
+                        waiter.condition.wait();
+                        continue;
+                    }
+
+                    ACE_Time_Value deadline = ACE_OS::gettimeofday() + ACE_Time_Value(m_waitTimeout / 1000, (m_waitTimeout % 1000) * 1000);
+                    if (waiter.condition.wait(&deadline) == -1 && !waiter.connection && errno == ETIME)
+                    {
+                        ++m_statistics.waitTimeouts;
+                        sLogMgr->WriteLn(SQLDRIVER_LOG, "[WARNING] Waiting for over %u ms for a synchronous connection to databasepool '%s', %u threads waiting.",
+                            m_waitTimeout, m_connectionInfo.database.c_str(), uint32(m_waiters.size()));
+                    }
+                }
+
+                t = waiter.connection;
+                ACE_Time_Value elapsed = ACE_OS::gettimeofday() - start;
+                waited = uint64(elapsed.sec()) * 1000000 + elapsed.usec();
+            }
+
+            size_t bucket = 0;
+            while (bucket < DATABASE_WAIT_BUCKETS - 1 && waited >= DatabaseWaitBucketBounds[bucket])
+                ++bucket;
+
+            ++m_statistics.waitHistogram[bucket];
+            ++m_statistics.queriesByCaller[caller];
+
+            t->LockIfReady();
+            return t;
+        }
+
+        void ReleaseConnection(T* t)
         {
-            uint8 i = 0;
-            size_t num_cons = m_connectionCount[IDX_SYNCH];
-            for (;;)    /// Block forever until a connection is free
+            t->Unlock();
+
+            ACE_GUARD(ACE_Thread_Mutex, guard, m_synchLock);
+            if (m_retiringConnections && t != m_connections[IDX_SYNCH][0])
+            {
+                --m_retiringConnections;
+                ForgetSynchConnection(t);
+                guard.release();
+                CloseSynchConnection(t);
+                return;
+            }
+
+            if (m_waiters.empty())
             {
-                T* t = m_connections[IDX_SYNCH][++i % num_cons ];
-                if (t->LockIfReady())   /// Must be matched with t->Unlock() or you will get deadlocks
-                    return t;
+                m_idleConnections.push_back(t);
+                return;
             }
 
-            // This will be called when Celine Dion learns to sing
-            return NULL;
+            /// Hand the connection over, so no thread arriving meanwhile can take it first
+            ConnectionWaiter* waiter = m_waiters.front();
+            m_waiters.pop_front();
+            waiter->connection = t;
+            waiter->condition.signal();
+        }
+
+        //! Must be called with m_synchLock held
+        void ForgetSynchConnection(T* t)
+        {
+            std::vector<T*>& connections = m_connections[IDX_SYNCH];
+            connections.erase(std::find(connections.begin(), connections.end(), t));
+            --m_connectionCount[IDX_SYNCH];
+        }
+
+        void CloseSynchConnection(T* t)
+        {
+            t->Close();
+            sLogMgr->WriteLn(SQLDRIVER_LOG, "Removed synchronous connection from databasepool '%s'.", m_connectionInfo.database.c_str());
         }
 
     private:
@@ -477,10 +685,26 @@ class DatabaseWorkerPool
             IDX_SIZE,
         };
 
+        struct ConnectionWaiter
+        {
+            ConnectionWaiter(ACE_Thread_Mutex& lock) : condition(lock), connection(NULL) {}
+
+            ACE_Condition_Thread_Mutex condition;
+            T* connection;                                  //! Set by the releasing thread
+        };
+
         ACE_Activation_Queue*           m_queue;             //! Queue shared by async worker threads.
         std::vector< std::vector<T*> >  m_connections;
+        T*                              m_escapeConnection;  //! m_connections[IDX_SYNCH][0], readable without m_synchLock.
         uint32                          m_connectionCount[2];       //! Counter of MySQL connections;
         MySQLConnectionInfo             m_connectionInfo;
+
+        ACE_Thread_Mutex                m_synchLock;         //! Guards the synchronous connection handout below.
+        std::vector<T*>                 m_idleConnections;
+        std::deque<ConnectionWaiter*>   m_waiters;           //! Threads waiting for a synchronous connection, oldest first.
+        uint32                          m_retiringConnections;  //! Synchronous connections to close when released.
+        uint32                          m_waitTimeout;
+        DatabasePoolStatistics          m_statistics;
 };
 
 #endif
@@ -48,7 +48,7 @@ class Field
             }
             #endif
             if (data.raw)
-                return *reinterpret_cast<uint8*>(data.value);
+                return GetRawValue<uint8>();
             return static_cast<uint8>(atol((char*)data.value));
         }
 
@@ -65,7 +65,7 @@ class Field
             }
             #endif
             if (data.raw)
-                return *reinterpret_cast<int8*>(data.value);
+                return GetRawValue<int8>();
             return static_cast<int8>(atol((char*)data.value));
         }
 
@@ -82,7 +82,7 @@ class Field
             }
             #endif
             if (data.raw)
-                return *reinterpret_cast<uint16*>(data.value);
+                return GetRawValue<uint16>();
             return static_cast<uint16>(atol((char*)data.value));
         }
 
@@ -99,7 +99,7 @@ class Field
             }
             #endif
             if (data.raw)
-                return *reinterpret_cast<int16*>(data.value);
+                return GetRawValue<int16>();
             return static_cast<int16>(atol((char*)data.value));
         }
 
@@ -116,7 +116,7 @@ class Field
             }
             #endif
             if (data.raw)
-                return *reinterpret_cast<uint32*>(data.value);
+                return GetRawValue<uint32>();
             return static_cast<uint32>(atol((char*)data.value));
         }
 
@@ -133,7 +133,7 @@ class Field
             }
             #endif
             if (data.raw)
-                return *reinterpret_cast<int32*>(data.value);
+                return GetRawValue<int32>();
             return static_cast<int32>(atol((char*)data.value));
         }
 
@@ -150,7 +150,7 @@ class Field
             }
             #endif
             if (data.raw)
-                return *reinterpret_cast<uint64*>(data.value);
+                return GetRawValue<uint64>();
             return static_cast<uint64>(atol((char*)data.value));
         }
 
@@ -167,7 +167,7 @@ class Field
             }
             #endif
             if (data.raw)
-                return *reinterpret_cast<int64*>(data.value);
+                return GetRawValue<int64>();
             return static_cast<int64>(strtol((char*)data.value, NULL, 10));
         }
 
@@ -184,7 +184,7 @@ class Field
             }
             #endif
             if (data.raw)
-                return *reinterpret_cast<float*>(data.value);
+                return GetRawValue<float>();
             return static_cast<float>(atof((char*)data.value));
         }
 
@@ -201,7 +201,7 @@ class Field
             }
             #endif
             if (data.raw)
-                return *reinterpret_cast<double*>(data.value);
+                return GetRawValue<double>();
             return static_cast<double>(atof((char*)data.value));
         }
 
@@ -232,7 +232,7 @@ class Field
                     string = "";
                 return std::string(string, data.length);
             }
-            return std::string((char*)data.value);
+            return std::string((char*)data.value, data.length);
         }
 
     protected:
@@ -246,10 +246,11 @@ class Field
         #endif
         struct
         {
-            uint32 length;          // Length (prepared strings only)
-            void* value;            // Actual data in memory
+            uint32 length;          // Length (strings only)
+            void* value;            // Actual data in memory, owned by the result set
             enum_field_types type;  // Field type
             bool raw;               // Raw bytes? (Prepared statement or ad hoc)
+            bool isUnsigned;        // Unsigned integer? (Prepared statement only)
          } data;
         #if defined(__GNUC__)
         #pragma pack()
@@ -257,13 +258,34 @@ class Field
         #pragma pack(pop)
         #endif
 
-        void SetByteValue(const void* newValue, const size_t newSize, enum_field_types newType, uint32 length);
-        void SetStructuredValue(char* newValue, enum_field_types newType);
+        void SetByteValue(void* newValue, enum_field_types newType, uint32 length, bool isUnsigned);
+        void SetStructuredValue(char* newValue, enum_field_types newType, uint32 length);
 
-        void CleanUp()
+        /// Converts a binary value from the type of its column, so any numeric
+        /// getter can be used on any numeric column without parsing
+        template<class T>
+        T GetRawValue() const
         {
-            delete[] ((char*)data.value);
-            data.value = NULL;
+            switch (data.type)
+            {
+                case MYSQL_TYPE_TINY:
+                    return data.isUnsigned ? T(*reinterpret_cast<uint8*>(data.value)) : T(*reinterpret_cast<int8*>(data.value));
+                case MYSQL_TYPE_YEAR:
+                case MYSQL_TYPE_SHORT:
+                    return data.isUnsigned ? T(*reinterpret_cast<uint16*>(data.value)) : T(*reinterpret_cast<int16*>(data.value));
+                case MYSQL_TYPE_INT24:
+                case MYSQL_TYPE_LONG:
+                    return data.isUnsigned ? T(*reinterpret_cast<uint32*>(data.value)) : T(*reinterpret_cast<int32*>(data.value));
+                case MYSQL_TYPE_LONGLONG:
+                    return data.isUnsigned ? T(*reinterpret_cast<uint64*>(data.value)) : T(*reinterpret_cast<int64*>(data.value));
+                case MYSQL_TYPE_FLOAT:
+                    return T(*reinterpret_cast<float*>(data.value));
+                case MYSQL_TYPE_DOUBLE:
+                    return T(*reinterpret_cast<double*>(data.value));
+                default:
+                    // decimals and strings are sent as text
+                    return T(atof((char*)data.value));
+            }
         }
 
         static size_t SizeForType(MYSQL_FIELD* field)
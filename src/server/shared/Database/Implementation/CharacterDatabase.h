@@ -88,6 +88,16 @@ enum CharacterDatabaseStatements
     CHAR_LOAD_PLAYER_QUESTSTATUSREW,
     CHAR_LOAD_ACCOUNT_INSTANCELOCKTIMES,
     CHAR_LOAD_PLAYER_XPRATES,
+    CHAR_LOAD_PLAYER_ITEM_REFUNDS,
+    CHAR_LOAD_PLAYER_ITEM_BOP_TRADE,
+    CHAR_LOAD_PLAYER_PET,
+    CHAR_LOAD_PLAYER_PET_AURAS,
+    CHAR_LOAD_PLAYER_PET_SPELLS,
+    CHAR_LOAD_PLAYER_PET_SPELL_COOLDOWNS,
+    CHAR_LOAD_PLAYER_PET_DECLINEDNAMES,
+    CHAR_LOAD_PET_AURAS,
+    CHAR_LOAD_PET_SPELLS,
+    CHAR_LOAD_PET_SPELL_COOLDOWNS,
     CHAR_LOAD_PLAYER_MAILITEMS,
     CHAR_LOAD_AUCTION_ITEMS,
     CHAR_ADD_AUCTION,
@@ -105,8 +115,6 @@ enum CharacterDatabaseStatements
     CHAR_GET_EXTERNAL_MAIL,
     CHAR_DEL_EXTERNAL_MAIL,
     CHAR_LOAD_GUILD_BANK_ITEMS,
-    CHAR_LOAD_ITEM_REFUNDS,
-    CHAR_LOAD_ITEM_BOP_TRADE,
     CHAR_DEL_ITEM_BOP_TRADE,
     CHAR_ADD_ITEM_BOP_TRADE,
     CHAR_REP_INVENTORY_ITEM,
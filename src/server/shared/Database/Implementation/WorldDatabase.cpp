@@ -28,6 +28,130 @@ void WorldDatabaseConnection::DoPrepareStatements()
     PREPARE_STATEMENT(WORLD_LOAD_CRETEXT, "SELECT entry, groupid, id, text, type, language, probability, emote, duration, sound FROM creature_text", CONNECTION_SYNCH)
     PREPARE_STATEMENT(WORLD_LOAD_SMART_SCRIPTS,  "SELECT entryorguid, source_type, id, link, event_type, event_phase_mask, event_chance, event_flags, event_param1, event_param2, event_param3, event_param4, action_type, action_param1, action_param2, action_param3, action_param4, action_param5, action_param6, target_type, target_param1, target_param2, target_param3, target_x, target_y, target_z, target_o FROM smart_scripts ORDER BY entryorguid, source_type, id, link", CONNECTION_SYNCH)
     PREPARE_STATEMENT(WORLD_LOAD_SMARTAI_WP,  "SELECT entry, pointid, position_x, position_y, position_z FROM waypoints ORDER BY entry, pointid", CONNECTION_SYNCH)
+    //                                              0              1   2    3        4             5           6           7           8            9              10
+    PREPARE_STATEMENT(WORLD_LOAD_CREATURES, "SELECT creature.guid, id, map, modelid, equipment_id, position_x, position_y, position_z, orientation, spawntimesecs, spawndist, "
+    //   11               12         13       14            15         16         17          18          19                20                   21
+        "currentwaypoint, curhealth, curmana, MovementType, spawnMask, phaseMask, eventEntry, pool_entry, creature.npcflag, creature.unit_flags, creature.dynamicflags "
+        "FROM creature "
+        "LEFT OUTER JOIN game_event_creature ON creature.guid = game_event_creature.guid "
+        "LEFT OUTER JOIN pool_creature ON creature.guid = pool_creature.guid", CONNECTION_SYNCH)
+    //                                                0                1   2    3           4           5           6
+    PREPARE_STATEMENT(WORLD_LOAD_GAMEOBJECTS, "SELECT gameobject.guid, id, map, position_x, position_y, position_z, orientation, "
+    //   7          8          9          10         11             12            13     14         15         16          17
+        "rotation0, rotation1, rotation2, rotation3, spawntimesecs, animprogress, state, spawnMask, phaseMask, eventEntry, pool_entry "
+        "FROM gameobject LEFT OUTER JOIN game_event_gameobject ON gameobject.guid = game_event_gameobject.guid "
+        "LEFT OUTER JOIN pool_gameobject ON gameobject.guid = pool_gameobject.guid", CONNECTION_SYNCH)
+    //                                                    0      1       2           3                 4         5         6           7     8              9
+    PREPARE_STATEMENT(WORLD_LOAD_QUEST_TEMPLATES, "SELECT entry, Method, ZoneOrSort, SkillOrClassMask, MinLevel, MaxLevel, QuestLevel, Type, RequiredRaces, RequiredSkillValue, "
+    //   10                   11                 12                    13                  14                     15                   16                     17                   18                19
+        "RepObjectiveFaction, RepObjectiveValue, RepObjectiveFaction2, RepObjectiveValue2, RequiredMinRepFaction, RequiredMinRepValue, RequiredMaxRepFaction, RequiredMaxRepValue, SuggestedPlayers, LimitTime, "
+    //   20          21            22           23            24            25                 26           27           28              29                30       31         32            33
+        "QuestFlags, SpecialFlags, CharTitleId, PlayersSlain, BonusTalents, RewardArenaPoints, PrevQuestId, NextQuestId, ExclusiveGroup, NextQuestInChain, RewXPId, SrcItemId, SrcItemCount, SrcSpell, "
+    //   34     35       36          37               38                39       40              41              42              43              44
+        "Title, Details, Objectives, OfferRewardText, RequestItemsText, EndText, CompletedText,  ObjectiveText1, ObjectiveText2, ObjectiveText3, ObjectiveText4, "
+    //   45          46          47          48          49          50          51             52             53             54             55             56
+        "ReqItemId1, ReqItemId2, ReqItemId3, ReqItemId4, ReqItemId5, ReqItemId6, ReqItemCount1, ReqItemCount2, ReqItemCount3, ReqItemCount4, ReqItemCount5, ReqItemCount6, "
+    //   57            58            59            60            61               62               63               64
+        "ReqSourceId1, ReqSourceId2, ReqSourceId3, ReqSourceId4, ReqSourceCount1, ReqSourceCount2, ReqSourceCount3, ReqSourceCount4, "
+    //   65                  66                  67                  68                  69                     70                     71                     72
+        "ReqCreatureOrGOId1, ReqCreatureOrGOId2, ReqCreatureOrGOId3, ReqCreatureOrGOId4, ReqCreatureOrGOCount1, ReqCreatureOrGOCount2, ReqCreatureOrGOCount3, ReqCreatureOrGOCount4, "
+    //   73             74             75             76
+        "ReqSpellCast1, ReqSpellCast2, ReqSpellCast3, ReqSpellCast4, "
+    //   77                78                79                80                81                82
+        "RewChoiceItemId1, RewChoiceItemId2, RewChoiceItemId3, RewChoiceItemId4, RewChoiceItemId5, RewChoiceItemId6, "
+    //   83                   84                   85                   86                   87                   88
+        "RewChoiceItemCount1, RewChoiceItemCount2, RewChoiceItemCount3, RewChoiceItemCount4, RewChoiceItemCount5, RewChoiceItemCount6, "
+    //   89          90          91          92          93             94             95             96
+        "RewItemId1, RewItemId2, RewItemId3, RewItemId4, RewItemCount1, RewItemCount2, RewItemCount3, RewItemCount4, "
+    //   97              98              99              100             101             102             103             104             105             106
+        "RewRepFaction1, RewRepFaction2, RewRepFaction3, RewRepFaction4, RewRepFaction5, RewRepValueId1, RewRepValueId2, RewRepValueId3, RewRepValueId4, RewRepValueId5, "
+    //   107           108           109           110           111
+        "RewRepValue1, RewRepValue2, RewRepValue3, RewRepValue4, RewRepValue5, "
+    //   112               113                 114            115               116       117           118                119               120         121     122     123
+        "RewHonorAddition, RewHonorMultiplier, RewOrReqMoney, RewMoneyMaxLevel, RewSpell, RewSpellCast, RewMailTemplateId, RewMailDelaySecs, PointMapId, PointX, PointY, PointOpt, "
+    //   124            125            126            127            128                 129                 130                 131
+        "DetailsEmote1, DetailsEmote2, DetailsEmote3, DetailsEmote4, DetailsEmoteDelay1, DetailsEmoteDelay2, DetailsEmoteDelay3, DetailsEmoteDelay4, "
+    //   132              133            134                135                136                137
+        "IncompleteEmote, CompleteEmote, OfferRewardEmote1, OfferRewardEmote2, OfferRewardEmote3, OfferRewardEmote4, "
+    //   138                     139                     140                     141
+        "OfferRewardEmoteDelay1, OfferRewardEmoteDelay2, OfferRewardEmoteDelay3, OfferRewardEmoteDelay4, "
+    //   142          143
+        "StartScript, CompleteScript"
+        " FROM quest_template", CONNECTION_SYNCH)
+    //                                                         0              1                 2                  3                 4            5           6        7         8
+    PREPARE_STATEMENT(WORLD_LOAD_CREATURE_TEMPLATES, "SELECT entry, difficulty_entry_1, difficulty_entry_2, difficulty_entry_3, KillCredit1, KillCredit2, modelid1, modelid2, modelid3, "
+    //      9       10      11       12           13           14        15     16      17          18       19         20         21
+        "modelid4, name, subname, IconName, gossip_menu_id, minlevel, maxlevel, exp, faction_A, faction_H, npcflag, speed_walk, speed_run, "
+    //    22     23     24     25        26          27             28              29                30           31          32
+        "scale, rank, mindmg, maxdmg, dmgschool, attackpower, dmg_multiplier, baseattacktime, rangeattacktime, unit_class, unit_flags, "
+    //        33         34         35             36             37             38          39           40              41           42
+        "dynamicflags, family, trainer_type, trainer_spell, trainer_class, trainer_race, minrangedmg, maxrangedmg, rangedattackpower, type, "
+    //       43        44          45           46          47          48           49           50           51           52         53
+        "type_flags, lootid, pickpocketloot, skinloot, resistance1, resistance2, resistance3, resistance4, resistance5, resistance6, spell1, "
+    //     54      55      56      57      58      59      60          61            62       63       64       65         66
+        "spell2, spell3, spell4, spell5, spell6, spell7, spell8, PetSpellDataId, VehicleId, mingold, maxgold, AIName, MovementType, "
+    //        67          68         69         70          71           72          73          74          75          76          77
+        "InhabitType, Health_mod, Mana_mod, Armor_mod, RacialLeader, questItem1, questItem2, questItem3, questItem4, questItem5, questItem6, "
+    //       78           79           80               81                82           83
+        "movementId, RegenHealth, equipment_id, mechanic_immune_mask, flags_extra, ScriptName "
+        "FROM creature_template", CONNECTION_SYNCH)
+    //                                                              0       1       2      3       4       5      6
+    PREPARE_STATEMENT(WORLD_LOAD_CREATURE_TEMPLATE_ADDONS, "SELECT entry, path_id, mount, bytes1, bytes2, emote, auras FROM creature_template_addon", CONNECTION_SYNCH)
+    //                                                     0       1       2      3       4       5      6
+    PREPARE_STATEMENT(WORLD_LOAD_CREATURE_ADDONS, "SELECT guid, path_id, mount, bytes1, bytes2, emote, auras FROM creature_addon", CONNECTION_SYNCH)
+    //                                                     0      1       2       3     4        5        6       7          8         9        10        11           12
+    PREPARE_STATEMENT(WORLD_LOAD_ITEM_TEMPLATES, "SELECT entry, class, subclass, unk0, name, displayid, Quality, Flags, FlagsExtra, BuyCount, BuyPrice, SellPrice, InventoryType, "
+    //         13              14           15          16             17               18                19              20
+        "AllowableClass, AllowableRace, ItemLevel, RequiredLevel, RequiredSkill, RequiredSkillRank, requiredspell, requiredhonorrank, "
+    //         21                      22                       23               24        25          26             27           28
+        "RequiredCityRank, RequiredReputationFaction, RequiredReputationRank, maxcount, stackable, ContainerSlots, StatsCount, stat_type1, "
+    //       29           30          31           32          33           34          35           36          37           38
+        "stat_value1, stat_type2, stat_value2, stat_type3, stat_value3, stat_type4, stat_value4, stat_type5, stat_value5, stat_type6, "
+    //       39           40          41           42           43          44           45           46           47
+        "stat_value6, stat_type7, stat_value7, stat_type8, stat_value8, stat_type9, stat_value9, stat_type10, stat_value10, "
+    //              48                    49           50        51        52         53        54         55      56      57        58
+        "ScalingStatDistribution, ScalingStatValue, dmg_min1, dmg_max1, dmg_type1, dmg_min2, dmg_max2, dmg_type2, armor, holy_res, fire_res, "
+    //       59          60         61          62       63       64            65            66          67               68
+        "nature_res, frost_res, shadow_res, arcane_res, delay, ammo_type, RangedModRange, spellid_1, spelltrigger_1, spellcharges_1, "
+    //         69              70                71                 72                 73           74               75
+        "spellppmRate_1, spellcooldown_1, spellcategory_1, spellcategorycooldown_1, spellid_2, spelltrigger_2, spellcharges_2, "
+    //         76               77              78                  79                 80           81               82
+        "spellppmRate_2, spellcooldown_2, spellcategory_2, spellcategorycooldown_2, spellid_3, spelltrigger_3, spellcharges_3, "
+    //         83               84              85                  86                 87           88               89
+        "spellppmRate_3, spellcooldown_3, spellcategory_3, spellcategorycooldown_3, spellid_4, spelltrigger_4, spellcharges_4, "
+    //         90               91              92                  93                  94          95               96
+        "spellppmRate_4, spellcooldown_4, spellcategory_4, spellcategorycooldown_4, spellid_5, spelltrigger_5, spellcharges_5, "
+    //         97               98              99                  100                 101        102         103       104          105
+        "spellppmRate_5, spellcooldown_5, spellcategory_5, spellcategorycooldown_5, bonding, description, PageText, LanguageID, PageMaterial, "
+    //       106       107     108      109          110            111       112     113         114       115   116     117
+        "startquest, lockid, Material, sheath, RandomProperty, RandomSuffix, block, itemset, MaxDurability, area, Map, BagFamily, "
+    //       118             119             120             121             122            123              124            125
+        "TotemCategory, socketColor_1, socketContent_1, socketColor_2, socketContent_2, socketColor_3, socketContent_3, socketBonus, "
+    //       126                 127                     128            129            130            131         132         133
+        "GemProperties, RequiredDisenchantSkill, ArmorDamageModifier, Duration, ItemLimitCategory, HolidayId, ScriptName, DisenchantID, "
+    //      134        135            136
+        "FoodType, minMoneyLoot, maxMoneyLoot FROM item_template", CONNECTION_SYNCH)
+    //                                                           0      1      2        3       4             5          6      7       8     9        10         11          12
+    PREPARE_STATEMENT(WORLD_LOAD_GAMEOBJECT_TEMPLATES, "SELECT entry, type, displayId, name, IconName, castBarCaption, unk1, faction, flags, size, questItem1, questItem2, questItem3, "
+    //       13          14          15       16     17     18     19     20     21     22     23     24     25      26      27      28
+        "questItem4, questItem5, questItem6, data0, data1, data2, data3, data4, data5, data6, data7, data8, data9, data10, data11, data12, "
+    //     29      30      31      32      33      34      35      36      37      38      39      40        41
+        "data13, data14, data15, data16, data17, data18, data19, data20, data21, data22, data23, AIName, ScriptName "
+        "FROM gameobject_template", CONNECTION_SYNCH)
+    PREPARE_STATEMENT(WORLD_LOAD_VENDORS, "SELECT entry, item, maxcount, incrtime, ExtendedCost FROM npc_vendor ORDER BY entry, slot ASC", CONNECTION_SYNCH)
+    //                                                            0      1     2                    3         4        5              6
+    PREPARE_STATEMENT(WORLD_LOAD_CREATURE_LOOT_TEMPLATES, "SELECT entry, item, ChanceOrQuestChance, lootmode, groupid, mincountOrRef, maxcount FROM creature_loot_template", CONNECTION_SYNCH)
+    PREPARE_STATEMENT(WORLD_LOAD_DISENCHANT_LOOT_TEMPLATES, "SELECT entry, item, ChanceOrQuestChance, lootmode, groupid, mincountOrRef, maxcount FROM disenchant_loot_template", CONNECTION_SYNCH)
+    PREPARE_STATEMENT(WORLD_LOAD_FISHING_LOOT_TEMPLATES, "SELECT entry, item, ChanceOrQuestChance, lootmode, groupid, mincountOrRef, maxcount FROM fishing_loot_template", CONNECTION_SYNCH)
+    PREPARE_STATEMENT(WORLD_LOAD_GAMEOBJECT_LOOT_TEMPLATES, "SELECT entry, item, ChanceOrQuestChance, lootmode, groupid, mincountOrRef, maxcount FROM gameobject_loot_template", CONNECTION_SYNCH)
+    PREPARE_STATEMENT(WORLD_LOAD_ITEM_LOOT_TEMPLATES, "SELECT entry, item, ChanceOrQuestChance, lootmode, groupid, mincountOrRef, maxcount FROM item_loot_template", CONNECTION_SYNCH)
+    PREPARE_STATEMENT(WORLD_LOAD_MAIL_LOOT_TEMPLATES, "SELECT entry, item, ChanceOrQuestChance, lootmode, groupid, mincountOrRef, maxcount FROM mail_loot_template", CONNECTION_SYNCH)
+    PREPARE_STATEMENT(WORLD_LOAD_MILLING_LOOT_TEMPLATES, "SELECT entry, item, ChanceOrQuestChance, lootmode, groupid, mincountOrRef, maxcount FROM milling_loot_template", CONNECTION_SYNCH)
+    PREPARE_STATEMENT(WORLD_LOAD_PICKPOCKETING_LOOT_TEMPLATES, "SELECT entry, item, ChanceOrQuestChance, lootmode, groupid, mincountOrRef, maxcount FROM pickpocketing_loot_template", CONNECTION_SYNCH)
+    PREPARE_STATEMENT(WORLD_LOAD_PROSPECTING_LOOT_TEMPLATES, "SELECT entry, item, ChanceOrQuestChance, lootmode, groupid, mincountOrRef, maxcount FROM prospecting_loot_template", CONNECTION_SYNCH)
+    PREPARE_STATEMENT(WORLD_LOAD_REFERENCE_LOOT_TEMPLATES, "SELECT entry, item, ChanceOrQuestChance, lootmode, groupid, mincountOrRef, maxcount FROM reference_loot_template", CONNECTION_SYNCH)
+    PREPARE_STATEMENT(WORLD_LOAD_SKINNING_LOOT_TEMPLATES, "SELECT entry, item, ChanceOrQuestChance, lootmode, groupid, mincountOrRef, maxcount FROM skinning_loot_template", CONNECTION_SYNCH)
+    PREPARE_STATEMENT(WORLD_LOAD_SPELL_LOOT_TEMPLATES, "SELECT entry, item, ChanceOrQuestChance, lootmode, groupid, mincountOrRef, maxcount FROM spell_loot_template", CONNECTION_SYNCH)
 
     PREPARE_STATEMENT(WORLD_LOAD_NPCGUARD_TEMPLATES, "SELECT `entry`,`type`,`value`,`distance`,`teleId`,`comment` FROM `npc_areaguard_template`", CONNECTION_SYNCH);
     PREPARE_STATEMENT(WORLD_ADD_NPCGUARD_TEMPLATE, "REPLACE INTO `npc_areaguard_template`(`entry`,`type`,`value`,`distance`,`teleId`,`comment`) VALUES (?, ?, ?, ?, ?, ?)", CONNECTION_ASYNC);
@@ -48,6 +48,27 @@ enum WorldDatabaseStatements
     WORLD_LOAD_CRETEXT,
     WORLD_LOAD_SMART_SCRIPTS,
     WORLD_LOAD_SMARTAI_WP,
+    WORLD_LOAD_CREATURES,
+    WORLD_LOAD_GAMEOBJECTS,
+    WORLD_LOAD_QUEST_TEMPLATES,
+    WORLD_LOAD_CREATURE_TEMPLATES,
+    WORLD_LOAD_CREATURE_TEMPLATE_ADDONS,
+    WORLD_LOAD_CREATURE_ADDONS,
+    WORLD_LOAD_ITEM_TEMPLATES,
+    WORLD_LOAD_GAMEOBJECT_TEMPLATES,
+    WORLD_LOAD_VENDORS,
+    WORLD_LOAD_CREATURE_LOOT_TEMPLATES,
+    WORLD_LOAD_DISENCHANT_LOOT_TEMPLATES,
+    WORLD_LOAD_FISHING_LOOT_TEMPLATES,
+    WORLD_LOAD_GAMEOBJECT_LOOT_TEMPLATES,
+    WORLD_LOAD_ITEM_LOOT_TEMPLATES,
+    WORLD_LOAD_MAIL_LOOT_TEMPLATES,
+    WORLD_LOAD_MILLING_LOOT_TEMPLATES,
+    WORLD_LOAD_PICKPOCKETING_LOOT_TEMPLATES,
+    WORLD_LOAD_PROSPECTING_LOOT_TEMPLATES,
+    WORLD_LOAD_REFERENCE_LOOT_TEMPLATES,
+    WORLD_LOAD_SKINNING_LOOT_TEMPLATES,
+    WORLD_LOAD_SPELL_LOOT_TEMPLATES,
 
     WORLD_LOAD_NPCGUARD_TEMPLATES,
     WORLD_ADD_NPCGUARD_TEMPLATE,
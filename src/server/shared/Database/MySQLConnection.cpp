@@ -32,9 +32,12 @@
 #include "Timer.h"
 #include "Log.h"
 
+#include <ace/Atomic_Op.h>
+
 MySQLConnection::MySQLConnection(MySQLConnectionInfo& connInfo) :
 m_reconnecting(false),
 m_prepareError(false),
+m_multiStatements(true),
 m_queue(NULL),
 m_worker(NULL),
 m_Mysql(NULL),
@@ -46,6 +49,7 @@ m_connectionFlags(CONNECTION_SYNCH)
 MySQLConnection::MySQLConnection(ACE_Activation_Queue* queue, MySQLConnectionInfo& connInfo) :
 m_reconnecting(false),
 m_prepareError(false),
+m_multiStatements(true),
 m_queue(queue),
 m_Mysql(NULL),
 m_connectionInfo(connInfo),
@@ -383,48 +387,429 @@ bool MySQLConnection::ExecuteTransaction(SQLTransaction& transaction)
     if (queries.empty())
         return false;
 
+    std::vector<SQLElementData> elements(queries.begin(), queries.end());
+    std::vector<BatchUnit> units;
+    BuildBatchUnits(elements, units);
+
     BeginTransaction();
 
-    std::list<SQLElementData>::const_iterator itr;
-    for (itr = queries.begin(); itr != queries.end(); ++itr)
+    if (!ExecuteBatchUnits(elements, units, true))
     {
-        SQLElementData const& data = *itr;
-        switch (itr->type)
+        sLogMgr->WriteLn(SQLDRIVER_LOG, "[WARNING] Transaction aborted. %u queries not executed.", (uint32)queries.size());
+        RollbackTransaction();
+        return false;
+    }
+
+    // we might encounter errors during certain queries, and depending on the kind of error
+    // we might want to restart the transaction. So to prevent data loss, we only clean up when it's all done.
+    // This is done in calling functions DatabaseWorkerPool<T>::DirectCommitTransaction and TransactionTask::Execute,
+    // and not while iterating over every element.
+
+    CommitTransaction();
+    return true;
+}
+
+static ACE_Atomic_Op<ACE_Thread_Mutex, uint64> s_batches;           // multiple statement round trips
+static ACE_Atomic_Op<ACE_Thread_Mutex, uint64> s_batchedStatements; // statements sent in them
+static ACE_Atomic_Op<ACE_Thread_Mutex, uint64> s_coalescedRows;     // rows sent in multiple row inserts
+static ACE_Atomic_Op<ACE_Thread_Mutex, uint64> s_batchFallbacks;    // multiple row inserts retried row by row
+
+void MySQLConnection::ExecuteBatch(std::vector<SQLElementData> const& elements)
+{
+    std::vector<BatchUnit> units;
+    BuildBatchUnits(elements, units);
+    ExecuteBatchUnits(elements, units, false);
+}
+
+void MySQLConnection::GetBatchStatistics(uint64& batches, uint64& batchedStatements, uint64& coalescedRows, uint64& fallbacks)
+{
+    batches = s_batches.value();
+    batchedStatements = s_batchedStatements.value();
+    coalescedRows = s_coalescedRows.value();
+    fallbacks = s_batchFallbacks.value();
+}
+
+void MySQLConnection::BuildBatchUnits(std::vector<SQLElementData> const& elements, std::vector<BatchUnit>& units)
+{
+    units.reserve(elements.size());
+    for (size_t i = 0; i < elements.size(); ++i)
+    {
+        SQLElementData const& data = elements[i];
+        BatchUnit unit;
+        unit.first = i;
+        unit.count = 1;
+
+        if (data.type == SQL_ELEMENT_RAW)
+        {
+            unit.kind = BatchUnit::UNIT_RAW;
+            units.push_back(unit);
+            continue;
+        }
+
+        PreparedStatement* stmt = data.element.stmt;
+        if (!RenderStatement(stmt, unit.sql))
+        {
+            unit.kind = BatchUnit::UNIT_PREPARED;
+            units.push_back(unit);
+            continue;
+        }
+
+        unit.kind = BatchUnit::UNIT_TEXT;
+
+        /// Add the row to the insert of the previous element if it is the same statement
+        size_t tuple = GetRowTupleOffset(stmt->m_index);
+        if (tuple != std::string::npos && !units.empty())
         {
-            case SQL_ELEMENT_PREPARED:
+            BatchUnit& last = units.back();
+            SQLElementData const& lastData = elements[last.first];
+            if (last.kind == BatchUnit::UNIT_TEXT && lastData.element.stmt->m_index == stmt->m_index &&
+                last.sql.size() + unit.sql.size() - tuple < MAX_BATCH_SIZE)
             {
-                PreparedStatement* stmt = data.element.stmt;
-                ASSERT(stmt);
-                if (!Execute(stmt))
-                {
-                    sLogMgr->WriteLn(SQLDRIVER_LOG, "[WARNING] Transaction aborted. %u queries not executed.", (uint32)queries.size());
-                    RollbackTransaction();
-                    return false;
-                }
+                last.sql += ',';
+                last.sql.append(unit.sql, tuple, std::string::npos);
+                ++last.count;
+                ++s_coalescedRows;
+                continue;
             }
+        }
+
+        units.push_back(unit);
+    }
+}
+
+bool MySQLConnection::ExecuteBatchUnits(std::vector<SQLElementData> const& elements, std::vector<BatchUnit> const& units, bool inTransaction)
+{
+    size_t u = 0;
+    while (u < units.size())
+    {
+        size_t end = u;
+        size_t size = 0;
+        while (end < units.size() && units[end].kind == BatchUnit::UNIT_TEXT && (end == u || size + units[end].sql.size() < MAX_BATCH_SIZE))
+            size += units[end++].sql.size() + 1;
+
+        /// Too few statements in a row to save anything by sending them together
+        if (!m_multiStatements || end - u < MIN_MULTI_STATEMENTS)
+        {
+            end = std::max(end, u + 1);
+            for (; u < end; ++u)
+                if (!ExecuteBatchUnit(elements, units[u], inTransaction) && inTransaction)
+                    return false;
+
+            continue;
+        }
+
+        std::string sql;
+        sql.reserve(size);
+        for (size_t i = u; i < end; ++i)
+        {
+            if (i != u)
+                sql += ';';
+            sql += units[i].sql;
+        }
+
+        size_t executed = 0;
+        uint32 lErrno = 0;
+        if (_ExecuteMultiStatement(sql, end - u, executed, lErrno))
+        {
+            u = end;
+            continue;
+        }
+
+        /// Not sent at all, the server refused multiple statements
+        if (!m_multiStatements)
+            continue;
+
+        u += executed;
+
+        if (inTransaction)
+            return false;
+
+        /// Stopped without an error, whatever was not confirmed is sent one statement at a time
+        if (!lErrno)
+        {
+            sLogMgr->WriteLn(SQLDRIVER_LOG, "[WARNING] Multiple statements stopped without an error after %u of %u, executing the other %u one by one.",
+                uint32(executed), uint32(end - u + executed), uint32(end - u));
+            for (; u < end; ++u)
+                ExecuteBatchUnit(elements, units[u], false);
+
+            continue;
+        }
+
+        if (_HandleMySQLErrno(lErrno))
+            continue;       // Reconnected, send again from the failed statement
+
+        /// The other rows of a failed insert are still to be inserted
+        BatchUnit const& failed = units[u++];
+        if (failed.count > 1)
+        {
+            ++s_batchFallbacks;
+            for (size_t i = failed.first; i < failed.first + failed.count; ++i)
+                Execute(elements[i].element.stmt);
+        }
+    }
+
+    return true;
+}
+
+bool MySQLConnection::ExecuteBatchUnit(std::vector<SQLElementData> const& elements, BatchUnit const& unit, bool inTransaction)
+{
+    SQLElementData const& data = elements[unit.first];
+    switch (unit.kind)
+    {
+        case BatchUnit::UNIT_RAW:
+            return Execute(data.element.query);
+        case BatchUnit::UNIT_PREPARED:
+            return Execute(data.element.stmt);
+        case BatchUnit::UNIT_TEXT:
             break;
-            case SQL_ELEMENT_RAW:
+    }
+
+    if (unit.count == 1)
+        return Execute(data.element.stmt);
+
+    if (Execute(unit.sql.c_str()))
+        return true;
+
+    /// Within a transaction a failed row failed it all the same
+    if (inTransaction)
+        return false;
+
+    ++s_batchFallbacks;
+    bool ok = true;
+    for (size_t i = unit.first; i < unit.first + unit.count; ++i)
+        ok &= Execute(elements[i].element.stmt);
+
+    return ok;
+}
+
+bool MySQLConnection::_ExecuteMultiStatement(std::string const& sql, size_t statements, size_t& executed, uint32& lErrno)
+{
+    executed = 0;
+    lErrno = 0;
+    if (!m_Mysql)
+        return false;
+
+    uint32 _s = 0;
+    if (sLogMgr->IsLogEnabled(SQLDRIVER_LOG))
+        _s = getMSTime();
+
+    /// Only for statements written here, ad hoc ones are never sent this way
+    if (mysql_set_server_option(m_Mysql, MYSQL_OPTION_MULTI_STATEMENTS_ON))
+    {
+        sLogMgr->WriteLn(SQLDRIVER_LOG, "ERROR: [%u] %s (enabling multiple statements, batching disabled for this connection)", mysql_errno(m_Mysql), mysql_error(m_Mysql));
+        m_multiStatements = false;
+        return false;
+    }
+
+    ++s_batches;
+    s_batchedStatements += statements;
+
+    int status = mysql_real_query(m_Mysql, sql.c_str(), (unsigned long)sql.size());
+    while (!status)
+    {
+        if (MYSQL_RES* result = mysql_store_result(m_Mysql))
+            mysql_free_result(result);
+
+        ++executed;
+        status = mysql_next_result(m_Mysql);    // 0 - next statement executed, -1 - no more statements, >0 - next statement failed
+    }
+
+    /// The server stops at the first failed statement
+    if (status > 0 || executed < statements)
+    {
+        lErrno = mysql_errno(m_Mysql);
+        sLogMgr->WriteLn(SQLDRIVER_LOG, "SQL: %s", sql.c_str());
+        sLogMgr->WriteLn(SQLDRIVER_LOG, "ERROR: [%u] %s (statement %u of %u)", lErrno, mysql_error(m_Mysql), uint32(executed + 1), uint32(statements));
+    }
+    else if (sLogMgr->IsLogEnabled(SQLDRIVER_LOG))
+        sLogMgr->WriteLn(SQLDRIVER_LOG, "[%u ms] SQL: %s", getMSTimeDiff(_s, getMSTime()), sql.c_str());
+
+    mysql_set_server_option(m_Mysql, MYSQL_OPTION_MULTI_STATEMENTS_OFF);
+    return !lErrno && executed >= statements;
+}
+
+bool MySQLConnection::RenderStatement(PreparedStatement* stmt, std::string& sql)
+{
+    PreparedStatementMap::const_iterator query = m_queries.find(stmt->m_index);
+    if (query == m_queries.end())
+        return false;
+
+    std::vector<PreparedStatementData> const& params = stmt->statement_data;
+    size_t param = 0;
+    char quote = 0;
+    char buf[32];
+
+    for (const char* c = query->second.first; *c; ++c)
+    {
+        if (quote)
+        {
+            if (*c == '\\' && *(c + 1))
+                sql += *c++;
+            else if (*c == quote)
+                quote = 0;
+
+            sql += *c;
+            continue;
+        }
+
+        if (*c == '\'' || *c == '"' || *c == '`')
+            quote = *c;
+
+        if (*c != '?')
+        {
+            sql += *c;
+            continue;
+        }
+
+        if (param >= params.size())
+            return false;
+
+        PreparedStatementData const& value = params[param++];
+        switch (value.type)
+        {
+            case TYPE_BOOL:
+                sql += value.data.boolean ? '1' : '0';
+                break;
+            case TYPE_UI8:
+            case TYPE_UI16:
+            case TYPE_UI32:
+                snprintf(buf, sizeof(buf), "%u", value.data.ui32);
+                sql += buf;
+                break;
+            case TYPE_I8:
+            case TYPE_I16:
+            case TYPE_I32:
+                snprintf(buf, sizeof(buf), "%d", value.data.i32);
+                sql += buf;
+                break;
+            case TYPE_UI64:
+                snprintf(buf, sizeof(buf), UI64FMTD, value.data.ui64);
+                sql += buf;
+                break;
+            case TYPE_I64:
+                snprintf(buf, sizeof(buf), SI64FMTD, value.data.i64);
+                sql += buf;
+                break;
+            case TYPE_FLOAT:
+            case TYPE_DOUBLE:
             {
-                const char* sql = data.element.query;
-                ASSERT(sql);
-                if (!Execute(sql))
-                {
-                    sLogMgr->WriteLn(SQLDRIVER_LOG, "[WARNING] Transaction aborted. %u queries not executed.", (uint32)queries.size());
-                    RollbackTransaction();
-                    return false;
-                }
+                // printed exactly, the column converts it as it would the bound value
+                double d = value.type == TYPE_FLOAT ? double(value.data.f) : value.data.d;
+                if (d != d || d - d != 0.0)
+                    return false;   // NaN and infinities have no SQL literal
+
+                snprintf(buf, sizeof(buf), "%.17g", d);
+                sql += buf;
+                break;
+            }
+            case TYPE_STRING:
+            {
+                // bound as a C string
+                size_t length = strlen(value.str.c_str());
+                std::vector<char> escaped(length * 2 + 1);
+                mysql_real_escape_string(m_Mysql, &escaped[0], value.str.c_str(), (unsigned long)length);
+                sql += '\'';
+                sql += &escaped[0];
+                sql += '\'';
+                break;
             }
-            break;
         }
     }
 
-    // we might encounter errors during certain queries, and depending on the kind of error
-    // we might want to restart the transaction. So to prevent data loss, we only clean up when it's all done.
-    // This is done in calling functions DatabaseWorkerPool<T>::DirectCommitTransaction and TransactionTask::Execute,
-    // and not while iterating over every element.
+    // statements are joined with ';'
+    sql.erase(sql.find_last_not_of(" \t\r\n;") + 1);
+    return param == params.size();
+}
 
-    CommitTransaction();
-    return true;
+size_t MySQLConnection::GetRowTupleOffset(uint32 index)
+{
+    std::map<uint32, size_t>::const_iterator itr = m_rowTupleOffsets.find(index);
+    if (itr != m_rowTupleOffsets.end())
+        return itr->second;
+
+    size_t& offset = m_rowTupleOffsets[index];
+    offset = std::string::npos;
+
+    PreparedStatementMap::const_iterator query = m_queries.find(index);
+    if (query == m_queries.end())
+        return offset;
+
+    /// Only INSERT/REPLACE ... VALUES (...) with a single tuple that ends the statement
+    /// and no parameters before it; the tuple starts at the same place once written
+    std::string sql = query->second.first;
+    std::string upper = sql;
+    std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+
+    size_t begin = upper.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos || (upper.compare(begin, 6, "INSERT") && upper.compare(begin, 7, "REPLACE")))
+        return offset;
+
+    size_t values = upper.find("VALUES");
+    if (values == std::string::npos || upper.find("VALUES", values + 1) != std::string::npos ||
+        sql.find('?') < values || upper.find("SELECT") != std::string::npos)
+        return offset;
+
+    size_t tuple = sql.find('(', values);
+    size_t last = sql.find_last_not_of(" \t\r\n");
+    if (tuple == std::string::npos || last == std::string::npos || sql[last] != ')')
+        return offset;
+
+    /// The tuple must close at the end of the statement, ON DUPLICATE KEY UPDATE and such can't follow
+    int depth = 0;
+    for (size_t i = tuple; i <= last; ++i)
+    {
+        if (sql[i] == '(')
+            ++depth;
+        else if (sql[i] == ')' && --depth == 0 && i != last)
+            return offset;
+    }
+
+    /// A failed multiple row insert is replayed row by row, which is only safe
+    /// when the failure wrote nothing, i.e. the table is transactional
+    if (!IsTransactionalTable(sql, upper))
+        return offset;
+
+    offset = tuple;
+    return offset;
+}
+
+bool MySQLConnection::IsTransactionalTable(std::string const& sql, std::string const& upper)
+{
+    size_t into = upper.find(" INTO ");
+    if (into == std::string::npos)
+        return false;
+
+    size_t nameBegin = upper.find_first_not_of(" \t\r\n`", into + 6);
+    if (nameBegin == std::string::npos)
+        return false;
+
+    size_t nameEnd = nameBegin;
+    while (nameEnd < upper.size() && (isalnum(upper[nameEnd]) || upper[nameEnd] == '_' || upper[nameEnd] == '.'))
+        ++nameEnd;
+
+    std::string table = sql.substr(nameBegin, nameEnd - nameBegin);
+    size_t dot = table.rfind('.');
+    if (dot != std::string::npos)
+        table.erase(0, dot + 1);
+
+    if (table.empty())
+        return false;
+
+    std::string query = "SELECT ENGINE FROM information_schema.TABLES WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME = '" + table + "'";
+    ResultSet* result = Query(query.c_str());
+    if (!result)
+        return false;
+
+    bool transactional = false;
+    if (result->NextRow())
+    {
+        std::string engine = (*result)[0].GetString();
+        std::transform(engine.begin(), engine.end(), engine.begin(), ::toupper);
+        transactional = engine == "INNODB";
+    }
+
+    delete result;
+    return transactional;
 }
 
 MySQLPreparedStatement* MySQLConnection::GetPreparedStatement(uint32 index)
@@ -72,6 +72,10 @@ typedef std::map<uint32 /*index*/, std::pair<const char* /*query*/, ConnectionFl
 
 #define PREPARE_STATEMENT(a, b, c) m_queries[a] = std::make_pair(strdup(b), c);
 
+#define MAX_BATCH_OPERATIONS    256             //! Queued one-way statements an asynchronous worker takes at once
+#define MAX_BATCH_SIZE          (512 * 1024)    //! Bytes of SQL sent at once, half the default max_allowed_packet
+#define MIN_MULTI_STATEMENTS    4               //! Turning multiple statements on and off takes two round trips
+
 class MySQLConnection
 {
     template <class T> friend class DatabaseWorkerPool;
@@ -98,6 +102,10 @@ class MySQLConnection
         void CommitTransaction();
         bool ExecuteTransaction(SQLTransaction& transaction);
 
+        //! Executes one-way statements in order, in as few round trips as possible
+        void ExecuteBatch(std::vector<SQLElementData> const& elements);
+        static void GetBatchStatistics(uint64& batches, uint64& batchedStatements, uint64& coalescedRows, uint64& fallbacks);
+
         operator bool () const { return m_Mysql != NULL; }
         void Ping() { mysql_ping(m_Mysql); }
 
@@ -129,10 +137,37 @@ class MySQLConnection
         PreparedStatementMap                 m_queries;       //! Query storage
         bool                                 m_reconnecting;  //! Are we reconnecting?
         bool                                 m_prepareError;  //! Was there any error while preparing statements?
+        bool                                 m_multiStatements; //! Can batches be sent as multiple statements?
 
     private:
         bool _HandleMySQLErrno(uint32 errNo);
 
+        //! One round trip's worth of a batch
+        struct BatchUnit
+        {
+            enum Kind
+            {
+                UNIT_RAW,           //! Ad hoc statement, never sent with others
+                UNIT_PREPARED,      //! Prepared statement that can't be written as SQL
+                UNIT_TEXT,          //! Prepared statement written as SQL, rows of consecutive inserts merged
+            };
+
+            Kind kind;
+            std::string sql;
+            size_t first;           //! First element of the unit
+            size_t count;           //! Number of elements, rows when more than one
+        };
+
+        void BuildBatchUnits(std::vector<SQLElementData> const& elements, std::vector<BatchUnit>& units);
+        bool ExecuteBatchUnits(std::vector<SQLElementData> const& elements, std::vector<BatchUnit> const& units, bool inTransaction);
+        bool ExecuteBatchUnit(std::vector<SQLElementData> const& elements, BatchUnit const& unit, bool inTransaction);
+        bool _ExecuteMultiStatement(std::string const& sql, size_t statements, size_t& executed, uint32& lErrno);
+        bool RenderStatement(PreparedStatement* stmt, std::string& sql);
+        size_t GetRowTupleOffset(uint32 index);
+        bool IsTransactionalTable(std::string const& sql, std::string const& upper);
+
+        std::map<uint32, size_t>  m_rowTupleOffsets;       //! Where the VALUES tuple of single row inserts starts
+
     private:
         ACE_Activation_Queue* m_queue;                      //! Queue shared with other asynchronous connections.
         DatabaseWorker*       m_worker;                     //! Core worker task.
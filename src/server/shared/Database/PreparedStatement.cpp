@@ -414,3 +414,13 @@ bool PreparedStatementTask::Execute()
 
     return m_conn->Execute(m_stmt);
 }
+
+bool PreparedStatementTask::GetBatchElement(SQLElementData& element) const
+{
+    if (m_has_result)
+        return false;
+
+    element.type = SQL_ELEMENT_PREPARED;
+    element.element.stmt = m_stmt;
+    return true;
+}
@@ -88,6 +88,8 @@ class PreparedStatement
         void setDouble(const uint8 index, const double value);
         void setString(const uint8 index, const std::string& value);
 
+        uint32 GetIndex() const { return m_index; }
+
     protected:
         void BindParameters();
 
@@ -151,6 +153,7 @@ class PreparedStatementTask : public SQLOperation
         ~PreparedStatementTask();
 
         bool Execute();
+        bool GetBatchElement(SQLElementData& element) const;
 
     protected:
         PreparedStatement* m_stmt;
@@ -88,9 +88,14 @@ QueryResult SQLQueryHolder::GetResult(size_t index)
     // Don't call to this function if the index is of an ad-hoc statement
     if (index < m_queries.size())
     {
+        // the returned pointer owns the result from now on
         ResultSet* result = m_queries[index].second.qresult;
+        m_queries[index].second.qresult = NULL;
         if (!result || !result->GetRowCount())
+        {
+            delete result;
             return QueryResult(NULL);
+        }
 
         result->NextRow();
         return QueryResult(result);
@@ -104,9 +109,14 @@ PreparedQueryResult SQLQueryHolder::GetPreparedResult(size_t index)
     // Don't call to this function if the index is of a prepared statement
     if (index < m_queries.size())
     {
+        // the returned pointer owns the result from now on
         PreparedResultSet* result = m_queries[index].second.presult;
+        m_queries[index].second.presult = NULL;
         if (!result || !result->GetRowCount())
+        {
+            delete result;
             return PreparedQueryResult(NULL);
+        }
 
         return PreparedQueryResult(result);
     }
@@ -133,16 +143,18 @@ SQLQueryHolder::~SQLQueryHolder()
     for (size_t i = 0; i < m_queries.size(); i++)
     {
         /// if the result was never used, free the resources
-        /// results used already (getresult called) are expected to be deleted
+        /// results used already (getresult called) are owned by their caller
         if (SQLElementData* data = &m_queries[i].first)
         {
             switch (data->type)
             {
                 case SQL_ELEMENT_RAW:
                     free((void*)(const_cast<char*>(data->element.query)));
+                    delete m_queries[i].second.qresult;
                     break;
                 case SQL_ELEMENT_PREPARED:
                     delete data->element.stmt;
+                    delete m_queries[i].second.presult;
                     break;
             }
         }
@@ -19,6 +19,32 @@
 #include "DatabaseEnv.h"
 #include "Log.h"
 
+#define NULL_VALUE_OFFSET size_t(-1)
+
+static bool IsVariableLength(enum_field_types type)
+{
+    switch (type)
+    {
+        case MYSQL_TYPE_TINY_BLOB:
+        case MYSQL_TYPE_MEDIUM_BLOB:
+        case MYSQL_TYPE_LONG_BLOB:
+        case MYSQL_TYPE_BLOB:
+        case MYSQL_TYPE_STRING:
+        case MYSQL_TYPE_VAR_STRING:
+        case MYSQL_TYPE_DECIMAL:
+        case MYSQL_TYPE_NEWDECIMAL:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// fixed size values are read through typed pointers
+static size_t AlignedSize(size_t size)
+{
+    return (size + 7) & ~size_t(7);
+}
+
 ResultSet::ResultSet(MYSQL_RES *result, MYSQL_FIELD *fields, uint64 rowCount, uint32 fieldCount) :
 m_rowCount(rowCount),
 m_fieldCount(fieldCount),
@@ -32,6 +58,7 @@ m_fields(fields)
 PreparedResultSet::PreparedResultSet(MYSQL_STMT* stmt, MYSQL_RES *result, uint64 rowCount, uint32 fieldCount) :
 m_rowCount(rowCount),
 m_rowPosition(0),
+m_rows(NULL),
 m_fieldCount(fieldCount),
 m_rBind(NULL),
 m_stmt(stmt),
@@ -60,6 +87,7 @@ m_length(NULL)
     if (mysql_stmt_store_result(m_stmt))
     {
         sLogMgr->WriteLn(SQLDRIVER_LOG, "%s:mysql_stmt_store_result, cannot bind result from MySQL server. Error: %s", __FUNCTION__, mysql_stmt_error(m_stmt));
+        m_rowCount = 0;
         return;
     }
 
@@ -90,45 +118,63 @@ m_length(NULL)
         delete[] m_rBind;
         delete[] m_isNull;
         delete[] m_length;
+        m_rowCount = 0;
         return;
     }
 
     m_rowCount = mysql_stmt_num_rows(m_stmt);
 
-    m_rows.resize(uint32(m_rowCount));
+    //- Every row is copied into one contiguous buffer as it is fetched, fixed size
+    //- values aligned and strings with their actual length, null terminated.
+    //- The buffer grows meanwhile, so only the offsets are kept until it is complete
+    size_t fixedRowSize = 0;
+    for (uint32 fIndex = 0; fIndex < m_fieldCount; ++fIndex)
+        if (!IsVariableLength(m_rBind[fIndex].buffer_type))
+            fixedRowSize += AlignedSize(m_rBind[fIndex].buffer_length);
+
+    m_rowData.reserve(size_t(m_rowCount) * fixedRowSize);
+    m_rows = new Field[uint32(m_rowCount) * m_fieldCount];
+    std::vector<size_t> offsets(uint32(m_rowCount) * m_fieldCount);
+
     while (_NextRow())
     {
-        m_rows[uint32(m_rowPosition)] = new Field[m_fieldCount];
-        for (uint64 fIndex = 0; fIndex < m_fieldCount; ++fIndex)
+        Field* row = &m_rows[uint32(m_rowPosition) * m_fieldCount];
+        size_t* rowOffsets = &offsets[uint32(m_rowPosition) * m_fieldCount];
+        for (uint32 fIndex = 0; fIndex < m_fieldCount; ++fIndex)
         {
-            if (!*m_rBind[fIndex].is_null)
-                m_rows[uint32(m_rowPosition)][fIndex].SetByteValue( m_rBind[fIndex].buffer,
-                                                            m_rBind[fIndex].buffer_length,
-                                                            m_rBind[fIndex].buffer_type,
-                                                           *m_rBind[fIndex].length );
+            MYSQL_BIND const& bind = m_rBind[fIndex];
+            uint32 length = 0;
+
+            if (m_isNull[fIndex])
+                rowOffsets[fIndex] = NULL_VALUE_OFFSET;
+            else if (IsVariableLength(bind.buffer_type))
+            {
+                // the length of a truncated value is the length it should have had
+                length = uint32(std::min<unsigned long>(m_length[fIndex], bind.buffer_length - 1));
+                rowOffsets[fIndex] = m_rowData.size();
+                m_rowData.insert(m_rowData.end(), (char*)bind.buffer, (char*)bind.buffer + length);
+                m_rowData.push_back('\0');
+            }
             else
-                switch (m_rBind[fIndex].buffer_type)
-                {
-                    case MYSQL_TYPE_TINY_BLOB:
-                    case MYSQL_TYPE_MEDIUM_BLOB:
-                    case MYSQL_TYPE_LONG_BLOB:
-                    case MYSQL_TYPE_BLOB:
-                    case MYSQL_TYPE_STRING:
-                    case MYSQL_TYPE_VAR_STRING:
-                    m_rows[uint32(m_rowPosition)][fIndex].SetByteValue( "",
-                                                            m_rBind[fIndex].buffer_length,
-                                                            m_rBind[fIndex].buffer_type,
-                                                           *m_rBind[fIndex].length );
-                    break;
-                    default:
-                    m_rows[uint32(m_rowPosition)][fIndex].SetByteValue( 0,
-                                                            m_rBind[fIndex].buffer_length,
-                                                            m_rBind[fIndex].buffer_type,
-                                                           *m_rBind[fIndex].length );
-                }
+            {
+                m_rowData.resize(AlignedSize(m_rowData.size()));
+                rowOffsets[fIndex] = m_rowData.size();
+                m_rowData.insert(m_rowData.end(), (char*)bind.buffer, (char*)bind.buffer + bind.buffer_length);
+            }
+
+            row[fIndex].SetByteValue(NULL, bind.buffer_type, length, bind.is_unsigned);
         }
         m_rowPosition++;
     }
+
+    for (size_t index = 0; index < offsets.size(); ++index)
+    {
+        if (offsets[index] != NULL_VALUE_OFFSET)
+            m_rows[index].data.value = &m_rowData[offsets[index]];
+        else if (IsVariableLength(m_rows[index].data.type))
+            m_rows[index].data.value = const_cast<char*>("");
+    }
+
     m_rowPosition = 0;
 
     /// All data is buffered, let go of mysql c api structures
@@ -142,8 +188,7 @@ ResultSet::~ResultSet()
 
 PreparedResultSet::~PreparedResultSet()
 {
-    for (uint32 i = 0; i < uint32(m_rowCount); ++i)
-        delete[] m_rows[i];
+    delete[] m_rows;
 }
 
 bool ResultSet::NextRow()
@@ -160,8 +205,10 @@ bool ResultSet::NextRow()
         return false;
     }
 
+    // the fields point into the row, valid until the next one is fetched
+    unsigned long* lengths = mysql_fetch_lengths(m_result);
     for (uint32 i = 0; i < m_fieldCount; i++)
-        m_currentRow[i].SetStructuredValue(row[i], m_fields[i].type);
+        m_currentRow[i].SetStructuredValue(row[i], m_fields[i].type, uint32(lengths[i]));
 
     return true;
 }
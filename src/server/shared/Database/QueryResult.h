@@ -73,20 +73,21 @@ class PreparedResultSet
         Field* Fetch() const
         {
             ASSERT(m_rowPosition < m_rowCount);
-            return m_rows[uint32(m_rowPosition)];
+            return &m_rows[uint32(m_rowPosition) * m_fieldCount];
         }
 
         const Field & operator [] (uint32 index) const
         {
             ASSERT(m_rowPosition < m_rowCount);
             ASSERT(index < m_fieldCount);
-            return m_rows[uint32(m_rowPosition)][index];
+            return m_rows[uint32(m_rowPosition) * m_fieldCount + index];
         }
 
     protected:
         uint64 m_rowCount;
         uint64 m_rowPosition;
-        std::vector<Field*> m_rows;
+        Field* m_rows;                  // m_rowCount rows of m_fieldCount fields
+        std::vector<char> m_rowData;    // values of all rows, the fields point into it
         uint32 m_fieldCount;
 
     private:
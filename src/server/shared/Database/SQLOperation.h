@@ -68,6 +68,9 @@ class SQLOperation : public ACE_Method_Request
         virtual bool Execute() = 0;
         virtual void SetConnection(MySQLConnection* con) { m_conn = con; }
 
+        //! One-way statements can be sent together with the ones queued behind them, see DatabaseWorker
+        virtual bool GetBatchElement(SQLElementData& /*element*/) const { return false; }
+
         MySQLConnection* m_conn;
 };
 
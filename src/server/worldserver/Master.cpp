@@ -441,6 +441,11 @@ bool Master::_StartDB()
         return false;
     }
 
+    uint32 synchWaitTimeout = sConfig->GetIntDefault("Database.SynchWaitTimeout", 5000);
+    WorldDatabase.SetConnectionWaitTimeout(synchWaitTimeout);
+    CharacterDatabase.SetConnectionWaitTimeout(synchWaitTimeout);
+    LoginDatabase.SetConnectionWaitTimeout(synchWaitTimeout);
+
     ///- Get the realm Id from the configuration file
     realmID = sConfig->GetIntDefault("RealmID", 0);
     if (!realmID)